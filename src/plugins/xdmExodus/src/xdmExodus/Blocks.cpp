@@ -30,6 +30,9 @@
 
 #include <xdm/VectorStructuredArray.hpp>
 
+#include <algorithm>
+#include <stdexcept>
+
 
 
 namespace xdmExodus {
@@ -72,7 +75,7 @@ void Block::readAttributes( int exodusFileId, std::size_t attributesPerEntry ) {
         exodusObjectType(),
         id(),
         attributeIndex + 1,
-        attribute->data() ),
+        attribute->typedData() ),
       "Could not read attribute values." );
 
     xdm::RefPtr< xdm::UniformDataItem > dataItem = makeDataItem(
@@ -156,7 +159,11 @@ void Block::readFromFile(
       &attributesPerEntry ),
     "Could not read block params." );
 
-  std::vector< int > nodeConnections( numberOfEntries * nodesPerEntry );
+  // The node connectivity is read directly into the array that the topology will own and then
+  // widened in place, so there is no intermediate int copy of the largest array in the block.
+  const std::size_t numberOfNodeConnections = numberOfEntries * nodesPerEntry;
+  xdm::RefPtr< xdm::VectorStructuredArray< std::size_t > > nodeConnectivity(
+    new xdm::VectorStructuredArray< std::size_t >( numberOfNodeConnections ) );
   std::vector< int > edgeConnections( numberOfEntries * edgesPerEntry );
   std::vector< int > faceConnections( numberOfEntries * facesPerEntry );
   EXODUS_CALL(
@@ -164,16 +171,14 @@ void Block::readFromFile(
       exodusFileId,
       exodusObjectType(),
       id(),
-      &nodeConnections[0],
-      &edgeConnections[0],
-      &faceConnections[0] ),
+      reinterpret_cast< int* >( nodeConnectivity->typedData() ),
+      edgeConnections.empty() ? 0 : &edgeConnections[0],
+      faceConnections.empty() ? 0 : &faceConnections[0] ),
     "Could not read connectivity." );
+  expandToZeroBase( nodeConnectivity->typedData(), numberOfNodeConnections );
 
   // TODO: do something with edge/face lists for element blocks.
 
-  xdm::RefPtr< xdm::VectorStructuredArray< std::size_t > > nodeConnectivity(
-    new xdm::VectorStructuredArray< std::size_t >( nodeConnections.size() ) );
-  convertToZeroBase( nodeConnections, nodeConnectivity->begin() );
   xdm::RefPtr< xdm::UniformDataItem > dataItem = makeDataItem(
     nodeConnectivity, xdm::primitiveType::kLongUnsignedInt, numberOfEntries, nodesPerEntry );
   xdm::RefPtr< xdmGrid::UnstructuredTopology > topo(
@@ -194,8 +199,9 @@ void Block::readFromFile(
     setupVariables( beginTruthTable, numberOfVariables, variableNames );
 
     // Fill the variables with the data from the first time step. If data from another step
-    // is needed, the user can call update().
-    readTimeStep( exodusFileId, 0 );
+    // is needed, the user can call update(). Variables are only set up when the file has
+    // time steps, so the first one is known to exist.
+    readTimeStep( exodusFileId, 0, 1 );
   }
 }
 
@@ -216,15 +222,7 @@ void Block::writeToFile( int exodusFileId, int* variableTruthTable ) {
       (int)attribs.size() ),
     "Unable to write block parameters." );
 
-  std::vector< int > connections;
-  for ( std::size_t entry = 0; entry < numberOfEntries(); ++entry ) {
-    xdmGrid::ConstElementConnectivity entryNodes = topology()->elementConnections( entry );
-    for ( std::size_t node = 0; node < entryNodes.size(); ++node ) {
-      connections.push_back( (int)entryNodes[ node ] + 1 );
-    }
-  }
-  EXODUS_CALL( ex_put_conn( exodusFileId, exodusObjectType(), id(), &connections[0], 0, 0 ),
-    "Unable to write block connectivity." );
+  writeConnectivity( exodusFileId, exodusObjectType(), id(), *topology() );
   EXODUS_CALL( ex_put_name( exodusFileId, exodusObjectType(), id(), name().c_str() ),
     "Unable to write block name." );
 
@@ -238,6 +236,29 @@ void Block::writeToFile( int exodusFileId, int* variableTruthTable ) {
   }
 }
 
+void Block::readVariableTimeSeries(
+  int exodusFileId,
+  int variableIndex,
+  std::size_t entry,
+  std::size_t firstStep,
+  std::size_t lastStep,
+  double* out ) const {
+
+  if ( exodusObjectType() != EX_ELEM_BLOCK ) {
+    throw std::runtime_error( "Time series can only be read for element block variables." );
+  }
+  // Exodus numbers elements globally across the blocks, starting from 1.
+  EXODUS_CALL(
+    ex_get_elem_var_time(
+      exodusFileId,
+      variableIndex,
+      (int)( entryGlobalOffset() + entry + 1 ),
+      (int)( firstStep + 1 ),
+      (int)( lastStep + 1 ),
+      out ),
+    "Could not read variable time series." );
+}
+
 xdm::RefPtr< Block > blockFactory( int exodusObjectType ) {
   xdm::RefPtr< Block > block;
   switch ( exodusObjectType ) {
@@ -64,6 +64,22 @@ public:
 
   virtual void writeToFile( int exodusFileId, int* variableTruthTable );
 
+  /// Read the values of one variable at one entry over a range of time steps.
+  /// @param variableIndex The one-based Exodus variable index, see Variable::id().
+  /// @param entry The zero-based entry in this block.
+  /// @param firstStep The zero-based first time step.
+  /// @param lastStep The zero-based last time step, inclusive.
+  /// @param out Array with room for lastStep - firstStep + 1 values.
+  /// @throws std::runtime_error if this is not an element block; Exodus only provides time
+  ///         series reads for element variables.
+  void readVariableTimeSeries(
+    int exodusFileId,
+    int variableIndex,
+    std::size_t entry,
+    std::size_t firstStep,
+    std::size_t lastStep,
+    double* out ) const;
+
 protected:
   virtual void readAttributes( int exodusFileId, std::size_t attributesPerEntry );
   virtual void writeAttributes( int exodusFileId );
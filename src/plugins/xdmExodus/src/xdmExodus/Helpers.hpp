@@ -18,28 +18,35 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 //------------------------------------------------------------------------------
+#ifndef xdmExodus_Helpers_hpp
+#define xdmExodus_Helpers_hpp
 
 #include <xdmGrid/UnstructuredTopology.hpp>
 #include <xdmGrid/ElementTopology.hpp>
 
+#include <xdmFormat/IoExcept.hpp>
+
 #include <xdm/ArrayAdapter.hpp>
 #include <xdm/RefPtr.hpp>
+#include <xdm/ThrowMacro.hpp>
 
 #include <exodusII.h>
 
 #include <algorithm>
 #include <cstring>
 #include <functional>
+#include <limits>
 #include <map>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
 /// Const types and some functions that are useful when working with ExodusII files.
 
 #define EXODUS_CALL( functionCall, errorString ) \
-  if ( (#functionCall) < 0 ) { \
-    throw std::runtime_error( (#errorString) ); \
+  if ( ( functionCall ) < 0 ) { \
+    throw std::runtime_error( errorString ); \
   }
 
 namespace xdmExodus {
@@ -64,20 +71,42 @@ struct ExodusString {
 };
 
 /// Get a char** that points to the individual strings in a std::vector< ExodusString >.
-void vectorToCharStarArray( std::vector< ExodusString >& input, char* output[] ) {
+inline void vectorToCharStarArray( std::vector< ExodusString >& input, char* output[] ) {
   std::transform( input.begin(), input.end(), output,
     std::mem_fun_ref( &ExodusString::ptr ) );
 }
 
-/// Do two conversions: int -> size_t and also move the base to zero. Exodus numbering starts at
-/// 1, so this subtracts 1 from all values to give zero-based indexing.
-template< typename OutputIterator >
-void convertToZeroBase( const std::vector< int >& vecWithExodusOrdering, OutputIterator oBegin ) {
-  std::transform( vecWithExodusOrdering.begin(), vecWithExodusOrdering.end(), oBegin,
-    std::bind2nd( std::minus< std::size_t >(), 1 ) );
+/// Convert Exodus ints to zero-based size_t in place. The first numberOfValues ints packed at
+/// the front of the array are widened and shifted to zero base from the back to the front,
+/// so that each int is read before its storage is overwritten. This lets Exodus read
+/// straight into the final connectivity array without a temporary int buffer.
+inline void expandToZeroBase( std::size_t* values, std::size_t numberOfValues ) {
+  const char* packed = reinterpret_cast< const char* >( values );
+  for ( std::size_t i = numberOfValues; i > 0; --i ) {
+    int exodusValue;
+    std::memcpy( &exodusValue, packed + ( i - 1 ) * sizeof( int ), sizeof( int ) );
+    values[ i - 1 ] = (std::size_t)exodusValue - 1;
+  }
+}
+
+/// Convert zero-based size_t values to Exodus one-based ints.
+/// @throw xdmFormat::WriteError if a value does not fit in an Exodus int.
+inline void narrowToOneBase(
+  const std::size_t* values,
+  std::size_t numberOfValues,
+  int* exodusValues ) {
+  const std::size_t largest = std::numeric_limits< int >::max() - 1;
+  for ( std::size_t i = 0; i < numberOfValues; ++i ) {
+    if ( values[ i ] > largest ) {
+      std::ostringstream message;
+      message << "Index " << values[ i ] << " is too large to write to an Exodus file.";
+      XDM_THROW( xdmFormat::WriteError( message.str() ) );
+    }
+    exodusValues[ i ] = (int)( values[ i ] + 1 );
+  }
 }
 
-/// This is the inverse of convertToZeroBase.
+/// Convert zero-based size_t values to Exodus one-based ints.
 template< typename OutputIterator >
 void convertToOneBase( const std::vector< std::size_t >& vecWithBaseZeroOrdering, OutputIterator oBegin ) {
   std::transform( vecWithBaseZeroOrdering.begin(), vecWithBaseZeroOrdering.end(), oBegin,
@@ -86,12 +115,12 @@ void convertToOneBase( const std::vector< std::size_t >& vecWithBaseZeroOrdering
 
 const std::size_t kNumberOfObjectTypes = 12;
 
-bool objectIsBlock( std::size_t i ) { return i >= 0 && i < 3; }
-bool objectIsSet( std::size_t i ) { return i > 2 && i < 8; }
-bool objectIsMap( std::size_t i ) { return i >= 8 && i < kNumberOfObjectTypes; }
+inline bool objectIsBlock( std::size_t i ) { return i >= 0 && i < 3; }
+inline bool objectIsSet( std::size_t i ) { return i > 2 && i < 8; }
+inline bool objectIsMap( std::size_t i ) { return i >= 8 && i < kNumberOfObjectTypes; }
 
 /// These are the flags that Exodus uses to signify edge blocks, node sets, etc.
-const int kObjectTypes[ kNumberOfObjectTypes ] = {
+const ex_entity_type kObjectTypes[ kNumberOfObjectTypes ] = {
   EX_EDGE_BLOCK,
   EX_FACE_BLOCK,
   EX_ELEM_BLOCK,
@@ -125,7 +154,7 @@ const int kInquireObjectSizes[ kNumberOfObjectTypes ] = {
   EX_INQ_ELEM_MAP
 };
 
-const char* kObjectTypeChar[ kNumberOfObjectTypes ] = {
+const char* const kObjectTypeChar[ kNumberOfObjectTypes ] = {
   "L",
   "F",
   "E",
@@ -140,9 +169,70 @@ const char* kObjectTypeChar[ kNumberOfObjectTypes ] = {
   0,
 };
 
+/// Write the node connectivity of a block. The connectivity is copied out of the topology a
+/// chunk of elements at a time through the bulk topology access, so that the size_t scratch
+/// space stays small, and narrowed into the one-based ints that Exodus stores.
+inline void writeConnectivity(
+  int exodusFileId,
+  ex_entity_type exodusObjectType,
+  int blockId,
+  const xdmGrid::Topology& topology ) {
+
+  const std::size_t numberOfElements = topology.numberOfElements();
+  if ( numberOfElements == 0 ) {
+    return;
+  }
+  const std::size_t nodesPerElement = topology.elementTopology( 0 )->numberOfNodes();
+  const std::size_t elementsPerChunk = 4096;
+  std::vector< int > connections( numberOfElements * nodesPerElement );
+  std::vector< std::size_t > chunk(
+    std::min( numberOfElements, elementsPerChunk ) * nodesPerElement );
+  for ( std::size_t element = 0; element < numberOfElements; element += elementsPerChunk ) {
+    std::size_t count = std::min( elementsPerChunk, numberOfElements - element );
+    topology.copyConnectivity( element, count, &chunk[0] );
+    narrowToOneBase( &chunk[0], count * nodesPerElement, &connections[ element * nodesPerElement ] );
+  }
+  EXODUS_CALL( ex_put_conn( exodusFileId, exodusObjectType, blockId, &connections[0], 0, 0 ),
+    "Unable to write block connectivity." );
+}
+
+/// Get the NetCDF ids of the variables of every object of one type in a single call. The
+/// table has numberOfVariables entries per object, and a zero means that the variable is not
+/// defined for that object.
+inline std::vector< int > readVariableIds(
+  int exodusFileId,
+  ex_entity_type exodusObjectType,
+  std::size_t numberOfObjects,
+  std::size_t numberOfVariables ) {
+
+  std::vector< int > variableIds( numberOfObjects * numberOfVariables, 0 );
+  if ( ! variableIds.empty() ) {
+    EXODUS_CALL(
+      ex_get_varid( exodusFileId, exodusObjectType, &variableIds[0] ),
+      "Could not read variable ids." );
+  }
+  return variableIds;
+}
+
+/// Read the values of one variable at several consecutive time steps, one time step after
+/// another. ex_get_varid_var reads a single time step, so this goes to NetCDF directly.
+/// @return The NetCDF status, which is negative on failure.
+inline int readVariableTimeSteps(
+  int exodusFileId,
+  int netcdfVariableId,
+  std::size_t firstStep,
+  std::size_t numberOfSteps,
+  std::size_t numberOfEntries,
+  double* values ) {
+
+  std::size_t start[2] = { firstStep, 0 };
+  std::size_t count[2] = { numberOfSteps, numberOfEntries };
+  return nc_get_vara_double( exodusFileId, netcdfVariableId, start, count, values );
+}
+
 // Helpers that create a UniformDataItem from a StructuredArray. This is done frequently.
 // First version takes one dimension.
-xdm::RefPtr< xdm::UniformDataItem > makeDataItem(
+inline xdm::RefPtr< xdm::UniformDataItem > makeDataItem(
   xdm::RefPtr< xdm::StructuredArray > vector,
   xdm::primitiveType::Value primType,
   std::size_t firstExtent ) {
@@ -150,10 +240,11 @@ xdm::RefPtr< xdm::UniformDataItem > makeDataItem(
   xdm::RefPtr< xdm::UniformDataItem > dataItem(
     new xdm::UniformDataItem( primType, xdm::makeShape( firstExtent ) ) );
   dataItem->setData( xdm::makeRefPtr( new xdm::ArrayAdapter( vector ) ) );
+  return dataItem;
 }
 
 // Second version takes two dimensions.
-xdm::RefPtr< xdm::UniformDataItem > makeDataItem(
+inline xdm::RefPtr< xdm::UniformDataItem > makeDataItem(
   xdm::RefPtr< xdm::StructuredArray > vector,
   xdm::primitiveType::Value primType,
   std::size_t firstExtent,
@@ -162,7 +253,10 @@ xdm::RefPtr< xdm::UniformDataItem > makeDataItem(
   xdm::RefPtr< xdm::UniformDataItem > dataItem(
     new xdm::UniformDataItem( primType, xdm::makeShape( firstExtent, secondExtent ) ) );
   dataItem->setData( xdm::makeRefPtr( new xdm::ArrayAdapter( vector ) ) );
+  return dataItem;
 }
 
 } // namespace xdmExodus
 
+#endif // xdmExodus_Helpers_hpp
+
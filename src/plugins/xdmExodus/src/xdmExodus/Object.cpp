@@ -24,15 +24,31 @@
 #include <xdmExodus/Variable.hpp>
 
 #include <xdm/RefPtr.hpp>
+#include <xdm/VectorStructuredArray.hpp>
+
+#include <algorithm>
+#include <functional>
 
 namespace xdmExodus {
 
 class Variable;
 
+Object::Object() :
+  mVariables(),
+  mVariableValues(),
+  mVariableIds(),
+  mStagedVariableIndices(),
+  mTimeStepWindow(),
+  mWindowFirstStep( 0 ),
+  mWindowSteps( 0 ),
+  mTimeStepsPerRead( 1 ),
+  mId( 0 ) {
+}
+
 int Object::id() const { return mId; }
 void Object::setId( int id ) { mId = id; }
 
-int Object::exodusObjectType() const { return kObjectTypes[ exodusObjectTypeIndex() ]; }
+ex_entity_type Object::exodusObjectType() const { return kObjectTypes[ exodusObjectTypeIndex() ]; }
 
 int Object::exodusInquireFlag() const { return kInquireObjectSizes[ exodusObjectTypeIndex() ]; }
 
@@ -51,32 +67,144 @@ void Object::setupVariables(
   const std::size_t numberOfVariables,
   const std::vector< ExodusString >& variableNames ) {
 
+  std::size_t activeVariables =
+    std::count_if( beginTruthTable, beginTruthTable + numberOfVariables,
+      std::bind2nd( std::not_equal_to< int >(), 0 ) );
+  if ( activeVariables == 0 ) {
+    return;
+  }
+
+  // Allocate the values of every active variable at once.
+  const std::size_t entries = numberOfEntries();
+  mVariableValues = xdm::makeRefPtr(
+    new xdm::VectorStructuredArray< double >( activeVariables * entries ) );
+
+  std::size_t stagingOffset = 0;
   for ( std::size_t variableIndex = 0; variableIndex < numberOfVariables; ++variableIndex ) {
     if ( *beginTruthTable++ == 0 ) {
       continue;
     }
 
+    // Exodus variable indices are one-based.
     xdm::RefPtr< Variable > variable( new Variable(
       exodusObjectType(),
-      variableIndex,
+      variableIndex + 1,
       id(),
-      numberOfEntries() ) );
+      entries,
+      mVariableValues,
+      stagingOffset ) );
     variable->setName( variableNames[ variableIndex ].string() );
     addVariable( variable ); // virtual
+    mStagedVariableIndices.push_back( variableIndex + 1 );
+    stagingOffset += entries;
   }
 }
 
-void Object::readTimeStep( int exodusFileId, std::size_t timeStep ) {
+void Object::setVariableIds(
+  std::vector< int >::const_iterator beginVariableIds,
+  const std::size_t numberOfVariables ) {
+  mVariableIds.assign( beginVariableIds, beginVariableIds + numberOfVariables );
+}
+
+xdm::RefPtr< const xdm::VectorStructuredArray< double > > Object::variableValues() const {
+  return mVariableValues;
+}
+
+int Object::variableId( const Variable& variable ) const {
+  std::size_t index = variable.id() - 1;
+  return index < mVariableIds.size() ? mVariableIds[ index ] : 0;
+}
+
+void Object::setTimeStepsPerRead( std::size_t steps ) {
+  mTimeStepsPerRead = std::max( steps, std::size_t( 1 ) );
+}
+
+std::size_t Object::timeStepsPerRead() const {
+  return mTimeStepsPerRead;
+}
+
+void Object::readTimeStep(
+  int exodusFileId,
+  std::size_t timeStep,
+  std::size_t numberOfTimeSteps ) {
+  if ( readStagedTimeStep( exodusFileId, timeStep, numberOfTimeSteps ) ) {
+    return;
+  }
+
   typedef std::vector< xdm::RefPtr< Variable > >::iterator VariableIterator;
   for ( VariableIterator var = mVariables.begin(); var != mVariables.end(); ++var ) {
     (*var)->readTimeStep( exodusFileId, timeStep );
   }
 }
 
+bool Object::readStagedTimeStep(
+  int exodusFileId,
+  std::size_t timeStep,
+  std::size_t numberOfTimeSteps ) {
+  // Only the Variables created by setupVariables() live in the staging buffer.
+  if ( ! mVariableValues.valid() || mStagedVariableIndices.size() != mVariables.size() ) {
+    return false;
+  }
+
+  const std::size_t entries = numberOfEntries();
+  const std::size_t numberOfStagedVariables = mStagedVariableIndices.size();
+  if ( timeStep < mWindowFirstStep || timeStep >= mWindowFirstStep + mWindowSteps ) {
+    std::vector< int > netcdfIds( numberOfStagedVariables );
+    for ( std::size_t i = 0; i < numberOfStagedVariables; ++i ) {
+      std::size_t index = mStagedVariableIndices[ i ] - 1;
+      netcdfIds[ i ] = index < mVariableIds.size() ? mVariableIds[ index ] : 0;
+      if ( netcdfIds[ i ] <= 0 ) {
+        return false;
+      }
+    }
+
+    if ( timeStep >= numberOfTimeSteps ) {
+      return false;
+    }
+
+    // Each Exodus variable is its own NetCDF variable, so there is one read per variable, but
+    // each read can cover the next few time steps as well as this one.
+    const std::size_t steps = std::min( mTimeStepsPerRead, numberOfTimeSteps - timeStep );
+    mWindowSteps = 0;
+    mTimeStepWindow.resize( numberOfStagedVariables * steps * entries );
+    for ( std::size_t i = 0; i < numberOfStagedVariables; ++i ) {
+      EXODUS_CALL(
+        readVariableTimeSteps(
+          exodusFileId,
+          netcdfIds[ i ],
+          timeStep,
+          steps,
+          entries,
+          &mTimeStepWindow[ i * steps * entries ] ),
+        "Could not read variable values." );
+    }
+    mWindowFirstStep = timeStep;
+    mWindowSteps = steps;
+  }
+
+  // Copy the time step of every Variable into the staging buffer.
+  const std::size_t stepOffset = ( timeStep - mWindowFirstStep ) * entries;
+  double* staging = mVariableValues->typedData();
+  for ( std::size_t i = 0; i < numberOfStagedVariables; ++i ) {
+    std::vector< double >::const_iterator values =
+      mTimeStepWindow.begin() + i * mWindowSteps * entries + stepOffset;
+    std::copy( values, values + entries, staging + i * entries );
+  }
+  return true;
+}
+
 void Object::writeTimeStep( int exodusFileId, std::size_t timeStep ) {
+  // The values read ahead may be out of date now.
+  mWindowSteps = 0;
+
   typedef std::vector< xdm::RefPtr< Variable > >::iterator VariableIterator;
   for ( VariableIterator var = mVariables.begin(); var != mVariables.end(); ++var ) {
-    (*var)->writeTimeStep( exodusFileId, timeStep );
+    int netcdfId = variableId( **var );
+    if ( netcdfId > 0 ) {
+      (*var)->writeTimeStep( exodusFileId, timeStep, netcdfId );
+    } else {
+      (*var)->writeTimeStep( exodusFileId, timeStep );
+    }
   }
 }
 
@@ -21,8 +21,11 @@
 #ifndef xdmExodus_Object_hpp
 #define xdmExodus_Object_hpp
 
+#include <xdm/Forward.hpp>
 #include <xdm/RefPtr.hpp>
 
+#include <exodusII.h>
+
 #include <vector>
 
 
@@ -37,10 +40,12 @@ class Variable;
 /// be assigned to objects.
 class Object {
 public:
+  Object();
+
   int id() const;
   void setId( int id );
 
-  int exodusObjectType() const;
+  ex_entity_type exodusObjectType() const;
 
   int exodusInquireFlag() const;
 
@@ -56,17 +61,45 @@ public:
 
   std::vector< xdm::RefPtr< Variable > > variables();
 
+  /// Create the Variables that are active in the truth table. The values of all of the
+  /// Variables are held in one staging buffer, one Variable after another.
   void setupVariables(
     std::vector< int >::const_iterator beginTruthTable,
     const std::size_t numberOfVariables,
     const std::vector< ExodusString >& variableNames );
 
+  /// Record the NetCDF ids of the variables of this Object, as returned for one Object by
+  /// ex_get_varid. With the ids known, time step reads and writes go straight to the
+  /// variable data instead of looking the variable up by name on every call.
+  /// @param beginVariableIds The ids of the variables, indexed by variable index - 1. A zero
+  ///        means the variable is not defined for this Object.
+  void setVariableIds(
+    std::vector< int >::const_iterator beginVariableIds,
+    const std::size_t numberOfVariables );
+
+  /// Get the staging buffer holding the values of all of the Variables created by
+  /// setupVariables(), or null if there are none.
+  xdm::RefPtr< const xdm::VectorStructuredArray< double > > variableValues() const;
+
   virtual void writeToFile( int exodusFileId, int* variableTruthTable ) {}
 
-  /// Read the data for the variables at a specific time step.
+  /// Set the number of time steps read for each Variable at once. Reading more than one step
+  /// trades memory, the step count times the size of the staging buffer, for fewer reads
+  /// when stepping forward through time. The default is 1.
+  void setTimeStepsPerRead( std::size_t steps );
+  std::size_t timeStepsPerRead() const;
+
+  /// Read the data for the variables at a specific time step. When the NetCDF ids of the
+  /// staged Variables are known, each Variable is read for up to timeStepsPerRead() steps
+  /// starting at @arg timeStep, so that the following steps come from memory instead of
+  /// the file.
+  /// @param numberOfTimeSteps The number of time steps in the file, which bounds the read.
   /// @pre A call to setupVariables to make sure the variables exist in the data structure.
   /// @post The Variables in the Object have values corresponding to @arg timeStep.
-  virtual void readTimeStep( int exodusFileId, std::size_t timeStep );
+  virtual void readTimeStep(
+    int exodusFileId,
+    std::size_t timeStep,
+    std::size_t numberOfTimeSteps );
 
   virtual void writeTimeStep( int exodusFileId, std::size_t timeStep );
 
@@ -74,8 +107,27 @@ protected:
   /// Inheriting classes must return the appropriate index into the xdmExodus::kObjectTypes array.
   virtual int exodusObjectTypeIndex() const = 0;
 
+  /// Get the NetCDF id of a variable, or zero if it is not known.
+  int variableId( const Variable& variable ) const;
+
 private:
+  // Fill the staging buffer with the values at a time step, reading a new window of time
+  // steps if needed. Returns false if the Variables must be read one at a time instead.
+  bool readStagedTimeStep(
+    int exodusFileId,
+    std::size_t timeStep,
+    std::size_t numberOfTimeSteps );
+
   std::vector< xdm::RefPtr< Variable > > mVariables;
+  xdm::RefPtr< xdm::VectorStructuredArray< double > > mVariableValues;
+  std::vector< int > mVariableIds;
+  // The one-based indices of the Variables in the staging buffer, in buffer order.
+  std::vector< std::size_t > mStagedVariableIndices;
+  // The values of the staged Variables at mWindowSteps time steps, one Variable after another.
+  std::vector< double > mTimeStepWindow;
+  std::size_t mWindowFirstStep;
+  std::size_t mWindowSteps;
+  std::size_t mTimeStepsPerRead;
   int mId;
 };
 
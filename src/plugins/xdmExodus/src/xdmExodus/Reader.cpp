@@ -36,6 +36,7 @@
 #include <xdm/VectorStructuredArray.hpp>
 
 #include <cassert>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -46,6 +47,7 @@ namespace {
 xdm::RefPtr< xdmGrid::Geometry > readGeometry( int exodusFileId, const ex_init_params& gridParameters ) {
   // Read the nodes. For Exodus, there is only one set of nodes per file.
   std::vector< xdm::RefPtr< xdm::VectorStructuredArray< double > > > xyzCoords( 3 );
+  std::vector< double* > coordinatePointers( 3, (double*)0 );
   xdm::RefPtr< xdmGrid::MultiArrayGeometry > geom(
     new xdmGrid::MultiArrayGeometry( gridParameters.num_dim ) );
   for( std::size_t dim = 0; dim < gridParameters.num_dim; ++dim ) {
@@ -53,10 +55,15 @@ xdm::RefPtr< xdmGrid::Geometry > readGeometry( int exodusFileId, const ex_init_p
     xdm::RefPtr< xdm::UniformDataItem > dataItem = makeDataItem(
       xyzCoords[ dim ], xdm::primitiveType::kDouble, gridParameters.num_nodes );
     geom->setCoordinateValues( dim, dataItem );
+    coordinatePointers[ dim ] = xyzCoords[ dim ]->typedData();
   }
 
   EXODUS_CALL(
-    ex_get_coord( exodusFileId, xyzCoords[0]->data(), xyzCoords[1]->data(), xyzCoords[2]->data() ),
+    ex_get_coord(
+      exodusFileId,
+      coordinatePointers[0],
+      coordinatePointers[1],
+      coordinatePointers[2] ),
     "Could not read node coordinates from Exouds file." );
 
   return geom;
@@ -104,62 +111,54 @@ private:
   int mFileId;
 };
 
-// This visitor can be used to traverse a tree that contains Variables. After the visitor
-// is applied, all Variables contain the data from the requested time step. Dynamic casting
+// Ask the file for its number of time steps.
+int queryNumberOfTimeSteps( int exodusFileId ) {
+  int numberOfTimeSteps = 0;
+  EXODUS_CALL( ex_inquire( exodusFileId, EX_INQ_TIME, &numberOfTimeSteps, 0, 0 ),
+    "Unable to read number of time steps." );
+  return numberOfTimeSteps;
+}
+
+// This visitor collects everything in a tree that changes from one time step to the next: the
+// Objects that hold Variables, and the Grids that need the Time attached. Collecting them once
+// means that stepping through time does not have to traverse the tree again. Dynamic casting
 // is required here because the ItemVisitor does not know about xdmGrid or xdmExodus.
-class UpdateVariableVisitor : public xdm::ItemVisitor {
+// The reader only creates Blocks with Exodus variables, so those are the Objects to collect.
+class CollectTimeDependentItemsVisitor : public xdm::ItemVisitor {
 public:
-  UpdateVariableVisitor( int exodusFileId, std::size_t timeStep ) :
-    mTimeStep( timeStep ),
-    mFileId( exodusFileId ),
-    mSomethingWasUpdated( false ) {}
+  CollectTimeDependentItemsVisitor(
+    std::vector< xdm::RefPtr< Block > >& blocks,
+    std::vector< xdm::RefPtr< xdmGrid::Grid > >& grids ) :
+    mBlocks( blocks ),
+    mGrids( grids ) {}
 
-  virtual ~UpdateVariableVisitor() {}
+  virtual ~CollectTimeDependentItemsVisitor() {}
 
   virtual void apply( xdm::Item& item ) {
-    Variable* variable = dynamic_cast< Variable* >( &item );
-    if ( variable ) {
-      variable->readTimeStep( mFileId, mTimeStep );
-      mSomethingWasUpdated = true;
+    Block* block = dynamic_cast< Block* >( &item );
+    if ( block && ! block->variables().empty() ) {
+      mBlocks.push_back( xdm::RefPtr< Block >( block ) );
     }
-  }
-
-  bool somethingWasUpdated() const { return mSomethingWasUpdated; }
-
-private:
-  std::size_t mTimeStep;
-  int mFileId;
-  bool mSomethingWasUpdated;
-};
-
-// This visitor can be used to traverse a tree that contains xdmGrid::Grids. After the
-// visitor is applied, all Grids will have the Time attached to them. Dynamic casting
-// is required here because ItemVisitor does not know about xdmGrid.
-class UpdateTimeVisitor : public xdm::ItemVisitor {
-public:
-  UpdateTimeVisitor( xdm::RefPtr< xdmGrid::Time > time ) :
-    mTime( time ) {}
-
-  virtual ~UpdateTimeVisitor() {}
-
-  virtual void apply( xdm::Item& item ) {
     xdmGrid::Grid* grid = dynamic_cast< xdmGrid::Grid* >( &item );
     if ( grid ) {
-      grid->setTime( mTime );
+      mGrids.push_back( xdm::RefPtr< xdmGrid::Grid >( grid ) );
     }
+    traverse( item );
   }
 
 private:
-  xdm::RefPtr< xdmGrid::Time > mTime;
+  std::vector< xdm::RefPtr< Block > >& mBlocks;
+  std::vector< xdm::RefPtr< xdmGrid::Grid > >& mGrids;
 };
 
 struct ObjectGroupData {
-  std::size_t numberOfObjects;
+  int numberOfObjects;
   std::vector< ExodusString > objectNames;
   std::vector< int > objectIds;
-  std::size_t numberOfVariables;
+  int numberOfVariables;
   std::vector< ExodusString > variableNames;
   std::vector< int > variableTruthTable;
+  std::vector< int > variableIds;
 
   ObjectGroupData() :
     numberOfObjects( 0 ),
@@ -167,7 +166,8 @@ struct ObjectGroupData {
     objectIds(),
     numberOfVariables( 0 ),
     variableNames(),
-    variableTruthTable() {}
+    variableTruthTable(),
+    variableIds() {}
 };
 
 // Returns true if there were objects of this type, false if none exist.
@@ -226,6 +226,11 @@ bool readObjectGroupData(
         ex_get_var_names( exodusFileId, kObjectTypeChar[ objectTypeIndex ],
           group.numberOfVariables, variableNamesCharArray ),
         "Could not read variable names." );
+
+      // Resolve the variables of every object at once so that time steps can be read
+      // without a lookup per variable per object.
+      group.variableIds = readVariableIds( exodusFileId, kObjectTypes[ objectTypeIndex ],
+        group.numberOfObjects, group.numberOfVariables );
     }
   }
   return true;
@@ -250,24 +255,112 @@ iotaArrayOfSizeT( const std::size_t& size, const std::size_t beginWith = 0 ) {
 
 } // anon namespace
 
-ExodusReader::ExodusReader() {
+// The reader session. The Exodus file stays open between calls for as long as the same path is
+// requested, along with the time values and the list of items that change with time.
+struct ExodusReader::Private {
+  xdm::FileSystemPath mPath;
+  std::auto_ptr< ReadableExodusFile > mFile;
+
+  // The time values of the open file, one per time step.
+  std::vector< double > mTimes;
+
+  // The tree that was last updated and its time dependent items.
+  xdm::RefPtr< xdm::Item > mUpdatedItem;
+  std::vector< xdm::RefPtr< Block > > mBlocks;
+  std::vector< xdm::RefPtr< xdmGrid::Grid > > mGrids;
+
+  // The number of time steps read for each variable at once.
+  std::size_t mTimeStepsPerRead;
+
+  Private() :
+    mPath(),
+    mFile(),
+    mTimes(),
+    mUpdatedItem(),
+    mBlocks(),
+    mGrids(),
+    mTimeStepsPerRead( 1 ) {}
+
+  bool isOpen( const xdm::FileSystemPath& path ) const {
+    return mFile.get() && mPath.pathString() == path.pathString();
+  }
+
+  // Get the id of the open file at the given path, opening it if it is not the file that is
+  // already open.
+  int fileId( const xdm::FileSystemPath& path ) {
+    if ( isOpen( path ) ) {
+      return mFile->id();
+    }
+
+    close();
+    mFile.reset( new ReadableExodusFile( path ) );
+    mPath = path;
+    readTimes();
+    return mFile->id();
+  }
+
+  // Read the number of time steps and their values from the open file.
+  void readTimes() {
+    mTimes.resize( queryNumberOfTimeSteps( mFile->id() ) );
+    if ( ! mTimes.empty() ) {
+      EXODUS_CALL( ex_get_all_times( mFile->id(), &mTimes[0] ), "Could not read time values." );
+    }
+  }
+
+  // Collect the time dependent items of a tree if it is not the tree we already know about.
+  void collectTimeDependentItems( xdm::RefPtr< xdm::Item > item ) {
+    if ( item == mUpdatedItem ) {
+      return;
+    }
+    mBlocks.clear();
+    mGrids.clear();
+    CollectTimeDependentItemsVisitor visitor( mBlocks, mGrids );
+    item->accept( visitor );
+    mUpdatedItem = item;
+    applyTimeStepsPerRead();
+  }
+
+  void applyTimeStepsPerRead() {
+    for ( std::size_t i = 0; i < mBlocks.size(); ++i ) {
+      mBlocks[ i ]->setTimeStepsPerRead( mTimeStepsPerRead );
+    }
+  }
+
+  void close() {
+    mFile.reset();
+    mPath = xdm::FileSystemPath();
+    mTimes.clear();
+    mUpdatedItem = xdm::RefPtr< xdm::Item >();
+    mBlocks.clear();
+    mGrids.clear();
+  }
+};
+
+ExodusReader::ExodusReader() :
+  mImp( new Private ) {
 }
 
 ExodusReader::~ExodusReader() {
 }
 
+void ExodusReader::close() {
+  mImp->close();
+}
+
+void ExodusReader::setTimeStepsPerRead( std::size_t steps ) {
+  mImp->mTimeStepsPerRead = steps;
+  mImp->applyTimeStepsPerRead();
+}
+
 xdm::RefPtr< xdm::Item > ExodusReader::readItem( const xdm::FileSystemPath& path ) {
 
-  // Open the file and get some info.
-  ReadableExodusFile file( path );
-  int fileId = file.id();
+  // Open the file and get some info. The file stays open for subsequent updates.
+  int fileId = mImp->fileId( path );
+  std::size_t numberOfTimeSteps = mImp->mTimes.size();
 
-  // Get the mesh parameters and time steps.
+  // Get the mesh parameters.
   ex_init_params gridParameters;
   EXODUS_CALL( ex_get_init_ext( fileId, &gridParameters ), "Unable to read Exodus file parameters." );
-  int numberOfTimeSteps = 0;
-  EXODUS_CALL( ex_inquire( fileId, EX_INQ_TIME, &numberOfTimeSteps, 0, 0 ), "Unable to read"
-    " number of time steps." );
 
   // The Item returned is an xdmGrid::Domain.
   xdm::RefPtr< xdmGrid::Domain > domain( new xdmGrid::Domain );
@@ -323,6 +416,11 @@ xdm::RefPtr< xdm::Item > ExodusReader::readItem( const xdm::FileSystemPath& path
       if ( objectIsBlock( objectTypeIndex ) ) {
 
         xdm::RefPtr< Block > block = blockFactory( kObjectTypes[ objectTypeIndex ] );
+        if ( ! group.variableIds.empty() ) {
+          block->setVariableIds(
+            group.variableIds.begin() + objectInstance * group.numberOfVariables,
+            group.numberOfVariables );
+        }
         block->readFromFile(
           fileId,
           group.objectIds[ objectInstance ],
@@ -384,7 +482,8 @@ xdm::RefPtr< xdm::Item > ExodusReader::readItem( const xdm::FileSystemPath& path
             ex_get_set_dist_fact(
               fileId,
               kObjectTypes[ objectTypeIndex ],
-              group.objectIds[ objectInstance ] ),
+              group.objectIds[ objectInstance ],
+              &distributionFactors[0] ),
             "Could not read set distribution factors." );
         }
 
@@ -430,12 +529,11 @@ xdm::RefPtr< xdm::Item > ExodusReader::readItem( const xdm::FileSystemPath& path
 }
 
 std::size_t ExodusReader::numberOfTimeSteps( const xdm::FileSystemPath& path ) const {
+  if ( mImp->isOpen( path ) ) {
+    return queryNumberOfTimeSteps( mImp->mFile->id() );
+  }
   ReadableExodusFile file( path );
-  int exodusFileId = file.id();
-  int numberOfTimeSteps = 0;
-  EXODUS_CALL( ex_inquire( exodusFileId, EX_INQ_TIME, &numberOfTimeSteps, 0, 0 ), "Unable to read"
-    " number of time steps." );
-  return numberOfTimeSteps;
+  return queryNumberOfTimeSteps( file.id() );
 }
 
 bool ExodusReader::update(
@@ -443,31 +541,34 @@ bool ExodusReader::update(
   const xdm::FileSystemPath& path,
   std::size_t timeStep ) {
 
-  // First make sure we have enough time steps to process the update.
-  if ( timeStep >= numberOfTimeSteps( path ) ) {
-    return false;
+  // First make sure we have enough time steps to process the update. The steps that were in
+  // the file when it was opened are known, so the file is only refreshed for a later step in
+  // case it has grown since.
+  int exodusFileId = mImp->fileId( path );
+  if ( timeStep >= mImp->mTimes.size() ) {
+    EXODUS_CALL( ex_update( exodusFileId ), "Unable to refresh the Exodus file." );
+    mImp->readTimes();
+    if ( timeStep >= mImp->mTimes.size() ) {
+      return false;
+    }
   }
 
-  // Open the Exodus file.
-  ReadableExodusFile file( path );
-  int exodusFileId = file.id();
-
-  // Get the time at this step so that we can attach it to the grids.
-  double timeAtThisStep = 0.0;
-  EXODUS_CALL( ex_get_time( exodusFileId, (int)( timeStep + 1 ), &timeAtThisStep ),
-    "Could not read time step." );
+  // Attach the time at this step to anything that is an xdmGrid::Grid.
+  const std::size_t numberOfTimeSteps = mImp->mTimes.size();
+  double timeValue = mImp->mTimes[ timeStep ];
+  mImp->collectTimeDependentItems( item );
   xdm::RefPtr< xdmGrid::Time > time( new xdmGrid::Time );
-  time->setValue( timeAtThisStep );
-
-  // Attach the time to anything that is an xdmGrid::Grid.
-  UpdateTimeVisitor gridVisitor( time );
-  item->traverse( gridVisitor );
+  time->setValue( timeValue );
+  for ( std::size_t i = 0; i < mImp->mGrids.size(); ++i ) {
+    mImp->mGrids[ i ]->setTime( time );
+  }
 
   // Read the variables at this time step.
-  UpdateVariableVisitor varVisitor( exodusFileId, timeStep );
-  item->traverse( varVisitor );
+  for ( std::size_t i = 0; i < mImp->mBlocks.size(); ++i ) {
+    mImp->mBlocks[ i ]->readTimeStep( exodusFileId, timeStep, numberOfTimeSteps );
+  }
 
-  return varVisitor.somethingWasUpdated();
+  return ! mImp->mBlocks.empty();
 }
 
 
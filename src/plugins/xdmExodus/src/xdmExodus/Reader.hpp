@@ -23,6 +23,7 @@
 
 #include <xdmFormat/Reader.hpp>
 
+#include <memory>
 
 
 namespace xdmExodus {
@@ -30,6 +31,10 @@ namespace xdmExodus {
 /// Class for reading an ExodusII file. Uses the ExodusII library functions to read
 /// an unstructured grid from an ExodusII file complete with nodes and element blocks
 /// for now.
+///
+/// The reader keeps the most recently used file open, together with its time values, so that
+/// stepping through time with update() only reads the variables. Call close() to release the
+/// file before the reader is destroyed.
 class ExodusReader {
 public:
   ExodusReader();
@@ -76,9 +81,25 @@ public:
     const xdm::FileSystemPath& path,
     std::size_t timeStep = 0 );
 
-  /// Get the number of time steps in the ExodusII file.
+  /// Get the number of time steps in the ExodusII file. The file is asked each time, so
+  /// steps that were added since it was opened are counted.
   std::size_t numberOfTimeSteps( const xdm::FileSystemPath& path ) const;
 
+  /// Close the file that is held open between calls.
+  void close();
+
+  /// Set the number of time steps read for each Exodus variable at once. Stepping forward
+  /// through time then reads the file once every @arg steps steps, at the cost of holding
+  /// that many steps of every variable in memory. The default is 1.
+  void setTimeStepsPerRead( std::size_t steps );
+
+private:
+  struct Private;
+  std::auto_ptr< Private > mImp;
+
+  // The reader owns the open file, so it cannot be copied.
+  ExodusReader( const ExodusReader& );
+  ExodusReader& operator=( const ExodusReader& );
 };
 
 } // namespace xdmExodus
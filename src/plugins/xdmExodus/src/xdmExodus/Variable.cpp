@@ -22,9 +22,12 @@
 #include <xdmExodus/Helpers.hpp>
 
 #include <xdm/ArrayAdapter.hpp>
+#include <xdm/ContiguousArray.hpp>
 #include <xdm/VectorStructuredArray.hpp>
 #include <xdm/UniformDataItem.hpp>
 
+#include <cassert>
+
 
 
 namespace xdmExodus {
@@ -38,13 +41,35 @@ Variable::Variable(
   xdmGrid::Attribute( xdmGrid::Attribute::kScalar, xdmGrid::Attribute::kElement ),
   mExodusObjectType( exodusObjectType ),
   mVariableIndex( variableIndex ),
-  mObjectId( objectId ) {
+  mObjectId( objectId ),
+  mStaging() {
+
+  setValues( xdm::makeRefPtr( new xdm::VectorStructuredArray< double >( numberOfEntries ) ) );
+}
+
+Variable::Variable(
+  int exodusObjectType,
+  int variableIndex,
+  int objectId,
+  std::size_t numberOfEntries,
+  xdm::RefPtr< xdm::VectorStructuredArray< double > > staging,
+  std::size_t stagingOffset ) :
+
+  xdmGrid::Attribute( xdmGrid::Attribute::kScalar, xdmGrid::Attribute::kElement ),
+  mExodusObjectType( exodusObjectType ),
+  mVariableIndex( variableIndex ),
+  mObjectId( objectId ),
+  mStaging( staging ) {
+
+  assert( stagingOffset + numberOfEntries <= staging->size() );
+  setValues( xdm::makeRefPtr(
+    new xdm::ContiguousArray< double >( staging->begin() + stagingOffset, numberOfEntries ) ) );
+}
 
-  xdm::RefPtr< xdm::VectorStructuredArray< double > > data(
-    new xdm::VectorStructuredArray< double >( numberOfEntries ) );
+void Variable::setValues( xdm::RefPtr< xdm::StructuredArray > values ) {
   xdm::RefPtr< xdm::UniformDataItem > dataItem(
-    new xdm::UniformDataItem( xdm::primitiveType::kDouble, xdm::makeShape( numberOfEntries ) ) );
-  dataItem->setData( xdm::makeRefPtr( new xdm::ArrayAdapter( data ) ) );
+    new xdm::UniformDataItem( xdm::primitiveType::kDouble, xdm::makeShape( values->size() ) ) );
+  dataItem->setData( xdm::makeRefPtr( new xdm::ArrayAdapter( values ) ) );
   dataItem->data()->setIsDynamic( true );
   setDataItem( dataItem );
 }
@@ -54,7 +79,7 @@ void Variable::readTimeStep( int exodusFileId, std::size_t timeStep ) {
     ex_get_var(
       exodusFileId,
       (int)( timeStep + 1 ),
-      mExodusObjectType,
+      (ex_entity_type)mExodusObjectType,
       mVariableIndex,
       mObjectId,
       (int)dataItem()->data()->array()->size(),
@@ -67,7 +92,7 @@ void Variable::writeTimeStep( int exodusFileId, std::size_t timeStep ) {
     ex_put_var(
       exodusFileId,
       (int)( timeStep + 1 ),
-      mExodusObjectType,
+      (ex_entity_type)mExodusObjectType,
       mVariableIndex,
       mObjectId,
       (int)dataItem()->data()->array()->size(),
@@ -75,6 +100,21 @@ void Variable::writeTimeStep( int exodusFileId, std::size_t timeStep ) {
     "Unable to write variable." );
 }
 
+void Variable::writeTimeStep( int exodusFileId, std::size_t timeStep, int netcdfVariableId ) {
+  EXODUS_CALL(
+    ex_put_varid_var(
+      exodusFileId,
+      (int)( timeStep + 1 ),
+      netcdfVariableId,
+      (int)numberOfEntries(),
+      dataItem()->typedArray< double >()->begin() ),
+    "Unable to write variable." );
+}
+
+std::size_t Variable::numberOfEntries() const {
+  return dataItem()->dataspace()[0];
+}
+
 int Variable::id() const {
   return mVariableIndex;
 }
@@ -23,11 +23,8 @@
 
 #include <xdmGrid/Attribute.hpp>
 
-#include <xdm/NamespaceMacro.hpp>
-
-XDM_NAMESPACE_BEGIN
-template< typename T > class VectorStructuredArray;
-XDM_NAMESPACE_END
+#include <xdm/Forward.hpp>
+#include <xdm/RefPtr.hpp>
 
 
 
@@ -35,22 +32,46 @@ namespace xdmExodus {
 
 class Variable : public xdmGrid::Attribute {
 public:
+  /// Construct a Variable that owns its values.
+  /// @param variableIndex The one-based Exodus index of the variable.
   Variable(
     int exodusObjectType,
     int variableIndex,
     int objectId,
     std::size_t numberOfEntries );
 
+  /// Construct a Variable whose values live in a staging buffer shared by all of the
+  /// variables of an Object. The Variable keeps the buffer alive.
+  /// @param staging The shared buffer.
+  /// @param stagingOffset The position of this Variable's first value in the buffer.
+  Variable(
+    int exodusObjectType,
+    int variableIndex,
+    int objectId,
+    std::size_t numberOfEntries,
+    xdm::RefPtr< xdm::VectorStructuredArray< double > > staging,
+    std::size_t stagingOffset );
+
   void readTimeStep( int exodusFileId, std::size_t timeStep );
 
   void writeTimeStep( int exodusFileId, std::size_t timeStep );
 
+  /// Write the values at a time step through the NetCDF id of the variable. This skips the
+  /// variable lookup that writeTimeStep() performs on every call.
+  void writeTimeStep( int exodusFileId, std::size_t timeStep, int netcdfVariableId );
+
   int id() const;
 
+  /// Get the number of values, one per entry of the Object.
+  std::size_t numberOfEntries() const;
+
 private:
+  void setValues( xdm::RefPtr< xdm::StructuredArray > values );
+
   int mExodusObjectType;
   int mVariableIndex;
   int mObjectId;
+  xdm::RefPtr< xdm::VectorStructuredArray< double > > mStaging;
 };
 
 } // namespace xdmExodus
@@ -145,15 +145,15 @@ public:
     }
   }
 
-  xdm::RefPtr< xdmGrid::Time > time() { return mTime; }
+  xdm::RefPtr< const xdmGrid::Time > time() { return mTime; }
 
 private:
-  xdm::RefPtr< xdmGrid::Time > mTime;
+  xdm::RefPtr< const xdmGrid::Time > mTime;
 };
 
 void writeBlockData(
   int exodusFileId,
-  int exodusObjectType,
+  ex_entity_type exodusObjectType,
   const VariableNameMap& variableNames,
   std::vector< Object* >& objects ) {
 
@@ -195,6 +195,16 @@ void writeBlockData(
     numberOfVariables,
     &variableTruthTable[0] ),
   "Unable to write variable truth table." );
+
+  // Now that the variables are defined, look up their ids once for all of the blocks.
+  if ( numberOfVariables > 0 ) {
+    std::vector< int > variableIds = readVariableIds(
+      exodusFileId, exodusObjectType, objects.size(), numberOfVariables );
+    for ( std::size_t blockIndex = 0; blockIndex < objects.size(); ++blockIndex ) {
+      objects[ blockIndex ]->setVariableIds(
+        variableIds.begin() + blockIndex * numberOfVariables, numberOfVariables );
+    }
+  }
 }
 
 } // anon namespace
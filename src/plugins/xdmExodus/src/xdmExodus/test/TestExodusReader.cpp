@@ -18,15 +18,362 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 //------------------------------------------------------------------------------
-#define BOOST_TEST_MODULE Geometry
+#define BOOST_TEST_MODULE ExodusReader
 #include <boost/test/unit_test.hpp>
 
+#include <xdmExodus/Blocks.hpp>
+#include <xdmExodus/Helpers.hpp>
 #include <xdmExodus/Reader.hpp>
+#include <xdmExodus/Variable.hpp>
+
+#include <xdmGrid/ElementTopology.hpp>
+#include <xdmGrid/Time.hpp>
+#include <xdmGrid/UnstructuredTopology.hpp>
+
+#include <xdm/ArrayAdapter.hpp>
+#include <xdm/DataShape.hpp>
+#include <xdm/FileSystem.hpp>
+#include <xdm/ItemVisitor.hpp>
+#include <xdm/RefPtr.hpp>
+#include <xdm/UniformDataItem.hpp>
+#include <xdm/VectorStructuredArray.hpp>
+
+#include <xdmFormat/IoExcept.hpp>
+
+#include <exodusII.h>
+
+#include <limits>
+#include <vector>
 
 namespace {
 
-BOOST_AUTO_TEST_CASE( doNothing ) {
-  BOOST_CHECK_EQUAL( "foo", "foo" );
+const int kNumberOfNodes = 6;
+const int kNumberOfElements = 2;
+const int kNodesPerElement = 4;
+const int kNumberOfVariables = 2;
+const int kBlockId = 1;
+
+// Two quadrilaterals side by side, with Exodus one-based node numbers.
+const int kConnectivity[ kNumberOfElements * kNodesPerElement ] = { 1, 2, 5, 4, 2, 3, 6, 5 };
+
+// The value of a variable at an element and a time step. Variables and elements are zero-based.
+double variableValue( int variable, int element, std::size_t timeStep ) {
+  return 100.0 * timeStep + 10.0 * variable + element;
+}
+
+double timeValue( std::size_t timeStep ) {
+  return 0.5 * timeStep;
+}
+
+// Write the time and the variable values of a range of time steps to an open Exodus file.
+void writeTimeSteps( int fileId, std::size_t firstStep, std::size_t numberOfSteps ) {
+  for ( std::size_t step = firstStep; step < firstStep + numberOfSteps; ++step ) {
+    double time = timeValue( step );
+    BOOST_REQUIRE_EQUAL( 0, ex_put_time( fileId, (int)( step + 1 ), &time ) );
+    for ( int variable = 0; variable < kNumberOfVariables; ++variable ) {
+      std::vector< double > values( kNumberOfElements );
+      for ( int element = 0; element < kNumberOfElements; ++element ) {
+        values[ element ] = variableValue( variable, element, step );
+      }
+      BOOST_REQUIRE_EQUAL( 0, ex_put_elem_var(
+        fileId, (int)( step + 1 ), variable + 1, kBlockId, kNumberOfElements, &values[0] ) );
+    }
+  }
+}
+
+// Create an Exodus file with the nodes and the element block of two quadrilaterals, but
+// without the block connectivity.
+int createExodusFile( const xdm::FileSystemPath& path ) {
+  int wordSize = sizeof( double );
+  int fileId = ex_create( path.pathString().c_str(), EX_CLOBBER, &wordSize, &wordSize );
+  BOOST_REQUIRE( fileId >= 0 );
+
+  BOOST_REQUIRE_EQUAL( 0, ex_put_init(
+    fileId, "ExodusReader", 2, kNumberOfNodes, kNumberOfElements, 1, 0, 0 ) );
+  double x[ kNumberOfNodes ] = { 0.0, 1.0, 2.0, 0.0, 1.0, 2.0 };
+  double y[ kNumberOfNodes ] = { 0.0, 0.0, 0.0, 1.0, 1.0, 1.0 };
+  BOOST_REQUIRE_EQUAL( 0, ex_put_coord( fileId, x, y, 0 ) );
+
+  BOOST_REQUIRE_EQUAL( 0, ex_put_elem_block(
+    fileId, kBlockId, "QUAD4", kNumberOfElements, kNodesPerElement, 0 ) );
+  return fileId;
+}
+
+// Write two quadrilaterals side by side in one element block with two element variables that
+// are defined at each time step.
+void writeExodusFile( const xdm::FileSystemPath& path, std::size_t numberOfSteps ) {
+  int fileId = createExodusFile( path );
+  BOOST_REQUIRE_EQUAL( 0, ex_put_elem_conn( fileId, kBlockId, kConnectivity ) );
+
+  char first[] = "first";
+  char second[] = "second";
+  char* names[ kNumberOfVariables ] = { first, second };
+  BOOST_REQUIRE_EQUAL( 0, ex_put_var_param( fileId, "E", kNumberOfVariables ) );
+  BOOST_REQUIRE_EQUAL( 0, ex_put_var_names( fileId, "E", kNumberOfVariables, names ) );
+  int truthTable[ kNumberOfVariables ] = { 1, 1 };
+  BOOST_REQUIRE_EQUAL( 0, ex_put_elem_var_tab( fileId, 1, kNumberOfVariables, truthTable ) );
+
+  writeTimeSteps( fileId, 0, numberOfSteps );
+  BOOST_REQUIRE_EQUAL( 0, ex_close( fileId ) );
+}
+
+int openExodusFile( const xdm::FileSystemPath& path, int mode ) {
+  int wordSize = sizeof( double );
+  int storedWordSize = 0;
+  float version;
+  int fileId = ex_open( path.pathString().c_str(), mode, &wordSize, &storedWordSize, &version );
+  BOOST_REQUIRE( fileId >= 0 );
+  return fileId;
+}
+
+// Find the element block in a tree read from an Exodus file.
+class FindBlockVisitor : public xdm::ItemVisitor {
+public:
+  virtual void apply( xdm::Item& item ) {
+    xdmExodus::ElementBlock* block = dynamic_cast< xdmExodus::ElementBlock* >( &item );
+    if ( block ) {
+      if ( ! mBlock.valid() ) {
+        mBlock = xdm::RefPtr< xdmExodus::ElementBlock >( block );
+      }
+      return;
+    }
+    traverse( item );
+  }
+
+  xdm::RefPtr< xdmExodus::ElementBlock > mBlock;
+};
+
+xdm::RefPtr< xdmExodus::ElementBlock > findBlock( xdm::RefPtr< xdm::Item > item ) {
+  FindBlockVisitor visitor;
+  item->accept( visitor );
+  BOOST_REQUIRE( visitor.mBlock.valid() );
+  return visitor.mBlock;
+}
+
+// Find the connectivity array of a topology.
+class FindConnectivityVisitor : public xdm::ItemVisitor {
+public:
+  virtual void apply( xdm::UniformDataItem& item ) {
+    mConnectivity = xdm::RefPtr< xdm::UniformDataItem >( &item );
+  }
+
+  xdm::RefPtr< xdm::UniformDataItem > mConnectivity;
+};
+
+// Check that the Variables of a block hold the values at a time step.
+void checkVariables( xdm::RefPtr< xdmExodus::ElementBlock > block, std::size_t timeStep ) {
+  std::vector< xdm::RefPtr< xdmExodus::Variable > > variables = block->variables();
+  BOOST_REQUIRE_EQUAL( kNumberOfVariables, variables.size() );
+  for ( int variable = 0; variable < kNumberOfVariables; ++variable ) {
+    BOOST_CHECK_EQUAL( variable + 1, variables[ variable ]->id() );
+    xdm::RefPtr< xdm::TypedStructuredArray< double > > values =
+      variables[ variable ]->dataItem()->typedArray< double >();
+    BOOST_REQUIRE_EQUAL( kNumberOfElements, values->size() );
+    for ( int element = 0; element < kNumberOfElements; ++element ) {
+      BOOST_CHECK_EQUAL( variableValue( variable, element, timeStep ), (*values)[ element ] );
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( stagedVariablesAtEachStep ) {
+  // More steps than are read ahead at once, so that the read ahead window moves and the last
+  // window is cut short by the end of the file.
+  const std::size_t kNumberOfSteps = 20;
+  xdm::FileSystemPath path( "ExodusReader.staged.exo" );
+  writeExodusFile( path, kNumberOfSteps );
+
+  xdmExodus::ExodusReader reader;
+  reader.setTimeStepsPerRead( 8 );
+  xdm::RefPtr< xdm::Item > item = reader.readItem( path );
+  xdm::RefPtr< xdmExodus::ElementBlock > block = findBlock( item );
+
+  // The values of both variables share one staging buffer.
+  xdm::RefPtr< const xdm::VectorStructuredArray< double > > staging = block->variableValues();
+  BOOST_REQUIRE( staging.valid() );
+  BOOST_REQUIRE_EQUAL( kNumberOfVariables * kNumberOfElements, staging->size() );
+
+  for ( std::size_t step = 0; step < kNumberOfSteps; ++step ) {
+    BOOST_REQUIRE( reader.update( item, path, step ) );
+    checkVariables( block, step );
+    for ( int variable = 0; variable < kNumberOfVariables; ++variable ) {
+      for ( int element = 0; element < kNumberOfElements; ++element ) {
+        BOOST_CHECK_EQUAL( variableValue( variable, element, step ),
+          (*staging)[ variable * kNumberOfElements + element ] );
+      }
+    }
+  }
+
+  // Going back to an earlier step reads it again.
+  BOOST_REQUIRE( reader.update( item, path, 3 ) );
+  checkVariables( block, 3 );
+
+  reader.close();
+  xdm::remove( path );
+}
+
+BOOST_AUTO_TEST_CASE( writeStagedVariables ) {
+  xdm::FileSystemPath path( "ExodusReader.written.exo" );
+  writeExodusFile( path, 1 );
+
+  xdmExodus::ExodusReader reader;
+  xdm::RefPtr< xdm::Item > item = reader.readItem( path );
+  BOOST_REQUIRE( reader.update( item, path, 0 ) );
+  reader.close();
+
+  // Put the values of the next time step in the Variables and write them through the block.
+  xdm::RefPtr< xdmExodus::ElementBlock > block = findBlock( item );
+  std::vector< xdm::RefPtr< xdmExodus::Variable > > variables = block->variables();
+  BOOST_REQUIRE_EQUAL( kNumberOfVariables, variables.size() );
+  for ( int variable = 0; variable < kNumberOfVariables; ++variable ) {
+    xdm::RefPtr< xdm::TypedStructuredArray< double > > values =
+      variables[ variable ]->dataItem()->typedArray< double >();
+    for ( int element = 0; element < kNumberOfElements; ++element ) {
+      (*values)[ element ] = variableValue( variable, element, 1 );
+    }
+  }
+  int fileId = openExodusFile( path, EX_WRITE );
+  double time = timeValue( 1 );
+  BOOST_REQUIRE_EQUAL( 0, ex_put_time( fileId, 2, &time ) );
+  block->writeTimeStep( fileId, 1 );
+  BOOST_REQUIRE_EQUAL( 0, ex_close( fileId ) );
+
+  // Both time steps read back.
+  xdmExodus::ExodusReader copyReader;
+  xdm::RefPtr< xdm::Item > copy = copyReader.readItem( path );
+  BOOST_REQUIRE_EQUAL( 2, copyReader.numberOfTimeSteps( path ) );
+  for ( std::size_t step = 0; step < 2; ++step ) {
+    BOOST_REQUIRE( copyReader.update( copy, path, step ) );
+    checkVariables( findBlock( copy ), step );
+  }
+
+  copyReader.close();
+  xdm::remove( path );
+}
+
+BOOST_AUTO_TEST_CASE( multipleTimeSteps ) {
+  const std::size_t kNumberOfSteps = 4;
+  xdm::FileSystemPath path( "ExodusReader.steps.exo" );
+  writeExodusFile( path, kNumberOfSteps );
+
+  xdmExodus::ExodusReader reader;
+  BOOST_CHECK_EQUAL( kNumberOfSteps, reader.numberOfTimeSteps( path ) );
+  xdm::RefPtr< xdm::Item > item = reader.readItem( path );
+  xdm::RefPtr< xdmExodus::ElementBlock > block = findBlock( item );
+
+  // The blocks are below the spatial collection, and each step reaches them.
+  for ( std::size_t step = 0; step < kNumberOfSteps; ++step ) {
+    BOOST_REQUIRE( reader.update( item, path, step ) );
+    BOOST_REQUIRE( block->time().valid() );
+    BOOST_CHECK_EQUAL( timeValue( step ), block->time()->value() );
+    checkVariables( block, step );
+  }
+  BOOST_CHECK( ! reader.update( item, path, kNumberOfSteps ) );
+
+  reader.close();
+  xdm::remove( path );
+}
+
+BOOST_AUTO_TEST_CASE( stepsAddedWhileOpen ) {
+  xdm::FileSystemPath path( "ExodusReader.growing.exo" );
+  writeExodusFile( path, 2 );
+
+  xdmExodus::ExodusReader reader;
+  xdm::RefPtr< xdm::Item > item = reader.readItem( path );
+  BOOST_REQUIRE( reader.update( item, path, 1 ) );
+  BOOST_CHECK( ! reader.update( item, path, 2 ) );
+
+  // Append a step while the reader holds the file open.
+  int fileId = openExodusFile( path, EX_WRITE );
+  writeTimeSteps( fileId, 2, 1 );
+  BOOST_REQUIRE_EQUAL( 0, ex_close( fileId ) );
+
+  BOOST_CHECK_EQUAL( 3, reader.numberOfTimeSteps( path ) );
+  BOOST_REQUIRE( reader.update( item, path, 2 ) );
+  xdm::RefPtr< xdmExodus::ElementBlock > block = findBlock( item );
+  BOOST_CHECK_EQUAL( timeValue( 2 ), block->time()->value() );
+  checkVariables( block, 2 );
+
+  reader.close();
+  xdm::remove( path );
+}
+
+BOOST_AUTO_TEST_CASE( readVariableTimeSeries ) {
+  const std::size_t kNumberOfSteps = 5;
+  xdm::FileSystemPath path( "ExodusReader.series.exo" );
+  writeExodusFile( path, kNumberOfSteps );
+
+  xdmExodus::ExodusReader reader;
+  xdm::RefPtr< xdm::Item > item = reader.readItem( path );
+  xdm::RefPtr< xdmExodus::ElementBlock > block = findBlock( item );
+
+  int fileId = openExodusFile( path, EX_READ );
+
+  // The second variable at the second element from the second step to the last step.
+  std::vector< double > series( kNumberOfSteps - 1 );
+  block->readVariableTimeSeries( fileId, 2, 1, 1, kNumberOfSteps - 1, &series[0] );
+  for ( std::size_t step = 1; step < kNumberOfSteps; ++step ) {
+    BOOST_CHECK_EQUAL( variableValue( 1, 1, step ), series[ step - 1 ] );
+  }
+
+  ex_close( fileId );
+  reader.close();
+  xdm::remove( path );
+}
+
+BOOST_AUTO_TEST_CASE( connectivityRoundTrip ) {
+  xdm::FileSystemPath path( "ExodusReader.connectivity.exo" );
+  int fileId = createExodusFile( path );
+
+  // Write the zero-based connectivity of a topology to the block.
+  xdm::RefPtr< xdm::VectorStructuredArray< std::size_t > > zeroBased(
+    new xdm::VectorStructuredArray< std::size_t >( kNumberOfElements * kNodesPerElement ) );
+  for ( std::size_t i = 0; i < zeroBased->size(); ++i ) {
+    (*zeroBased)[ i ] = kConnectivity[ i ] - 1;
+  }
+  xdm::RefPtr< xdm::UniformDataItem > connectivity( new xdm::UniformDataItem(
+    xdm::primitiveType::kLongUnsignedInt, xdm::makeShape( kNumberOfElements, kNodesPerElement ) ) );
+  connectivity->setData( xdm::makeRefPtr( new xdm::ArrayAdapter( zeroBased ) ) );
+  xdm::RefPtr< xdmGrid::UnstructuredTopology > topology( new xdmGrid::UnstructuredTopology );
+  topology->setConnectivity( connectivity );
+  topology->setNumberOfElements( kNumberOfElements );
+  topology->setElementTopology( xdmGrid::quadrilateralFactory( 1 ) );
+  xdmExodus::writeConnectivity( fileId, EX_ELEM_BLOCK, kBlockId, *topology );
+  BOOST_REQUIRE_EQUAL( 0, ex_close( fileId ) );
+
+  // The file holds the one-based node numbers.
+  fileId = openExodusFile( path, EX_READ );
+  std::vector< int > written( kNumberOfElements * kNodesPerElement );
+  BOOST_REQUIRE_EQUAL( 0, ex_get_elem_conn( fileId, kBlockId, &written[0] ) );
+  BOOST_CHECK_EQUAL_COLLECTIONS(
+    written.begin(), written.end(), kConnectivity, kConnectivity + written.size() );
+  ex_close( fileId );
+
+  // The reader widens them back to the zero-based values in place.
+  xdmExodus::ExodusReader reader;
+  xdm::RefPtr< xdm::Item > item = reader.readItem( path );
+  xdm::RefPtr< xdmExodus::ElementBlock > block = findBlock( item );
+  BOOST_CHECK_EQUAL( kNumberOfElements, block->numberOfEntries() );
+  FindConnectivityVisitor visitor;
+  block->topology()->traverse( visitor );
+  BOOST_REQUIRE( visitor.mConnectivity.valid() );
+  xdm::RefPtr< xdm::TypedStructuredArray< std::size_t > > read =
+    visitor.mConnectivity->typedArray< std::size_t >();
+  BOOST_CHECK_EQUAL_COLLECTIONS( read->begin(), read->end(), zeroBased->begin(), zeroBased->end() );
+
+  reader.close();
+  xdm::remove( path );
+}
+
+BOOST_AUTO_TEST_CASE( narrowToOneBaseRange ) {
+  // The largest index that fits is one less than the largest int.
+  std::size_t values[] = { 0, std::numeric_limits< int >::max() - 1 };
+  int exodusValues[2] = { 0, 0 };
+  xdmExodus::narrowToOneBase( values, 2, exodusValues );
+  BOOST_CHECK_EQUAL( 1, exodusValues[0] );
+  BOOST_CHECK_EQUAL( std::numeric_limits< int >::max(), exodusValues[1] );
+
+  values[1] = std::numeric_limits< int >::max();
+  BOOST_CHECK_THROW( xdmExodus::narrowToOneBase( values, 2, exodusValues ), xdmFormat::WriteError );
 }
 
 } // namespace
@@ -0,0 +1,401 @@
+//=============================================================================
+// This software developed by Stellar Science Ltd Co and the U.S. Government.
+// Copyright (C) 2009 Stellar Science. Government-purpose rights granted.
+//-----------------------------------------------------------------------------
+#include <xdmf/StreamingXmfReader.hpp>
+
+#include <xdmf/impl/TreeBuilder.hpp>
+#include <xdmf/impl/XmlDocumentManager.hpp>
+
+#include <xdm/FileSystem.hpp>
+#include <xdm/Item.hpp>
+#include <xdm/RefPtr.hpp>
+#include <xdm/ThrowMacro.hpp>
+#include <xdm/UpdateVisitor.hpp>
+
+#include <libxml/parser.h>
+#include <libxml/tree.h>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <cstring>
+
+namespace xdmf {
+
+namespace {
+
+// Size of the blocks read from disk while indexing a file.
+const std::size_t kIndexBlockSize = 1 << 16;
+
+// Size of the blocks read backwards when searching for the start of a tag.
+const long kTagSearchBlockSize = 256;
+
+// Byte range of a time step Grid element within a file. The begin offset lies
+// within the Grid start tag and the end offset is just past the end tag.
+struct StepRange {
+  StepRange() : begin( 0 ), end( 0 ) {}
+  long begin;
+  long end;
+};
+
+// Everything known about a file after it has been indexed, along with the
+// document holding the step currently in memory.
+struct Session {
+  Session() :
+    encoding(),
+    namespaces(),
+    steps(),
+    document(),
+    nodes(),
+    currentStep( 0 ) {}
+
+  std::string encoding;
+  std::vector< std::string > namespaces;
+  std::vector< StepRange > steps;
+  xdm::RefPtr< impl::XmlDocumentManager > document;
+  xdm::RefPtr< impl::SharedNodeVector > nodes;
+  std::size_t currentStep;
+};
+
+// State for the SAX pass over a document. The element path is tracked so that
+// only Grid elements directly under /Xdmf/Domain or under the temporal
+// collection are considered.
+struct IndexState {
+  IndexState() :
+    context( NULL ),
+    path(),
+    collectionDepth( 0 ),
+    collectionFound( false ),
+    stepDepth( 0 ),
+    current(),
+    steps(),
+    firstGrid(),
+    firstGridFound( false ),
+    namespaces() {}
+
+  xmlParserCtxtPtr context;
+  std::vector< std::string > path;
+  // Depth of the open temporal collection, or 0 outside of it.
+  std::size_t collectionDepth;
+  bool collectionFound;
+  // Depth of the Grid being recorded, or 0 if none is.
+  std::size_t stepDepth;
+  StepRange current;
+  std::vector< StepRange > steps;
+  // The first Grid in the Domain, used when there is no temporal collection.
+  StepRange firstGrid;
+  bool firstGridFound;
+  // Namespace declarations made outside of the step Grids.
+  std::vector< std::string > namespaces;
+};
+
+bool isTemporalCollection( int nb_attributes, const xmlChar ** attributes ) {
+  bool collection = false;
+  bool temporal = false;
+  for ( int i = 0; i < nb_attributes; i++ ) {
+    // Attributes are given as (localname, prefix, URI, value, end) tuples.
+    const xmlChar ** attribute = attributes + 5 * i;
+    std::string name( (const char *)attribute[0] );
+    std::string value(
+      (const char *)attribute[3],
+      (const char *)attribute[4] );
+    if ( name == "GridType" && value == "Collection" ) collection = true;
+    if ( name == "CollectionType" && value == "Temporal" ) temporal = true;
+  }
+  return collection && temporal;
+}
+
+void startElement(
+  void * ctx,
+  const xmlChar * localname,
+  const xmlChar * prefix,
+  const xmlChar * URI,
+  int nb_namespaces,
+  const xmlChar ** namespaces,
+  int nb_attributes,
+  int nb_defaulted,
+  const xmlChar ** attributes )
+{
+  IndexState& state = *static_cast< IndexState * >( ctx );
+  state.path.push_back( (const char *)localname );
+  std::size_t depth = state.path.size();
+
+  if ( state.stepDepth != 0 ) {
+    return;
+  }
+
+  // Keep the namespace declarations of the step's ancestors so that they can
+  // be restated when a step is parsed on its own.
+  for ( int i = 0; i < nb_namespaces; i++ ) {
+    std::string declaration( "xmlns" );
+    if ( namespaces[2*i] ) {
+      declaration += ':';
+      declaration += (const char *)namespaces[2*i];
+    }
+    declaration += "=\"";
+    declaration += (const char *)namespaces[2*i+1];
+    declaration += '"';
+    state.namespaces.push_back( declaration );
+  }
+
+  if ( state.path.back() != "Grid" ) {
+    return;
+  }
+
+  if ( depth == 3 && state.path[0] == "Xdmf" && state.path[1] == "Domain" ) {
+    if ( !state.collectionFound
+      && isTemporalCollection( nb_attributes, attributes ) ) {
+      state.collectionFound = true;
+      state.collectionDepth = depth;
+    } else if ( !state.firstGridFound ) {
+      state.stepDepth = depth;
+      state.current.begin = xmlByteConsumed( state.context );
+    }
+  } else if ( state.collectionDepth != 0
+    && depth == state.collectionDepth + 1 ) {
+    state.stepDepth = depth;
+    state.current.begin = xmlByteConsumed( state.context );
+  }
+}
+
+void endElement(
+  void * ctx,
+  const xmlChar * localname,
+  const xmlChar * prefix,
+  const xmlChar * URI )
+{
+  IndexState& state = *static_cast< IndexState * >( ctx );
+  std::size_t depth = state.path.size();
+  if ( depth == state.stepDepth ) {
+    state.current.end = xmlByteConsumed( state.context );
+    if ( state.collectionDepth != 0 ) {
+      state.steps.push_back( state.current );
+    } else {
+      state.firstGrid = state.current;
+      state.firstGridFound = true;
+    }
+    state.stepDepth = 0;
+  } else if ( depth == state.collectionDepth ) {
+    state.collectionDepth = 0;
+  }
+  state.path.pop_back();
+}
+
+// Stream the file through the SAX parser to find the byte range of each step.
+void indexFile( const xdm::FileSystemPath& path, Session& session ) {
+  std::ifstream file( path.pathString().c_str(), std::ios::binary );
+  if ( !file ) {
+    XDM_THROW( xdmFormat::ReadError( "Unable to open XDMF document." ) );
+  }
+
+  xmlSAXHandler handler;
+  std::memset( &handler, 0, sizeof( handler ) );
+  handler.initialized = XML_SAX2_MAGIC;
+  handler.startElementNs = &startElement;
+  handler.endElementNs = &endElement;
+
+  IndexState state;
+  state.context = xmlCreatePushParserCtxt(
+    &handler, &state, NULL, 0, path.pathString().c_str() );
+  if ( !state.context ) {
+    XDM_THROW( xdmFormat::ReadError( "Unable to parse XDMF document." ) );
+  }
+
+  std::vector< char > buffer( kIndexBlockSize );
+  int error = 0;
+  while ( error == 0 && file ) {
+    file.read( &buffer[0], buffer.size() );
+    if ( file.gcount() > 0 ) {
+      error = xmlParseChunk(
+        state.context, &buffer[0], static_cast< int >( file.gcount() ), 0 );
+    }
+  }
+  if ( error == 0 ) {
+    error = xmlParseChunk( state.context, NULL, 0, 1 );
+  }
+  bool wellFormed = ( error == 0 && state.context->wellFormed );
+  if ( state.context->encoding ) {
+    session.encoding = (const char *)state.context->encoding;
+  }
+  xmlFreeParserCtxt( state.context );
+
+  if ( !wellFormed ) {
+    XDM_THROW( xdmFormat::ReadError( "Unable to parse XDMF document." ) );
+  }
+  if ( state.collectionFound ) {
+    if ( state.steps.empty() ) {
+      XDM_THROW( xdmFormat::ReadError(
+        "XDMF Temporal collection contains no time steps" ) );
+    }
+    session.steps.swap( state.steps );
+  } else if ( state.firstGridFound ) {
+    session.steps.push_back( state.firstGrid );
+  } else {
+    XDM_THROW( xdmFormat::ReadError( "XDMF document contains no grids." ) );
+  }
+  session.namespaces.swap( state.namespaces );
+}
+
+// Read the text of a step Grid from the file. The recorded begin offset lies
+// within the start tag, and since '<' cannot appear inside a tag, the tag
+// starts at the last '<' before it.
+std::string readStepText(
+  const xdm::FileSystemPath& path,
+  const StepRange& range )
+{
+  std::ifstream file( path.pathString().c_str(), std::ios::binary );
+  long start = -1;
+  long position = range.begin;
+  char block[kTagSearchBlockSize];
+  while ( file && start < 0 && position > 0 ) {
+    long blockStart = std::max( 0L, position - kTagSearchBlockSize );
+    file.seekg( blockStart );
+    file.read( block, position - blockStart );
+    for ( long i = position - blockStart - 1; i >= 0; i-- ) {
+      if ( block[i] == '<' ) {
+        start = blockStart + i;
+        break;
+      }
+    }
+    position = blockStart;
+  }
+
+  std::string result;
+  if ( file && start >= 0 && range.end > start ) {
+    result.resize( range.end - start );
+    file.seekg( start );
+    file.read( &result[0], result.size() );
+  }
+  if ( !file || result.compare( 0, 5, "<Grid" ) != 0 ) {
+    XDM_THROW( xdmFormat::ReadError(
+      "Unable to locate XDMF time step in document." ) );
+  }
+  return result;
+}
+
+xmlNode * firstElement( xmlNode * parent ) {
+  for ( xmlNode * child = parent->children; child; child = child->next ) {
+    if ( child->type == XML_ELEMENT_NODE ) {
+      return child;
+    }
+  }
+  return NULL;
+}
+
+// Parse a single step into a document of its own, restating the namespaces of
+// the original document around it.
+xmlDoc * readStep(
+  const xdm::FileSystemPath& path,
+  const Session& session,
+  std::size_t step )
+{
+  std::ostringstream text;
+  text << "<Xdmf";
+  for ( std::size_t i = 0; i < session.namespaces.size(); i++ ) {
+    text << ' ' << session.namespaces[i];
+  }
+  text << "><Domain>" << readStepText( path, session.steps[step] )
+    << "</Domain></Xdmf>";
+  std::string buffer = text.str();
+  xmlDoc * document = xmlReadMemory(
+    buffer.data(),
+    static_cast< int >( buffer.size() ),
+    path.pathString().c_str(),
+    session.encoding.empty() ? NULL : session.encoding.c_str(),
+    0 );
+  if ( !document ) {
+    XDM_THROW( xdmFormat::ReadError( "Unable to parse XDMF time step." ) );
+  }
+  return document;
+}
+
+// Get the step Grid from a document produced by readStep.
+xmlNode * stepGrid( xmlDoc * document ) {
+  return firstElement( firstElement( xmlDocGetRootElement( document ) ) );
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+class StreamingXmfReader::Private {
+public:
+  typedef std::map< xdm::FileSystemPath, Session > SessionMap;
+  SessionMap mSessions;
+};
+
+StreamingXmfReader::StreamingXmfReader() :
+  xdmFormat::Reader(),
+  mImp( new Private ) {
+}
+
+StreamingXmfReader::~StreamingXmfReader() {
+}
+
+xdmFormat::ReadResult StreamingXmfReader::readItem(
+  const xdm::FileSystemPath& path )
+{
+  // Check the file exists.
+  if ( !exists( path ) ) {
+    XDM_THROW( xdmFormat::ReadError( "Requested path does not exist." ) );
+  }
+
+  Session session;
+  indexFile( path, session );
+
+  // Load the first step and build the tree from it. Every other step starts
+  // out without a node and gets one only while it is loaded.
+  xmlDoc * document = readStep( path, session, 0 );
+  session.document = new impl::XmlDocumentManager( document );
+  session.nodes = new impl::SharedNodeVector;
+  for ( std::size_t i = 0; i < session.steps.size(); i++ ) {
+    session.nodes->push_back( NULL );
+  }
+  (*session.nodes)[0] = stepGrid( document );
+
+  impl::TreeBuilder build( session.document, session.nodes );
+  xdm::RefPtr< xdm::Item > result = build.buildTree();
+
+  mImp->mSessions[path] = session;
+  return xdmFormat::ReadResult( result, session.steps.size() );
+}
+
+bool StreamingXmfReader::update(
+  xdm::RefPtr< xdm::Item > item,
+  const xdm::FileSystemPath& path,
+  std::size_t timeStep )
+{
+  Private::SessionMap::iterator it = mImp->mSessions.find( path );
+  if ( it == mImp->mSessions.end() ) {
+    return false;
+  }
+  Session& session = it->second;
+  if ( timeStep >= session.steps.size() ) {
+    return false;
+  }
+
+  try {
+    if ( timeStep != session.currentStep ) {
+      // Swap the requested step into the shared document so that the items
+      // built from the first step find their nodes in it.
+      xmlDoc * document = readStep( path, session, timeStep );
+      session.document->reset( document );
+      (*session.nodes)[session.currentStep] = NULL;
+      (*session.nodes)[timeStep] = stepGrid( document );
+      session.currentStep = timeStep;
+    }
+    xdm::UpdateVisitor update( timeStep );
+    item->accept( update );
+    return true;
+  } catch ( const xdmFormat::ReadError& ) {
+    return false;
+  }
+}
+
+} // namespace xdmf
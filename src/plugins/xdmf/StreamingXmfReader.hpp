@@ -0,0 +1,62 @@
+//==============================================================================
+// This software developed by Stellar Science Ltd Co and the U.S. Government.
+// Copyright (C) 2009 Stellar Science. Government-purpose rights granted.
+//
+// This file is part of XDM
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//------------------------------------------------------------------------------
+#ifndef xdmf_StreamingXmfReader_hpp
+#define xdmf_StreamingXmfReader_hpp
+
+#include <xdmFormat/Reader.hpp>
+
+#include <memory>
+
+namespace xdmf {
+
+/// Reader for XDMF files that holds only a single time step in memory. On the
+/// first read of a file, the document is streamed through a SAX parser once to
+/// record the byte range of each time step Grid in the temporal collection.
+/// Only the Grid for the requested step is then parsed into a tree, so memory
+/// use is bounded by the size of one step rather than the length of the run.
+///
+/// Because steps are loaded on demand, items read by this reader must be
+/// moved to a new time step using the reader's update function rather than by
+/// applying an UpdateVisitor directly. Documents are checked for
+/// well-formedness but are not validated against the XDMF schema.
+class StreamingXmfReader : public xdmFormat::Reader {
+public:
+  StreamingXmfReader();
+  virtual ~StreamingXmfReader();
+
+  virtual xdmFormat::ReadResult readItem(
+    const xdm::FileSystemPath& path );
+
+  virtual bool update(
+    xdm::RefPtr< xdm::Item > item,
+    const xdm::FileSystemPath& path,
+    std::size_t timeStep = 0 );
+
+private:
+  // This class uses a private implementation to keep LibXml2 out of the
+  // header.
+  class Private;
+  std::auto_ptr< Private > mImp;
+};
+
+} // namespace xdmf
+
+#endif // xdmf_StreamingXmfReader_hpp
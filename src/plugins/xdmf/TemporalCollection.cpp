@@ -23,7 +23,9 @@
 #include <xdmf/XdmfHelpers.hpp>
 
 #include <xdm/CollectMetadataOperation.hpp>
+#include <xdm/FileSystem.hpp>
 #include <xdm/SerializeDataOperation.hpp>
+#include <xdm/ThrowMacro.hpp>
 #include <xdm/ReferencedObject.hpp>
 #include <xdm/RefPtr.hpp>
 #include <xdm/UpdateVisitor.hpp>
@@ -32,6 +34,12 @@
 #include <xdmGrid/Domain.hpp>
 #include <xdmGrid/CollectionGrid.hpp>
 
+#include <xdmFormat/IoExcept.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
 namespace xdmf {
 
 namespace {
@@ -51,6 +59,19 @@ xdm::RefPtr< xdm::XmlObject > openTemporalCollection()
   return xdmf;
 }
 
+// The side index is text with fixed width fields so that it can be updated in
+// place and read easily by other tools. A header line holding the step count,
+// the trailer offset and the capacity is followed by one line per slot, with
+// the offset of step i kept in slot i modulo the capacity.
+char const * const kIndexMagic = "XDMFIDX1";
+const int kIndexFieldWidth = 20;
+const std::streamoff kIndexHeaderSize = 9 + 3 * ( kIndexFieldWidth + 1 );
+const std::streamoff kIndexRecordSize = kIndexFieldWidth + 1;
+
+void writeIndexField( std::ostream& out, std::streamoff value, char end ) {
+  out << std::setw( kIndexFieldWidth ) << std::setfill( '0' ) << value << end;
+}
+
 } // namespace
 
 TemporalCollection::TemporalCollection( 
@@ -59,20 +80,68 @@ TemporalCollection::TemporalCollection(
   TimeSeries( mode ),
   mFilename( metadataFile ),
   mFileStream(),
-  mXmlStream( mFileStream )
+  mXmlStream( mFileStream ),
+  mTrailerPolicy( kTrailerOnClose ),
+  mIndexCapacity( 1024 ),
+  mIndexStream(),
+  mTrailerOffset( 0 ),
+  mStepCount( 0 )
 {
 }
 
 TemporalCollection::~TemporalCollection()
 {
+  // Contexts still open are closed when the XML stream is destroyed, so make
+  // sure their footers replace the trailer rather than following it.
+  if ( mTrailerPolicy == kTrailerEveryStep && mFileStream.is_open() ) {
+    mFileStream.seekp( mTrailerOffset );
+  }
+}
+
+void TemporalCollection::setTrailerPolicy(
+  TrailerPolicy policy,
+  std::size_t indexCapacity )
+{
+  mTrailerPolicy = policy;
+  mIndexCapacity = std::max( indexCapacity, std::size_t( 1 ) );
+}
+
+TemporalCollection::TrailerPolicy TemporalCollection::trailerPolicy() const
+{
+  return mTrailerPolicy;
+}
+
+std::size_t TemporalCollection::stepCount() const
+{
+  return mStepCount;
+}
+
+std::string TemporalCollection::indexFilename( const std::string& metadataFile )
+{
+  return metadataFile + ".idx";
 }
 
 void TemporalCollection::open() 
 {
+  mStepCount = 0;
+  if ( mTrailerPolicy == kTrailerEveryStep
+    && mode() == xdm::Dataset::kModify
+    && resume() ) {
+    return;
+  }
+
   mFileStream.open( mFilename.c_str(), std::ios::out );
   mFileStream << "<?xml version='1.0'?>\n";
   xdm::RefPtr< xdm::XmlObject > xdmf = openTemporalCollection();
   mXmlStream.openContext( xdmf );
+
+  if ( mTrailerPolicy == kTrailerEveryStep ) {
+    mIndexStream.open( indexFilename( mFilename ).c_str(),
+      std::ios::in | std::ios::out | std::ios::trunc );
+    mTrailerOffset = mFileStream.tellp();
+    writeTrailer();
+    writeIndex( 0 );
+  }
 }
 
 void TemporalCollection::updateGrid( xdm::RefPtr< xdmGrid::Grid > grid, std::size_t step ) {
@@ -86,7 +155,21 @@ void TemporalCollection::writeGridMetadata( xdm::RefPtr< xdmGrid::Grid > grid )
   xdm::CollectMetadataOperation collect;
   grid->accept( collect );
   xdm::RefPtr< xdm::XmlObject > xml( collect.result() );
-  mXmlStream.writeObject( xml );
+
+  if ( mTrailerPolicy == kTrailerEveryStep ) {
+    // Write the step over the trailer and follow it with a new one. The file
+    // only grows, so no bytes of the old trailer are left behind.
+    std::streamoff stepOffset = mTrailerOffset;
+    mFileStream.seekp( mTrailerOffset );
+    mXmlStream.writeObject( xml );
+    mTrailerOffset = mFileStream.tellp();
+    writeTrailer();
+    ++mStepCount;
+    writeIndex( stepOffset );
+  } else {
+    mXmlStream.writeObject( xml );
+    ++mStepCount;
+  }
 }
 
 void TemporalCollection::writeGridData( xdm::RefPtr< xdmGrid::Grid > grid ) {
@@ -97,8 +180,125 @@ void TemporalCollection::writeGridData( xdm::RefPtr< xdmGrid::Grid > grid ) {
 
 void TemporalCollection::close()
 {
+  if ( mTrailerPolicy == kTrailerEveryStep ) {
+    mFileStream.seekp( mTrailerOffset );
+  }
   mXmlStream.closeStream();
+  mFileStream.flush();
+  if ( mIndexStream.is_open() ) {
+    mIndexStream.close();
+  }
 }
 
-} // namespace xdmf
+bool TemporalCollection::resume()
+{
+  // Read the index header. Without a usable index the file is rewritten.
+  std::ifstream index( indexFilename( mFilename ).c_str() );
+  std::string magic;
+  std::streamoff stepCount = 0;
+  std::streamoff trailerOffset = 0;
+  std::streamoff capacity = 0;
+  index >> magic >> stepCount >> trailerOffset >> capacity;
+  if ( !index || magic != kIndexMagic || capacity <= 0 ) {
+    return false;
+  }
+  index.close();
+
+  mFileStream.open( mFilename.c_str(), std::ios::in | std::ios::out );
+  if ( !mFileStream ) {
+    mFileStream.clear();
+    return false;
+  }
+
+  // The footers only depend on the collection's structure, so they can be
+  // built before the stream's context is restored. The scratch stream takes
+  // the XML declaration that the output stream writes when it is created.
+  std::ostringstream scratch;
+  std::ostringstream footerStream;
+  xdm::XmlOutputStream footerXml( scratch );
+  footerXml.restoreContext( openTemporalCollection() );
+  footerXml.writeContextFooters( footerStream );
+  const std::string footer = footerStream.str();
+  const std::streamoff footerSize = footer.size();
+
+  mFileStream.seekg( 0, std::ios::end );
+  const std::streamoff fileSize = mFileStream.tellg();
+  if ( trailerOffset + footerSize > fileSize ) {
+    // The index does not describe this file.
+    mFileStream.close();
+    return false;
+  }
 
+  // The index is written after the step and its trailer, so a crash can leave
+  // it pointing at an earlier trailer. When the file still ends in a complete
+  // trailer past that point the step was finished and is kept. Otherwise the
+  // bytes after the indexed trailer are from a step that was not completed.
+  std::streamoff unindexedStep = -1;
+  if ( !hasFooterAt( trailerOffset, footer ) 
+    && fileSize - footerSize > trailerOffset 
+    && hasFooterAt( fileSize - footerSize, footer ) ) {
+    unindexedStep = trailerOffset;
+    trailerOffset = fileSize - footerSize;
+    ++stepCount;
+  }
+
+  mIndexStream.open( indexFilename( mFilename ).c_str(),
+    std::ios::in | std::ios::out );
+  mTrailerOffset = trailerOffset;
+  mStepCount = stepCount;
+  mIndexCapacity = capacity;
+  mXmlStream.restoreContext( openTemporalCollection() );
+
+  // Drop anything after the trailer so that a shorter step cannot leave stale
+  // bytes at the end of the file, then rewrite the trailer in case it was
+  // overwritten by a step that was not completed.
+  mFileStream.flush();
+  if ( !xdm::resize( xdm::FileSystemPath( mFilename ), 
+      mTrailerOffset + footerSize ) ) {
+    XDM_THROW( xdmFormat::WriteError(
+      "Unable to resume XDMF temporal collection." ) );
+  }
+  mFileStream.seekp( mTrailerOffset );
+  writeTrailer();
+  if ( unindexedStep >= 0 ) {
+    writeIndex( unindexedStep );
+  }
+  return true;
+}
+
+bool TemporalCollection::hasFooterAt( 
+  std::streamoff offset, 
+  const std::string& footer )
+{
+  std::string bytes( footer.size(), '\0' );
+  mFileStream.seekg( offset );
+  mFileStream.read( &bytes[0], bytes.size() );
+  const bool matches = mFileStream && bytes == footer;
+  mFileStream.clear();
+  return matches;
+}
+
+void TemporalCollection::writeTrailer()
+{
+  mXmlStream.writeContextFooters( mFileStream );
+  mFileStream.flush();
+}
+
+void TemporalCollection::writeIndex( std::streamoff stepOffset )
+{
+  // Record the step before updating the header so that the header never
+  // refers to a step that is not in the index.
+  if ( mStepCount > 0 ) {
+    mIndexStream.seekp( kIndexHeaderSize
+      + ( ( mStepCount - 1 ) % mIndexCapacity ) * kIndexRecordSize );
+    writeIndexField( mIndexStream, stepOffset, '\n' );
+  }
+  mIndexStream.seekp( 0 );
+  mIndexStream << kIndexMagic << ' ';
+  writeIndexField( mIndexStream, mStepCount, ' ' );
+  writeIndexField( mIndexStream, mTrailerOffset, ' ' );
+  writeIndexField( mIndexStream, mIndexCapacity, '\n' );
+  mIndexStream.flush();
+}
+
+} // namespace xdmf
@@ -36,12 +36,41 @@ namespace xdmf {
 /// single XDMF file.
 class TemporalCollection : public TimeSeries {
 public:
+  /// Policy for keeping the metadata file a complete document while steps are
+  /// being written.
+  enum TrailerPolicy {
+    /// The closing tags are written only when the collection is closed. This
+    /// is the default.
+    kTrailerOnClose,
+    /// The closing tags are written after every step and overwritten in place
+    /// by the next step, so the file is a valid document whenever a step is
+    /// complete. A side index records the position of the trailer and of the
+    /// most recent steps, which lets a collection opened in modify mode
+    /// append to the existing file without rewriting it.
+    kTrailerEveryStep
+  };
+
   /// Construct a temporal collection with  
   TemporalCollection( 
     const std::string& metadataFile,
     xdm::Dataset::InitializeMode mode );
   virtual ~TemporalCollection();
 
+  /// Set the trailer policy. This must be set before the collection is
+  /// opened. The index capacity is the number of step offsets kept in the
+  /// side index, which bounds its size on disk.
+  void setTrailerPolicy(
+    TrailerPolicy policy,
+    std::size_t indexCapacity = 1024 );
+  TrailerPolicy trailerPolicy() const;
+
+  /// Get the number of steps in the collection, including those that were
+  /// already in the file when it was resumed.
+  std::size_t stepCount() const;
+
+  /// Get the name of the side index file for a metadata file.
+  static std::string indexFilename( const std::string& metadataFile );
+
   virtual void open();
   virtual void updateGrid( xdm::RefPtr< xdmGrid::Grid > grid, std::size_t step );
   virtual void writeGridMetadata( xdm::RefPtr< xdmGrid::Grid > grid );
@@ -49,9 +78,19 @@ public:
   virtual void close();
 
 private:
+  bool resume();
+  bool hasFooterAt( std::streamoff offset, const std::string& footer );
+  void writeTrailer();
+  void writeIndex( std::streamoff stepOffset );
+
   std::string mFilename;
   std::fstream mFileStream;
   xdm::XmlOutputStream mXmlStream;
+  TrailerPolicy mTrailerPolicy;
+  std::size_t mIndexCapacity;
+  std::fstream mIndexStream;
+  std::streamoff mTrailerOffset;
+  std::size_t mStepCount;
 };
 
 } // namespace xdmf
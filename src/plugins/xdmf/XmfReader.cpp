@@ -11,6 +11,7 @@
 // This file is generated by the build.
 #include <XdmfRng.hpp>
 
+#include <xdm/FileSystem.hpp>
 #include <xdm/Item.hpp>
 #include <xdm/ItemVisitor.hpp>
 #include <xdm/RefPtr.hpp>
@@ -22,9 +23,11 @@
 #include <libxml/relaxng.h>
 #include <libxml/tree.h>
 
+#include <map>
 #include <sstream>
 
 #include <cstdarg>
+#include <ctime>
 
 namespace xdmf {
 
@@ -43,58 +46,83 @@ void structuredValidationErrorCallback( void* userData, xmlErrorPtr error ) {
   XDM_THROW( exception );
 }
 
-// Validate an XDMF document.
-bool validate( xmlDocPtr document ) {
-  xmlRelaxNGParserCtxtPtr context;
-  xmlRelaxNGPtr schemaDoc;
-  xmlRelaxNGValidCtxtPtr validation;
-  bool result = false;
-  try {
-    context = xmlRelaxNGNewMemParserCtxt( 
-      kXdmfRngSchema, 
+// Owns the compiled XDMF schema. The schema is parsed from the embedded RNG
+// text the first time it is needed and shared by all validations for the life
+// of the process.
+class SchemaHolder {
+public:
+  SchemaHolder() : mSchema( NULL ) {
+    xmlRelaxNGParserCtxtPtr context = xmlRelaxNGNewMemParserCtxt(
+      kXdmfRngSchema,
       kXdmfRngSchemaLength );
-    if (!context) {
-      throw xdmFormat::ReadError( "Error: unable to parse schema." );
-    }
-          
-    schemaDoc = xmlRelaxNGParse( context );
-    if (!schemaDoc) {
-      throw xdmFormat::ReadError( "Error: unable to parse schema." );
+    if ( context ) {
+      mSchema = xmlRelaxNGParse( context );
+      xmlRelaxNGFreeParserCtxt( context );
     }
+  }
+  ~SchemaHolder() {
+    if ( mSchema ) xmlRelaxNGFree( mSchema );
+  }
+  xmlRelaxNGPtr get() const { return mSchema; }
+private:
+  xmlRelaxNGPtr mSchema;
+};
 
-    validation = xmlRelaxNGNewValidCtxt( schemaDoc );
-    if (!validation) {
-      throw xdmFormat::ReadError( "Error: unable to parse schema." );
-    }
+xmlRelaxNGPtr xdmfSchema() {
+  static SchemaHolder sSchema;
+  if ( !sSchema.get() ) {
+    XDM_THROW( xdmFormat::ReadError( "Error: unable to parse schema." ) );
+  }
+  return sSchema.get();
+}
 
-    // Set the validation error callback function to handle invalid documents
-    xmlRelaxNGSetValidStructuredErrors(
-      validation,
-      &structuredValidationErrorCallback,
-      0 );
-
-    int validationResult = xmlRelaxNGValidateDoc( validation, document );
-    if ( validationResult == 0 ) {
-      result = true;
-    } else if ( validationResult > 0 ) {
-      result = false;
-    } else {
-      throw xdmFormat::ReadError( "Error: Internal validation error." );
-    }
+// Validate an XDMF document.
+bool validate( xmlDocPtr document ) {
+  xmlRelaxNGValidCtxtPtr validation = xmlRelaxNGNewValidCtxt( xdmfSchema() );
+  if (!validation) {
+    XDM_THROW( xdmFormat::ReadError( "Error: unable to parse schema." ) );
+  }
+
+  // Set the validation error callback function to handle invalid documents
+  xmlRelaxNGSetValidStructuredErrors(
+    validation,
+    &structuredValidationErrorCallback,
+    0 );
+
+  int validationResult;
+  try {
+    validationResult = xmlRelaxNGValidateDoc( validation, document );
   } catch ( ... ) {
-    if (context) xmlRelaxNGFreeParserCtxt(context);
-    if (schemaDoc) xmlRelaxNGFree(schemaDoc);
-    if (validation) xmlRelaxNGFreeValidCtxt(validation);
+    xmlRelaxNGFreeValidCtxt( validation );
     throw;
   }
-  if (context) xmlRelaxNGFreeParserCtxt(context);
-  if (schemaDoc) xmlRelaxNGFree(schemaDoc);
-  if (validation) xmlRelaxNGFreeValidCtxt(validation);
-  return result;
+  xmlRelaxNGFreeValidCtxt( validation );
+
+  if ( validationResult < 0 ) {
+    XDM_THROW( xdmFormat::ReadError( "Error: Internal validation error." ) );
+  }
+  return ( validationResult == 0 );
 }
 
-// Read an XML document at the specified path.
-xmlDoc * readDocument( const xdm::FileSystemPath& path ) {
+// Modification time and size of a file when it was last validated.
+typedef std::pair< std::time_t, size_t > FileStamp;
+typedef std::map< xdm::FileSystemPath, FileStamp > ValidatedFileMap;
+
+// Files that have passed validation in this process. Shared between readers
+// so that reopening an unchanged file does not validate it again.
+ValidatedFileMap& validatedFiles() {
+  static ValidatedFileMap sValidatedFiles;
+  return sValidatedFiles;
+}
+
+FileStamp fileStamp( const xdm::FileSystemPath& path ) {
+  return FileStamp( xdm::lastWriteTime( path ), xdm::size( path ) );
+}
+
+xmlDoc * readDocument(
+  const xdm::FileSystemPath& path,
+  XmfReader::ValidationPolicy policy )
+{
   // Check the file exists.
   if ( !exists( path ) ) {
     XDM_THROW( xdmFormat::ReadError( "Requested path does not exist." ) );
@@ -107,8 +135,40 @@ xmlDoc * readDocument( const xdm::FileSystemPath& path ) {
     XDM_THROW( xdmFormat::ReadError( "Unable to parse XDMF document." ) );
   }
 
-  if ( !validate( document ) ) {
-    XDM_THROW( xdmFormat::ReadError( "Invalid XDMF document." ) );
+  // Decide if the document needs to be validated under the policy.
+  bool needsValidation = true;
+  FileStamp stamp;
+  switch ( policy ) {
+  case XmfReader::kValidateNever:
+    needsValidation = false;
+    break;
+  case XmfReader::kValidateOncePerFile:
+    {
+      stamp = fileStamp( path );
+      ValidatedFileMap::const_iterator it = validatedFiles().find( path );
+      needsValidation = ( it == validatedFiles().end() || it->second != stamp );
+    }
+    break;
+  case XmfReader::kValidateAlways:
+  default:
+    break;
+  }
+
+  if ( needsValidation ) {
+    bool valid;
+    try {
+      valid = validate( document );
+    } catch ( ... ) {
+      xmlFreeDoc( document );
+      throw;
+    }
+    if ( !valid ) {
+      xmlFreeDoc( document );
+      XDM_THROW( xdmFormat::ReadError( "Invalid XDMF document." ) );
+    }
+    if ( policy == XmfReader::kValidateOncePerFile ) {
+      validatedFiles()[path] = stamp;
+    }
   }
   return document;
 }
@@ -120,6 +180,8 @@ xmlDoc * readDocument( const xdm::FileSystemPath& path ) {
 // -----------------------------------------------------------------------------
 class XmfReader::Private {
 public:
+  Private() : mValidationPolicy( XmfReader::kValidateAlways ) {}
+  XmfReader::ValidationPolicy mValidationPolicy;
 };
 
 XmfReader::XmfReader() : 
@@ -130,6 +192,14 @@ XmfReader::XmfReader() :
 XmfReader::~XmfReader() {
 }
 
+void XmfReader::setValidationPolicy( ValidationPolicy policy ) {
+  mImp->mValidationPolicy = policy;
+}
+
+XmfReader::ValidationPolicy XmfReader::validationPolicy() const {
+  return mImp->mValidationPolicy;
+}
+
 xdmFormat::ReadResult XmfReader::readItem( const xdm::FileSystemPath& path ) {
   static const char * kTemporalCollectionExpr =
     "/Xdmf/Domain/Grid["
@@ -140,7 +210,8 @@ xdmFormat::ReadResult XmfReader::readItem( const xdm::FileSystemPath& path ) {
 
   // Read the document.
   xdm::RefPtr< impl::XmlDocumentManager > doc(
-    new impl::XmlDocumentManager( readDocument( path ) ) );
+    new impl::XmlDocumentManager(
+      readDocument( path, mImp->mValidationPolicy ) ) );
   xmlNode * rootNode = xmlDocGetRootElement( doc->get() );
 
   // Determine if the XDMF document contains a single time step or a temporal
@@ -32,9 +32,28 @@ namespace xdmf {
 
 class XmfReader : public xdmFormat::Reader {
 public:
+  /// Policy for validating documents against the XDMF schema when they are
+  /// read. The compiled schema is shared by the whole process regardless of
+  /// the policy.
+  enum ValidationPolicy {
+    /// Validate every document that is read. This is the default.
+    kValidateAlways,
+    /// Validate a file the first time it is read, and again only if its
+    /// modification time or size has changed since.
+    kValidateOncePerFile,
+    /// Do not validate documents.
+    kValidateNever
+  };
+
   XmfReader();
   virtual ~XmfReader();
 
+  /// Set the policy for validating documents read by this reader. The policy
+  /// applies to subsequent calls to readItem().
+  void setValidationPolicy( ValidationPolicy policy );
+  /// Get the policy for validating documents read by this reader.
+  ValidationPolicy validationPolicy() const;
+
   virtual xdmFormat::ReadResult readItem(
     const xdm::FileSystemPath& path );
 
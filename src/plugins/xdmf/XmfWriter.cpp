@@ -39,6 +39,8 @@ namespace xdmf {
 XmfWriter::XmfWriter() :
   xdmFormat::Writer(),
   mSeries(),
+  mTrailerPolicy( TemporalCollection::kTrailerOnClose ),
+  mIndexCapacity( 1024 ),
   mIsOpen( false ) {
 }
 
@@ -52,7 +54,10 @@ void XmfWriter::open(
   const xdm::FileSystemPath& path,
   xdm::Dataset::InitializeMode mode ) {
   mCurrentFilePath = path;
-  mSeries = new TemporalCollection( path.pathString(), mode );
+  xdm::RefPtr< TemporalCollection > series(
+    new TemporalCollection( path.pathString(), mode ) );
+  series->setTrailerPolicy( mTrailerPolicy, mIndexCapacity );
+  mSeries = series;
   mSeries->open();
   mIsOpen = true;
 }
@@ -79,6 +84,13 @@ void XmfWriter::write( xdm::RefPtr< xdm::Item > item, std::size_t seriesIndex )
   mSeries->writeGridData( grid );
 }
 
+void XmfWriter::setTrailerPolicy(
+  TemporalCollection::TrailerPolicy policy,
+  std::size_t indexCapacity ) {
+  mTrailerPolicy = policy;
+  mIndexCapacity = indexCapacity;
+}
+
 void XmfWriter::close() {
   mIsOpen = false;
   mSeries->close();
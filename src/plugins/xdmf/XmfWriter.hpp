@@ -21,6 +21,7 @@
 #ifndef xdmf_XmfWriter_hpp
 #define xdmf_XmfWriter_hpp
 
+#include <xdmf/TemporalCollection.hpp>
 #include <xdmf/TimeSeries.hpp>
 
 #include <xdmFormat/Writer.hpp>
@@ -43,8 +44,16 @@ public:
   virtual void write( xdm::RefPtr< xdm::Item > item, std::size_t seriesIndex );
   virtual void close();
 
+  /// Set the trailer policy for the temporal collections opened by this
+  /// writer. The policy takes effect at the next call to open.
+  void setTrailerPolicy(
+    TemporalCollection::TrailerPolicy policy,
+    std::size_t indexCapacity = 1024 );
+
 private:
   xdm::RefPtr< TimeSeries > mSeries;
+  TemporalCollection::TrailerPolicy mTrailerPolicy;
+  std::size_t mIndexCapacity;
   bool mIsOpen;
   xdm::FileSystemPath mCurrentFilePath;
 };
@@ -22,11 +22,14 @@
 
 #include <xdmf/impl/TreeBuilder.hpp>
 #include <xdmf/impl/XmlDocumentManager.hpp>
+#include <xdmf/impl/XPathQuery.hpp>
 
 #include <xdmFormat/IoExcept.hpp>
 
 #include <xdm/ThrowMacro.hpp>
 
+#include <sstream>
+
 namespace xdmf {
 namespace impl {
 
@@ -44,10 +47,17 @@ Input::~Input() {
 
 xmlNode * Input::findNode( std::size_t index ) {
   xmlNode * gridNode = nodes()->at( index );
-  xmlDoc * doc = document()->get();
+  xdm::RefPtr< XmlDocumentManager > doc = document();
+
+  // Look the node up in the document's index of the grid first. Expressions
+  // that were not generated from a node path fall back to an XPath query.
+  xmlNode * result = doc->findNode( gridNode, xpathExpr() );
+  if ( result ) {
+    return result;
+  }
 
-  // Find the new XML node within the requested grid context.
-  XPathQuery nodeQuery( doc, gridNode, xpathExpr() );
+  XPathQuery nodeQuery(
+    doc->get(), gridNode, doc->compiledExpression( xpathExpr() ) );
   if ( nodeQuery.size() == 0 ) {
     std::ostringstream ss;
     ss << "XDMF object not found at series index " << index;
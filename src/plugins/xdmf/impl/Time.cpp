@@ -45,11 +45,13 @@ Time::~Time() {
 }
 
 void Time::read( xmlNode * node, TreeBuilder& builder ) {
-  XPathQuery typeQuery( document()->get(), node, "@TimeType" );
+  XPathQuery typeQuery( document()->get(), node,
+    document()->compiledExpression( "@TimeType" ) );
   std::string timeType = (typeQuery.size() > 0)?typeQuery.textValue(0):"Single";
 
   if ( timeType == "Single" ) {
-    XPathQuery valueQuery( document()->get(), node, "@Value" );
+    XPathQuery valueQuery( document()->get(), node,
+      document()->compiledExpression( "@Value" ) );
     if ( valueQuery.size() == 0 ) {
       XDM_THROW( xdmFormat::ReadError(
         "Single XDMF grid time specified with no Value" ) );
@@ -62,7 +64,8 @@ void Time::read( xmlNode * node, TreeBuilder& builder ) {
     }
     setValue( value );
   } else if ( timeType == "List" ) {
-    XPathQuery valuesQuery( document()->get(), node, "DataItem" );
+    XPathQuery valuesQuery( document()->get(), node,
+      document()->compiledExpression( "DataItem" ) );
     if ( valuesQuery.size() == 0 ) {
       XDM_THROW( xdmFormat::ReadError( "No values found for XDMF Time." ) );
     }
@@ -67,16 +67,26 @@ xdm::primitiveType::Value type( const std::string& typeStr, size_t precision ) {
   return xdm::primitiveType::kFloat;
 }
 
-void setContent( UniformDataItem& item, xmlDoc * document, xmlNode * node ) {
+void setContent(
+  UniformDataItem& item,
+  XmlDocumentManager& manager,
+  xmlNode * node )
+{
+  // The same handful of queries is evaluated for every item at every step, so
+  // use the document's compiled form of each.
+  xmlDoc * document = manager.get();
+
   // Get the number type from the NumberType attribute.
-  XPathQuery typeQuery( document, node, "@NumberType" );
+  XPathQuery typeQuery( document, node,
+    manager.compiledExpression( "@NumberType" ) );
   std::string typeString;
   if ( typeQuery.size() > 0 ) {
     typeString = typeQuery.textValue( 0 );
   } else {
     typeString = "Float";
   }
-  XPathQuery precisionQuery( document, node, "@Precision" );
+  XPathQuery precisionQuery( document, node,
+    manager.compiledExpression( "@Precision" ) );
   size_t precision;
   if ( precisionQuery.size() > 0 ) {
     precision = precisionQuery.getValue( 0, 4 );
@@ -87,14 +97,16 @@ void setContent( UniformDataItem& item, xmlDoc * document, xmlNode * node ) {
   item.setDataType( dataType );
 
   // Get the shape from the Dimensions attribute.
-  XPathQuery dimensionsQuery( document, node, "@Dimensions" );
+  XPathQuery dimensionsQuery( document, node,
+    manager.compiledExpression( "@Dimensions" ) );
   if ( dimensionsQuery.size() == 0 ) {
     XDM_THROW( xdmFormat::ReadError( "No dimensions for a UniformDataItem." ) );
   }
   item.setDataspace( xdm::makeShape( dimensionsQuery.textValue( 0 ) ) );
 
   // Get the format string for the dataset.
-  XPathQuery formatQuery( document, node, "@Format" );
+  XPathQuery formatQuery( document, node,
+    manager.compiledExpression( "@Format" ) );
   std::string format( "HDF" );
   if ( formatQuery.size() > 0 ) {
     format = formatQuery.textValue( 0 );
@@ -108,7 +120,8 @@ void setContent( UniformDataItem& item, xmlDoc * document, xmlNode * node ) {
     } else {
       itemDataset = new xdmHdf::HdfDataset;
     }
-    XPathQuery datasetInfoQuery( document, node, "text()" );
+    XPathQuery datasetInfoQuery( document, node,
+      manager.compiledExpression( "text()" ) );
     if ( datasetInfoQuery.size() == 0 ) {
       XDM_THROW( "No information about requested HDF dataset." );
     }
@@ -158,11 +171,11 @@ UniformDataItem::~UniformDataItem() {
 }
 
 void UniformDataItem::read( xmlNode * node, TreeBuilder& builder ) {
-  setContent( *this, document()->get(), node );
+  setContent( *this, *document(), node );
 }
 
 void UniformDataItem::updateState( std::size_t seriesIndex ) {
-  setContent( *this, document()->get(), findNode( seriesIndex ) );
+  setContent( *this, *document(), findNode( seriesIndex ) );
 }
 
 } // namespace impl
@@ -98,11 +98,23 @@ public:
     mXPathContext->node = node;
     mXPathObject = xmlXPathEvalExpression(
       (xmlChar *)query.c_str(), mXPathContext );
-    if ( mXPathObject && mXPathObject->nodesetval ) {
-      mSize = mXPathObject->nodesetval->nodeNr;
-    } else {
-      mSize = 0;
+    computeSize();
+  }
+
+  /// Constructor that evaluates a precompiled expression instead of parsing
+  /// the query string again. A NULL expression yields an empty result.
+  XPathQuery(
+    xmlDoc * document,
+    xmlNode * node,
+    xmlXPathCompExprPtr expression ) :
+    mXPathObject( NULL )
+  {
+    mXPathContext = xmlXPathNewContext( document );
+    mXPathContext->node = node;
+    if ( expression ) {
+      mXPathObject = xmlXPathCompiledEval( expression, mXPathContext );
     }
+    computeSize();
   }
 
   ~XPathQuery() {
@@ -149,8 +161,34 @@ public:
     assert( i < mSize );
     return mXPathObject->nodesetval->nodeTab[i];
   }
+
+private:
+  XPathQuery( const XPathQuery& );
+  XPathQuery& operator=( const XPathQuery& );
+
+  void computeSize() {
+    if ( mXPathObject && mXPathObject->nodesetval ) {
+      mSize = mXPathObject->nodesetval->nodeNr;
+    } else {
+      mSize = 0;
+    }
+  }
 };
 
+/// Determine the 0-based index of an element among the element children of
+/// its parent that share its name. This is the index an XPath child step on
+/// the element's name would assign to it, computed without evaluating one.
+inline size_t siblingIndex( xmlNode * node ) {
+  size_t index = 0;
+  for ( xmlNode * sibling = node->prev; sibling; sibling = sibling->prev ) {
+    if ( sibling->type == XML_ELEMENT_NODE
+      && xmlStrEqual( sibling->name, node->name ) ) {
+      index++;
+    }
+  }
+  return index;
+}
+
 /// Find a path to an ancestor (tail recursive implementation).
 inline void findPathToAncestor(
   xmlDoc * doc,
@@ -168,13 +206,7 @@ inline void findPathToAncestor(
   }
 
   // Determine which child of it's parent the descendant is
-  std::string queryString( (char *)descendant->name );
-  XPathQuery child( doc, descendant->parent, queryString );
-  size_t index = 0;
-  while( child.node(index) != descendant ) {
-    index++;
-  }
-  pushNode( descendant, index, accumulator );
+  pushNode( descendant, siblingIndex( descendant ), accumulator );
 
   // Recurse to find the parent's path.
   findPathToAncestor(
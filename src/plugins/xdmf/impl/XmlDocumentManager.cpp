@@ -0,0 +1,117 @@
+//==============================================================================
+// This software developed by Stellar Science Ltd Co and the U.S. Government.
+// Copyright (C) 2009 Stellar Science. Government-purpose rights granted.
+//
+// This file is part of XDM
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//------------------------------------------------------------------------------
+#include <xdmf/impl/XmlDocumentManager.hpp>
+
+#include <xdmf/impl/XPathQuery.hpp>
+
+#include <sstream>
+
+namespace xdmf {
+namespace impl {
+
+namespace {
+
+// Add the paths of all elements below the given node to the index. Paths are
+// built with the same element[index] form as makeXPathQuery so that stored
+// expressions can be used directly as keys.
+void indexChildren(
+  xmlNode * node,
+  const std::string& prefix,
+  std::map< std::string, xmlNode * >& index )
+{
+  // Count the elements with each name as we go so that the sibling index of
+  // every child is found in a single pass.
+  std::map< std::string, size_t > nameCounts;
+  for ( xmlNode * child = node->children; child; child = child->next ) {
+    if ( child->type != XML_ELEMENT_NODE ) {
+      continue;
+    }
+    std::string name( (const char *)child->name );
+    // Add 1 to the index since XPath predicates are 1-based.
+    std::ostringstream path;
+    path << prefix << name << '[' << ++nameCounts[name] << ']';
+    index[path.str()] = child;
+    indexChildren( child, path.str() + '/', index );
+  }
+}
+
+} // namespace
+
+XmlDocumentManager::XmlDocumentManager( xmlDoc * document ) :
+  mDocument( document ),
+  mExpressions(),
+  mIndexedGrid( NULL ),
+  mNodeIndex() {
+}
+
+XmlDocumentManager::~XmlDocumentManager() {
+  for ( ExpressionMap::iterator it = mExpressions.begin();
+    it != mExpressions.end(); ++it ) {
+    xmlXPathFreeCompExpr( it->second );
+  }
+  xmlFreeDoc( mDocument );
+}
+
+void XmlDocumentManager::reset( xmlDoc * document ) {
+  if ( document == mDocument ) {
+    return;
+  }
+  mIndexedGrid = NULL;
+  mNodeIndex.clear();
+  xmlFreeDoc( mDocument );
+  mDocument = document;
+}
+
+xmlXPathCompExprPtr XmlDocumentManager::compiledExpression(
+  const std::string& expression )
+{
+  ExpressionMap::iterator it = mExpressions.find( expression );
+  if ( it != mExpressions.end() ) {
+    return it->second;
+  }
+  xmlXPathCompExprPtr result = xmlXPathCompile(
+    (const xmlChar *)expression.c_str() );
+  mExpressions.insert( std::make_pair( expression, result ) );
+  return result;
+}
+
+xmlNode * XmlDocumentManager::findNode(
+  xmlNode * grid,
+  const std::string& path )
+{
+  if ( path.empty() ) {
+    return grid;
+  }
+  if ( grid != mIndexedGrid ) {
+    indexGrid( grid );
+  }
+  NodeIndex::const_iterator it = mNodeIndex.find( path );
+  return ( it != mNodeIndex.end() ) ? it->second : NULL;
+}
+
+void XmlDocumentManager::indexGrid( xmlNode * grid ) {
+  mNodeIndex.clear();
+  indexChildren( grid, std::string(), mNodeIndex );
+  mIndexedGrid = grid;
+}
+
+} // namespace impl
+} // namespace xdmf
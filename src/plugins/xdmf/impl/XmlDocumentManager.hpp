@@ -25,7 +25,10 @@
 #include <xdm/RefPtr.hpp>
 
 #include <libxml/tree.h>
+#include <libxml/xpath.h>
 
+#include <map>
+#include <string>
 #include <vector>
 
 namespace xdmf {
@@ -48,17 +51,47 @@ public:
 };
 
 /// A reference counted RAII class for an XML document.
+/// Owns a parsed XML document along with the lookup structures built from it.
+/// Compiled XPath expressions are cached by their text so that repeated
+/// queries do not reparse the expression, and the relative paths of all
+/// elements below a time step grid are indexed so that locating an item in a
+/// new step does not require an XPath evaluation.
 class XmlDocumentManager : public xdm::ReferencedObject {
 public:
-  XmlDocumentManager( xmlDoc * document ) : mDocument( document ) {}
-  virtual ~XmlDocumentManager() {
-    xmlFreeDoc( mDocument );
-  }
+  XmlDocumentManager( xmlDoc * document );
+  virtual ~XmlDocumentManager();
 
   xmlDoc * get() { return mDocument; }
 
+  /// Replace the managed document with another, freeing the current one. Any
+  /// node index built from the old document is discarded.
+  void reset( xmlDoc * document );
+
+  /// Get the compiled form of an XPath expression, compiling it the first time
+  /// it is requested. Returns NULL if the expression is invalid. The result is
+  /// owned by the manager.
+  xmlXPathCompExprPtr compiledExpression( const std::string& expression );
+
+  /// Find the element at a path of the form generated by makeXPathQuery
+  /// relative to a grid node. The first lookup for a grid indexes every
+  /// element beneath it, after which lookups within that grid do not touch the
+  /// tree. Only the most recently used grid is indexed to keep memory bounded
+  /// by the size of one step. Returns NULL if there is no element at the path.
+  xmlNode * findNode( xmlNode * grid, const std::string& path );
+
 private:
+  XmlDocumentManager( const XmlDocumentManager& );
+  XmlDocumentManager& operator=( const XmlDocumentManager& );
+
+  void indexGrid( xmlNode * grid );
+
+  typedef std::map< std::string, xmlXPathCompExprPtr > ExpressionMap;
+  typedef std::map< std::string, xmlNode * > NodeIndex;
+
   xmlDoc * mDocument;
+  ExpressionMap mExpressions;
+  xmlNode * mIndexedGrid;
+  NodeIndex mNodeIndex;
 };
 
 } // namespace impl
@@ -46,6 +46,8 @@
 #include <libxml/parser.h>
 #include <libxml/tree.h>
 
+#include <algorithm>
+
 namespace {
 
 using xdm::RefPtr;
@@ -125,6 +127,68 @@ BOOST_AUTO_TEST_CASE( findPathToAncestorTest ) {
   xmlFreeDoc( document );
 }
 
+BOOST_AUTO_TEST_CASE( documentNodeIndex ) {
+  char const * const kXml =
+    "<collection>"
+    "  <grid>"
+    "    <geometry>"
+    "      <dataitem/>"
+    "      <dataitem/>"
+    "    </geometry>"
+    "    <attribute name='jim'>"
+    "      <dataitem/>"
+    "    </attribute>"
+    "  </grid>"
+    "  <grid>"
+    "    <geometry>"
+    "      <dataitem/>"
+    "      <dataitem/>"
+    "    </geometry>"
+    "    <attribute name='jim'>"
+    "      <dataitem/>"
+    "    </attribute>"
+    "  </grid>"
+    "</collection>";
+  const char * paths[] = {
+    "geometry[1]",
+    "geometry[1]/dataitem[1]",
+    "geometry[1]/dataitem[2]",
+    "attribute[1]/dataitem[1]"
+  };
+
+  RefPtr< XmlDocumentManager > document = loadXml( kXml );
+  xmlNode * root = xmlDocGetRootElement( document->get() );
+  xdmf::impl::XPathQuery gridQuery( document->get(), root,
+    document->compiledExpression( "grid" ) );
+  BOOST_REQUIRE_EQUAL( gridQuery.size(), 2 );
+
+  // Compiled expressions are cached by their text.
+  BOOST_CHECK( document->compiledExpression( "grid" ) );
+  BOOST_CHECK_EQUAL( document->compiledExpression( "grid" ),
+    document->compiledExpression( "grid" ) );
+  BOOST_CHECK( !document->compiledExpression( "grid[" ) );
+
+  // Alternate between the grids to make sure the index follows the step.
+  for ( int pass = 0; pass < 2; pass++ ) {
+    for ( size_t grid = 0; grid < gridQuery.size(); grid++ ) {
+      xmlNode * gridNode = gridQuery.node( grid );
+      BOOST_CHECK_EQUAL( document->findNode( gridNode, "" ), gridNode );
+      for ( int i = 0; i < 4; i++ ) {
+        xdmf::impl::XPathQuery expected( document->get(), gridNode, paths[i] );
+        BOOST_REQUIRE_EQUAL( expected.size(), 1 );
+        BOOST_CHECK_EQUAL( document->findNode( gridNode, paths[i] ),
+          expected.node( 0 ) );
+        // The generated path for the node must round trip through the index.
+        xdmf::impl::NodePath path = xdmf::impl::findPathToAncestor(
+          document->get(), expected.node( 0 ), gridNode );
+        std::reverse( path.begin(), path.end() );
+        BOOST_CHECK_EQUAL( xdmf::impl::makeXPathQuery( path ), paths[i] );
+      }
+      BOOST_CHECK( !document->findNode( gridNode, "geometry[1]/dataitem[3]" ) );
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE( buildUniformDataItem ) {
   char const * const kXml =
   "<DataItem Name='test' "
@@ -21,6 +21,8 @@
 #define BOOST_TEST_MODULE XmfReader 
 #include <boost/test/unit_test.hpp>
 
+#include <xdmf/StreamingXmfReader.hpp>
+#include <xdmf/TemporalCollection.hpp>
 #include <xdmf/XmfReader.hpp>
 #include <xdmf/XmfWriter.hpp>
 
@@ -40,6 +42,7 @@
 
 #include <algorithm>
 #include <fstream>
+#include <iterator>
 
 #include <cmath>
 
@@ -169,6 +172,37 @@ BOOST_AUTO_TEST_CASE( invalidDocument ) {
     xdmFormat::FileReadError );
 }
 
+BOOST_AUTO_TEST_CASE( validationPolicy ) {
+  const char * kInvalidXml = "<Xdmf Version='2.1'><foo/></Xdmf>";
+  const char * kTestFileName = "validationPolicyFile.xmf";
+
+  // Start from a copy of a valid document.
+  {
+    std::ifstream source( "test_document1.xmf" );
+    std::ofstream testfile( kTestFileName );
+    testfile << source.rdbuf();
+  }
+
+  xdmf::XmfReader reader;
+  BOOST_CHECK_EQUAL( reader.validationPolicy(), xdmf::XmfReader::kValidateAlways );
+
+  reader.setValidationPolicy( xdmf::XmfReader::kValidateOncePerFile );
+  BOOST_CHECK( reader.readItem( xdm::FileSystemPath( kTestFileName ) ).item() );
+  BOOST_CHECK( reader.readItem( xdm::FileSystemPath( kTestFileName ) ).item() );
+
+  // Changing the file must cause it to be validated again.
+  {
+    std::ofstream testfile( kTestFileName );
+    testfile << kInvalidXml;
+  }
+  BOOST_CHECK_THROW( reader.readItem( xdm::FileSystemPath( kTestFileName ) ),
+    xdmFormat::FileReadError );
+
+  // Skipping validation still reads valid documents.
+  reader.setValidationPolicy( xdmf::XmfReader::kValidateNever );
+  BOOST_CHECK( reader.readItem( xdm::FileSystemPath( "test_document1.xmf" ) ).item() );
+}
+
 BOOST_AUTO_TEST_CASE( grid2DRoundtrip ) {
   const xdm::FileSystemPath testFilePath( "grid2DRoundtrip.xmf" );
   const xdm::FileSystemPath testHdfFilePath( "grid2DRoundtrip.xmf.h5" );
@@ -265,6 +299,198 @@ BOOST_AUTO_TEST_CASE( temporalCollectionRoundtrip ) {
   BOOST_CHECK_EQUAL( data->atLocation< double >( 2, 5 ), 2.0 );
 }
 
+BOOST_AUTO_TEST_CASE( streamingTemporalCollection ) {
+  const xdm::FileSystemPath testFilePath( "streamingTemporalCollection.xmf" );
+  const xdm::FileSystemPath hdfFilePath( "streamingTemporalCollection.xmf.h5" );
+
+  xdm::remove( testFilePath );
+  xdm::remove( hdfFilePath );
+
+  writeTimeGrid( testFilePath );
+
+  xdmf::StreamingXmfReader reader;
+  xdmFormat::ReadResult result = reader.readItem( testFilePath );
+  BOOST_CHECK_EQUAL( result.seriesSteps(), 5 );
+  BOOST_REQUIRE( result.item() );
+
+  xdm::RefPtr< xdmGrid::UniformGrid > g =
+    xdm::dynamic_pointer_cast< xdmGrid::UniformGrid >( result.item() );
+  BOOST_REQUIRE( g );
+
+  xdm::RefPtr< xdm::UniformDataItem > data = g->attributeByName( "attr" )->dataItem();
+  BOOST_CHECK_EQUAL( data->dataspace(),
+    xdm::makeShape( kMeshSize[1], kMeshSize[0] ) );
+  for ( size_t step = 0; step < 5; ++step ) {
+    BOOST_REQUIRE( reader.update( g, testFilePath, step ) );
+    BOOST_CHECK_EQUAL( g->time()->value(), step );
+    BOOST_CHECK_EQUAL( data->atLocation< double >( 2, 5 ), step );
+  }
+
+  // Go back in time.
+  BOOST_REQUIRE( reader.update( g, testFilePath, 2 ) );
+  BOOST_CHECK_EQUAL( g->time()->value(), 2.0 );
+  BOOST_CHECK_EQUAL( data->atLocation< double >( 2, 5 ), 2.0 );
+
+  // Steps past the end and unknown files are not available.
+  BOOST_CHECK( !reader.update( g, testFilePath, 5 ) );
+  BOOST_CHECK( !reader.update( g, xdm::FileSystemPath( "unknown.xmf" ), 0 ) );
+}
+
+BOOST_AUTO_TEST_CASE( streamingSingleGrid ) {
+  xdmf::StreamingXmfReader reader;
+  xdmFormat::ReadResult result =
+    reader.readItem( xdm::FileSystemPath( "test_document1.xmf" ) );
+  BOOST_CHECK_EQUAL( result.seriesSteps(), 1 );
+  BOOST_REQUIRE( xdm::dynamic_pointer_cast< xdmGrid::UniformGrid >( result.item() ) );
+}
+
+BOOST_AUTO_TEST_CASE( trailerEveryStep ) {
+  const xdm::FileSystemPath testFilePath( "trailerEveryStep.xmf" );
+  const xdm::FileSystemPath hdfFilePath( "trailerEveryStep.xmf.h5" );
+
+  xdm::remove( testFilePath );
+  xdm::remove( hdfFilePath );
+
+  xdm::RefPtr< xdmGrid::UniformGrid > grid = build2DGrid();
+  xdm::RefPtr< xdmGrid::Time > time =
+    xdm::const_pointer_cast< xdmGrid::Time >( grid->time() );
+  xdm::RefPtr< xdm::TypedStructuredArray< double > > array =
+    grid->attributeByName( "attr" )->dataItem()->typedArray< double >();
+
+  // The file is a complete document after every step, even while open.
+  {
+    xdmf::XmfWriter writer;
+    writer.setTrailerPolicy( xdmf::TemporalCollection::kTrailerEveryStep, 2 );
+    writer.open( testFilePath, xdm::Dataset::kCreate );
+    for ( int step = 0; step < 3; ++step ) {
+      time->setValue( static_cast< double >( step ) );
+      std::fill( array->begin(), array->end(), timeFunction( step ) );
+      writer.write( grid, step );
+
+      xdmf::XmfReader reader;
+      xdmFormat::ReadResult result = reader.readItem( testFilePath );
+      BOOST_CHECK_EQUAL( result.seriesSteps(), step + 1 );
+    }
+    writer.close();
+  }
+
+  // Append to the existing file without rewriting the earlier steps.
+  {
+    xdmf::XmfWriter writer;
+    writer.setTrailerPolicy( xdmf::TemporalCollection::kTrailerEveryStep, 2 );
+    writer.open( testFilePath, xdm::Dataset::kModify );
+    for ( int step = 3; step < 5; ++step ) {
+      time->setValue( static_cast< double >( step ) );
+      std::fill( array->begin(), array->end(), timeFunction( step ) );
+      writer.write( grid, step );
+    }
+    writer.close();
+  }
+
+  xdmf::XmfReader reader;
+  xdmFormat::ReadResult result = reader.readItem( testFilePath );
+  BOOST_CHECK_EQUAL( result.seriesSteps(), 5 );
+  xdm::RefPtr< xdmGrid::UniformGrid > g =
+    xdm::dynamic_pointer_cast< xdmGrid::UniformGrid >( result.item() );
+  BOOST_REQUIRE( g );
+  xdm::RefPtr< xdm::UniformDataItem > data = g->attributeByName( "attr" )->dataItem();
+  for ( size_t step = 0; step < 5; ++step ) {
+    xdm::updateToIndex( *g, step );
+    BOOST_CHECK_EQUAL( g->time()->value(), step );
+    BOOST_CHECK_EQUAL( data->atLocation< double >( 2, 5 ), step );
+  }
+
+  // The index holds the step count in its header.
+  std::ifstream index(
+    xdmf::TemporalCollection::indexFilename( testFilePath.pathString() ).c_str() );
+  std::string magic;
+  size_t stepCount = 0;
+  index >> magic >> stepCount;
+  BOOST_CHECK_EQUAL( magic, "XDMFIDX1" );
+  BOOST_CHECK_EQUAL( stepCount, 5 );
+}
+
+BOOST_AUTO_TEST_CASE( trailerEveryStepRecovery ) {
+  const xdm::FileSystemPath testFilePath( "trailerEveryStepRecovery.xmf" );
+  const xdm::FileSystemPath hdfFilePath( "trailerEveryStepRecovery.xmf.h5" );
+  const std::string indexFile =
+    xdmf::TemporalCollection::indexFilename( testFilePath.pathString() );
+
+  xdm::remove( testFilePath );
+  xdm::remove( hdfFilePath );
+
+  xdm::RefPtr< xdmGrid::UniformGrid > grid = build2DGrid();
+  xdm::RefPtr< xdmGrid::Time > time =
+    xdm::const_pointer_cast< xdmGrid::Time >( grid->time() );
+
+  // Keep the index as it was after the first step to simulate a crash between
+  // writing the second step and updating the index.
+  std::string staleIndex;
+  {
+    xdmf::XmfWriter writer;
+    writer.setTrailerPolicy( xdmf::TemporalCollection::kTrailerEveryStep );
+    writer.open( testFilePath, xdm::Dataset::kCreate );
+    for ( int step = 0; step < 2; ++step ) {
+      time->setValue( static_cast< double >( step ) );
+      writer.write( grid, step );
+      if ( step == 0 ) {
+        std::ifstream index( indexFile.c_str() );
+        staleIndex.assign( std::istreambuf_iterator< char >( index ),
+          std::istreambuf_iterator< char >() );
+      }
+    }
+    writer.close();
+  }
+  {
+    std::ofstream index( indexFile.c_str() );
+    index << staleIndex;
+  }
+
+  // The completed step is kept and the next one follows it.
+  {
+    xdmf::XmfWriter writer;
+    writer.setTrailerPolicy( xdmf::TemporalCollection::kTrailerEveryStep );
+    writer.open( testFilePath, xdm::Dataset::kModify );
+    time->setValue( 2.0 );
+    writer.write( grid, 2 );
+    writer.close();
+  }
+  {
+    xdmf::XmfReader reader;
+    BOOST_CHECK_EQUAL( reader.readItem( testFilePath ).seriesSteps(), 3 );
+  }
+
+  // A step that was cut off before its trailer is dropped and the trailer is
+  // restored.
+  {
+    std::ofstream file( testFilePath.pathString().c_str(),
+      std::ios::in | std::ios::out );
+    std::ifstream index( indexFile.c_str() );
+    std::string magic;
+    std::streamoff stepCount = 0;
+    std::streamoff trailerOffset = 0;
+    index >> magic >> stepCount >> trailerOffset;
+    file.seekp( trailerOffset );
+    file << "<Grid Name=\"partial";
+  }
+  {
+    xdmf::XmfWriter writer;
+    writer.setTrailerPolicy( xdmf::TemporalCollection::kTrailerEveryStep );
+    writer.open( testFilePath, xdm::Dataset::kModify );
+    writer.close();
+  }
+  xdmf::XmfReader reader;
+  xdmFormat::ReadResult result = reader.readItem( testFilePath );
+  BOOST_CHECK_EQUAL( result.seriesSteps(), 3 );
+  xdm::RefPtr< xdmGrid::UniformGrid > g =
+    xdm::dynamic_pointer_cast< xdmGrid::UniformGrid >( result.item() );
+  BOOST_REQUIRE( g );
+  for ( size_t step = 0; step < 3; ++step ) {
+    xdm::updateToIndex( *g, step );
+    BOOST_CHECK_EQUAL( g->time()->value(), step );
+  }
+}
+
 BOOST_AUTO_TEST_CASE( readThenWrite ) {
   char const * const kReadFileName = "readThenWriteInput.xmf";
   char const * const kReadFileData = "readThenWriteInput.xmf.h5";
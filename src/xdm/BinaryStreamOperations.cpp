@@ -27,6 +27,7 @@
 #include <iterator>
 #include <memory>
 #include <stdexcept>
+#include <vector>
 
 #include <cctype>
 
@@ -44,7 +45,8 @@ public:
 
   enum SupportedSelection {
     kAllDataSelection = 0,
-    kHyperslabDataSelection
+    kHyperslabDataSelection,
+    kCoordinateDataSelection
   };
 
   DataSelectionOutputVisitor( BinaryOStream& ostr ) : mOStr( ostr ) {}
@@ -60,6 +62,11 @@ public:
     mOStr << selection;
   }
 
+  virtual void apply( const xdm::CoordinateDataSelection& selection ) {
+    mOStr << kCoordinateDataSelection;
+    mOStr << selection;
+  }
+
   using xdm::DataSelectionVisitor::apply;
 };
 
@@ -104,6 +111,13 @@ BinaryIStream& operator>>( BinaryIStream& istr, DataSelectionInputProxy& v ) {
     v.setRealSelection( selection.release() );
     break;
   }
+  case DataSelectionOutputVisitor::kCoordinateDataSelection: {
+    std::auto_ptr< xdm::CoordinateDataSelection > selection(
+      new xdm::CoordinateDataSelection );
+    istr >> *selection;
+    v.setRealSelection( selection.release() );
+    break;
+  }
   default:
     XDM_THROW( std::runtime_error( "Unknown selection key" ) );
     break;
@@ -141,6 +155,31 @@ BinaryOStream& operator<<( BinaryOStream& ostr, const xdm::AllDataSelection& v )
   return ostr;
 }
 
+//-----------------------------------------------------------------------------
+BinaryIStream& operator>>( BinaryIStream& istr, xdm::CoordinateDataSelection& v ) {
+  // rank - number of elements - values...
+  xdm::CoordinateArray<>::size_type rank;
+  xdm::CoordinateArray<>::size_type numberOfElements;
+  istr >> rank >> numberOfElements;
+  std::vector< xdm::CoordinateArray<>::size_type > values( 
+    rank * numberOfElements );
+  std::for_each( values.begin(), values.end(),
+    InputObject< xdm::CoordinateArray<>::size_type >( istr ) );
+  v.copyCoordinates( xdm::CoordinateArray<>( 
+    values.empty() ? 0 : &values[0], rank, numberOfElements ) );
+  return istr;
+}
+
+BinaryOStream& operator<<( BinaryOStream& ostr, const xdm::CoordinateDataSelection& v ) {
+  // rank - number of elements - values...
+  const xdm::CoordinateArray<>& coordinates = v.coordinates();
+  ostr << coordinates.rank() << coordinates.numberOfElements();
+  std::for_each( coordinates.values(), 
+    coordinates.values() + coordinates.rank() * coordinates.numberOfElements(),
+    OutputObject< xdm::CoordinateArray<>::size_type >( ostr ) );
+  return ostr;
+}
+
 //-----------------------------------------------------------------------------
 BinaryIStream& operator>>( BinaryIStream& istr, xdm::DataSelectionMap& v ) {
   xdm::RefPtr< DataSelectionInputProxy > domain( new DataSelectionInputProxy );
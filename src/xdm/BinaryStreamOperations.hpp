@@ -25,6 +25,7 @@
 #include <xdm/BinaryIStream.hpp>
 #include <xdm/BinaryOStream.hpp>
 #include <xdm/ByteArray.hpp>
+#include <xdm/CoordinateDataSelection.hpp>
 #include <xdm/DataSelection.hpp>
 #include <xdm/DataSelectionMap.hpp>
 #include <xdm/DataShape.hpp>
@@ -67,6 +68,11 @@ BinaryOStream& operator<<( BinaryOStream& ostr, const std::pair< T, U >& v ) {
 BinaryIStream& operator>>( BinaryIStream& istr, xdm::AllDataSelection& v );
 BinaryOStream& operator<<( BinaryOStream& ostr, const xdm::AllDataSelection& v );
 
+/// Extraction makes a deep copy of the coordinate values, so the selection owns
+/// the values it was read into.
+BinaryIStream& operator>>( BinaryIStream& istr, xdm::CoordinateDataSelection& v );
+BinaryOStream& operator<<( BinaryOStream& ostr, const xdm::CoordinateDataSelection& v );
+
 BinaryIStream& operator>>( BinaryIStream& istr, xdm::DataSelectionMap& v );
 BinaryOStream& operator<<( BinaryOStream& ostr, const xdm::DataSelectionMap& v );
 
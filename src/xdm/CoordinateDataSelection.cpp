@@ -24,12 +24,15 @@
 
 namespace xdm {
 
-CoordinateDataSelection::CoordinateDataSelection() {
+CoordinateDataSelection::CoordinateDataSelection() :
+  mCoordinates(),
+  mStorage() {
 }
 
 CoordinateDataSelection::CoordinateDataSelection( 
   const CoordinateArray<>& coordinates ) :
-  mCoordinates( coordinates ) {
+  mCoordinates( coordinates ),
+  mStorage() {
 }
 
 CoordinateDataSelection::~CoordinateDataSelection() {
@@ -44,6 +47,16 @@ void CoordinateDataSelection::setCoordinates(
   mCoordinates = coordinates;
 }
 
+void CoordinateDataSelection::copyCoordinates(
+  const CoordinateArray<>& coordinates ) {
+  mStorage.assign( coordinates.values(),
+    coordinates.values() + coordinates.rank() * coordinates.numberOfElements() );
+  mCoordinates = CoordinateArray<>( 
+    mStorage.empty() ? 0 : &mStorage[0],
+    coordinates.rank(),
+    coordinates.numberOfElements() );
+}
+
 void CoordinateDataSelection::accept( DataSelectionVisitor& v ) const {
   v.apply( *this );
 }
@@ -23,6 +23,8 @@
 
 #include <xdm/DataSelection.hpp>
 
+#include <algorithm>
+#include <vector>
 
 
 namespace xdm {
@@ -89,13 +91,44 @@ public:
   virtual ~CoordinateDataSelection();
 
   const CoordinateArray<>& coordinates() const;
+
+  /// Set the coordinates to select.  The selection shares the coordinate values
+  /// with the input array, so they must remain valid while the selection is in
+  /// use.
   void setCoordinates( const CoordinateArray<>& coordinates );
 
+  /// Set the coordinates to select from a deep copy of the input array.  The
+  /// selection owns the copied values, so the input may be released
+  /// afterwards.
+  void copyCoordinates( const CoordinateArray<>& coordinates );
+
   virtual void accept( DataSelectionVisitor& v ) const;
 private:
   CoordinateArray<> mCoordinates;
+  std::vector< CoordinateArray<>::size_type > mStorage;
 };
 
+/// Two coordinate arrays are equal if they select the same points in the same
+/// order, regardless of whether they share their values.
+template< typename SizeT >
+bool operator==( 
+  const CoordinateArray< SizeT >& lhs, 
+  const CoordinateArray< SizeT >& rhs ) {
+  if ( lhs.rank() != rhs.rank() || 
+    lhs.numberOfElements() != rhs.numberOfElements() ) {
+    return false;
+  }
+  return std::equal( lhs.values(), 
+    lhs.values() + lhs.rank() * lhs.numberOfElements(), 
+    rhs.values() );
+}
+
+inline bool operator==( 
+  const CoordinateDataSelection& lhs, 
+  const CoordinateDataSelection& rhs ) {
+  return ( lhs.coordinates() == rhs.coordinates() );
+}
+
 } // namespace xdm
 
 #endif // xdm_CoordinateDataSelection_hpp
@@ -50,6 +50,10 @@ void Dataset::update( std::size_t seriesIndex ) {
   }
 }
 
+bool Dataset::isSameLocation( const Dataset& other ) const {
+  return this == &other;
+}
+
 bool Dataset::isInitialized() const {
   return mIsInitialized;
 }
@@ -173,6 +173,12 @@ public:
 
   /// Write any text required to locate the dataset.
   virtual void writeTextContent( XmlTextContent& text ) = 0;
+
+  /// Determine if another dataset refers to the same data on disk as this one.
+  /// Separate dataset objects can refer to the same location, and writing one
+  /// of them can destroy data that is still being read through the other. The
+  /// default compares identity only; subclasses compare their location.
+  virtual bool isSameLocation( const Dataset& other ) const;
   
   //-- Dataset access functions --//
 
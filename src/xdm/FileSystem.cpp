@@ -25,6 +25,15 @@
 
 #include <cstdlib>
 
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <unistd.h>
+#endif
+
 namespace xdm {
 
 FileSystemPath::FileSystemPath() :
@@ -86,5 +95,43 @@ bool remove( const FileSystemPath& path )
   return ( ::remove( path.pathString().c_str() ) == 0 );
 }
 
+bool resize( const FileSystemPath& path, size_t size )
+{
+#ifdef _WIN32
+  int fd = _open( path.pathString().c_str(), _O_RDWR | _O_BINARY );
+  if ( fd == -1 ) {
+    return false;
+  }
+  bool resized = ( _chsize_s( fd, size ) == 0 );
+  _close( fd );
+  return resized;
+#else
+  return ( truncate( path.pathString().c_str(), size ) == 0 );
+#endif
+}
+
+std::time_t lastWriteTime( const FileSystemPath& path )
+{
+  struct stat buf;
+  if ( stat( path.pathString().c_str(), &buf ) != 0 ) {
+    return 0;
+  }
+  return buf.st_mtime;
+}
+
+bool equivalent( const FileSystemPath& lhs, const FileSystemPath& rhs )
+{
+  if ( lhs.pathString() == rhs.pathString() ) {
+    return true;
+  }
+  struct stat lhsBuf;
+  struct stat rhsBuf;
+  if ( stat( lhs.pathString().c_str(), &lhsBuf ) != 0 ||
+    stat( rhs.pathString().c_str(), &rhsBuf ) != 0 ) {
+    return false;
+  }
+  return ( lhsBuf.st_dev == rhsBuf.st_dev && lhsBuf.st_ino == rhsBuf.st_ino );
+}
+
 } // namespace xdm
 
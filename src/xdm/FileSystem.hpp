@@ -23,6 +23,8 @@
 
 #include <string>
 
+#include <ctime>
+
 
 
 namespace xdm {
@@ -58,6 +60,20 @@ size_t size( const FileSystemPath& path );
 /// @return True if deleted, false otherwise.
 bool remove( const FileSystemPath& path );
 
+/// Truncate or extend an existing file to the given size. Bytes added to the
+/// end of the file read as zero.
+/// @return True on success, false otherwise.
+bool resize( const FileSystemPath& path, size_t size );
+
+/// Determine the time a file on disk was last modified.
+/// @return The modification time, or 0 if the file does not exist.
+std::time_t lastWriteTime( const FileSystemPath& path );
+
+/// Determine if two paths refer to the same file. Paths to existing files are
+/// compared by the file they resolve to, so different spellings of a path to
+/// the same file are equivalent. Otherwise the path strings are compared.
+bool equivalent( const FileSystemPath& lhs, const FileSystemPath& rhs );
+
 } // namespace xdm
 
 #endif // xdm_FileSystem_hpp
@@ -24,6 +24,35 @@ namespace {
   void deleteReferencedObject( xdm::ReferencedObject* object ) {
     delete object;
   }
+
+#ifdef XDM_ATOMIC_REFERENCE_COUNT
+#if defined( __GNUC__ )
+  // Adding a reference needs no ordering since the caller already holds one.
+  // Removing a reference must release the caller's prior writes and, for the
+  // last reference, acquire everyone else's before the object is deleted.
+  inline int incrementCount( int& count ) {
+    return __atomic_add_fetch( &count, 1, __ATOMIC_RELAXED );
+  }
+  inline int decrementCount( int& count ) {
+    return __atomic_sub_fetch( &count, 1, __ATOMIC_ACQ_REL );
+  }
+  inline int loadCount( const int& count ) {
+    return __atomic_load_n( &count, __ATOMIC_RELAXED );
+  }
+#else
+#error "Atomic reference counts are not supported for this compiler."
+#endif
+#else
+  inline int incrementCount( int& count ) {
+    return ++count;
+  }
+  inline int decrementCount( int& count ) {
+    return --count;
+  }
+  inline int loadCount( const int& count ) {
+    return count;
+  }
+#endif
 } // namespace anon
 
 namespace xdm {
@@ -36,23 +65,30 @@ ReferencedObject::~ReferencedObject() {
 }
 
 void ReferencedObject::addReference() const {
-  mReferenceCount++;
+  incrementCount( mReferenceCount );
 }
 
 void ReferencedObject::removeReference() const {
-  mReferenceCount--;
-  if ( mReferenceCount <= 0 ) {
+  if ( decrementCount( mReferenceCount ) <= 0 ) {
     // when deleting the object, cast away it's constness.
     deleteReferencedObject( const_cast< ReferencedObject* >( this ) );
   }
 }
 
 void ReferencedObject::removeReferenceWithoutDelete() const {
-  mReferenceCount--;
+  decrementCount( mReferenceCount );
 }
 
 int ReferencedObject::referenceCount() const {
-  return mReferenceCount;
+  return loadCount( mReferenceCount );
+}
+
+bool ReferencedObject::hasAtomicReferenceCount() {
+#ifdef XDM_ATOMIC_REFERENCE_COUNT
+  return true;
+#else
+  return false;
+#endif
 }
 
 } // namespace xdm
@@ -30,6 +30,11 @@ namespace xdm {
 /// Base class for all reference counted objects. Operations that affect only
 /// the reference count for subclasses of ReferencedObject are considered to
 /// be const.
+///
+/// When the library is built with XDM_ATOMIC_REFERENCE_COUNT enabled, the
+/// reference count is updated with atomic operations so that references to
+/// the same object may be added and removed from different threads. The
+/// choice is internal to the library and does not change the class layout.
 class ReferencedObject {
 public:
   ReferencedObject();
@@ -46,6 +51,9 @@ public:
   /// Get the current reference count for an object.
   int referenceCount() const;
 
+  /// Determine if the library was built with atomic reference counts.
+  static bool hasAtomicReferenceCount();
+
 private:
   // the reference count is mutable so that reference counted pointers to
   // constant objects can exist.
@@ -20,12 +20,43 @@
 //------------------------------------------------------------------------------
 #include <xdm/SerializeDataOperation.hpp>
 
+#include <xdm/AllDataSelection.hpp>
+#include <xdm/ByteArray.hpp>
+#include <xdm/DataSelectionMap.hpp>
+#include <xdm/HyperSlabBlockIterator.hpp>
+#include <xdm/HyperslabDataSelection.hpp>
 #include <xdm/UniformDataItem.hpp>
 
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
 namespace xdm {
 
-SerializeDataOperation::SerializeDataOperation( const Dataset::InitializeMode& mode ) :
-  mMode( mode ) {
+namespace {
+
+// Choose a block shape for copying a dataset of the given shape that holds at
+// most maxElements elements. Blocks span the fastest varying dimensions first
+// so each block is as contiguous on disk as possible.
+DataShape<> transferBlockShape(
+  const DataShape<>& shape, 
+  size_t maxElements ) {
+  DataShape<> block( shape.rank() );
+  size_t remaining = std::max( maxElements, size_t( 1 ) );
+  for ( DataShape<>::size_type i = shape.rank(); i > 0; --i ) {
+    block[i-1] = std::max( std::min( shape[i-1], remaining ), size_t( 1 ) );
+    remaining /= block[i-1];
+  }
+  return block;
+}
+
+} // namespace anon
+
+SerializeDataOperation::SerializeDataOperation( 
+  const Dataset::InitializeMode& mode,
+  size_t transferBufferSize ) :
+  mMode( mode ),
+  mTransferBufferSize( transferBufferSize ) {
 }
 
 SerializeDataOperation::~SerializeDataOperation() {
@@ -34,10 +65,15 @@ SerializeDataOperation::~SerializeDataOperation() {
 void SerializeDataOperation::apply( UniformDataItem& udi ) {
   if ( udi.serializationRequired() ) {
     if ( !udi.data()->isMemoryResident() ) {
-      udi.initializeDataset( Dataset::kRead );
-      udi.deserializeData();
-      udi.finalizeDataset();
-      udi.data()->setNeedsUpdate( true );
+      // The data is on disk. There is nothing to write if it is already in the
+      // destination dataset, otherwise stream it across. Compare locations
+      // rather than objects: creating a separate object for the same location
+      // would erase the data before it is read.
+      RefPtr< Dataset > source = udi.sourceDataset();
+      if ( source && !source->isSameLocation( *udi.dataset() ) ) {
+        transfer( udi, *source );
+      }
+      return;
     }
     udi.initializeDataset( mMode );
     udi.serializeData();
@@ -45,5 +81,41 @@ void SerializeDataOperation::apply( UniformDataItem& udi ) {
   }
 }
 
+void SerializeDataOperation::transfer( UniformDataItem& udi, Dataset& source ) {
+  DataShape<> shape = udi.dataspace();
+  source.initialize( udi.dataType(), shape, Dataset::kRead );
+  udi.initializeDataset( mMode );
+
+  size_t elements = std::accumulate( shape.begin(), shape.end(), 
+    size_t( shape.rank() > 0 ? 1 : 0 ), std::multiplies< size_t >() );
+  if ( elements > 0 ) {
+    size_t elementSize = typeSize( udi.dataType() );
+    HyperSlab<> complete( shape );
+    std::fill( complete.beginStart(), complete.endStart(), 0 );
+    std::fill( complete.beginStride(), complete.endStride(), 1 );
+    std::copy( shape.begin(), shape.end(), complete.beginCount() );
+
+    ByteArray buffer( 0 );
+    buffer.setDataType( udi.dataType() );
+    RefPtr< DataSelection > all( new AllDataSelection );
+    for ( HyperSlabBlockIterator<> block( complete, 
+        transferBlockShape( shape, mTransferBufferSize / elementSize ) );
+      block != HyperSlabBlockIterator<>();
+      ++block ) {
+      buffer.resize( std::accumulate( block->beginCount(), block->endCount(),
+        size_t( 1 ), std::multiplies< size_t >() ) );
+      RefPtr< DataSelection > slab( new HyperslabDataSelection( *block ) );
+      source.deserialize( &buffer, DataSelectionMap( slab, all ) );
+      udi.dataset()->serialize( &buffer, DataSelectionMap( all, slab ) );
+    }
+  }
+
+  source.finalize();
+  udi.finalizeDataset();
+  
+  // The destination now holds the data.
+  udi.setSourceDataset( udi.dataset() );
+}
+
 } // namespace xdm
 
@@ -37,14 +37,25 @@ class SerializeDataOperation : public ItemVisitor {
 public:
   /// Initialize using the given mode for Dataset access.
   /// @param mode Read, Create, or Modify Datasets during serialization.
-  SerializeDataOperation( const Dataset::InitializeMode& mode = Dataset::kCreate );
+  /// @param transferBufferSize Maximum number of bytes to hold in memory when
+  /// copying data that is not memory resident from one dataset to another.
+  SerializeDataOperation( 
+    const Dataset::InitializeMode& mode = Dataset::kCreate,
+    size_t transferBufferSize = 1 << 20 );
   virtual ~SerializeDataOperation();
 
-  /// Serialize a UniformDataItem's array into its dataset.
+  /// Serialize a UniformDataItem's array into its dataset. Data that is not
+  /// memory resident is never loaded into the item. If it already lives in the
+  /// item's dataset, the item is skipped. Otherwise it is copied from the
+  /// item's source dataset a block at a time.
   virtual void apply( UniformDataItem& udi );
 
 private:
+  // Copy the item's data from the source dataset to the item's dataset.
+  void transfer( UniformDataItem& udi, Dataset& source );
+
   Dataset::InitializeMode mMode;
+  size_t mTransferBufferSize;
 };
 
 } // namespace xdm
@@ -37,6 +37,7 @@ UniformDataItem::UniformDataItem() :
   mDataType( primitiveType::kFloat ),
   mDataspace(),
   mDataset(),
+  mSourceDataset(),
   mData() {
 }
 
@@ -46,6 +47,7 @@ UniformDataItem::UniformDataItem(
   mDataType( dataType ),
   mDataspace( dataspace ),
   mDataset(),
+  mSourceDataset(),
   mData() {
 }
 
@@ -61,9 +63,25 @@ RefPtr< const Dataset > UniformDataItem::dataset() const {
 }
 
 void UniformDataItem::setDataset( RefPtr< Dataset > ds ) {
+  if ( !mSourceDataset && mData && 
+    !mData->isMemoryResident() && mData->requiresWrite() ) {
+    mSourceDataset = mDataset;
+  }
+  // A dataset at the same location as the source already holds the data.
+  if ( mSourceDataset && ds && mSourceDataset->isSameLocation( *ds ) ) {
+    mSourceDataset = RefPtr< Dataset >();
+  }
   mDataset = ds;
 }
 
+RefPtr< Dataset > UniformDataItem::sourceDataset() {
+  return mSourceDataset ? mSourceDataset : mDataset;
+}
+
+void UniformDataItem::setSourceDataset( RefPtr< Dataset > ds ) {
+  mSourceDataset = ds;
+}
+
 void UniformDataItem::setDataType( primitiveType::Value dataType ) {
   mDataType = dataType;
 }
@@ -192,10 +210,12 @@ RefPtr< const StructuredArray > UniformDataItem::array() const {
     XDM_THROW( DataAccessError() );
   }
   if ( !mData->isMemoryResident() && mData->requiresWrite() ) {
+    // load the data from wherever it currently lives on disk.
     UniformDataItem* mutableThis = const_cast< UniformDataItem* >(this);
-    mutableThis->initializeDataset( Dataset::kRead );
-    mutableThis->deserializeData();
-    mutableThis->finalizeDataset();
+    RefPtr< Dataset > source = mutableThis->sourceDataset();
+    source->initialize( mDataType, mDataspace, Dataset::kRead );
+    mData->read( source.get() );
+    source->finalize();
   }
   return mData->array();
 }
@@ -63,8 +63,18 @@ public:
 
   RefPtr< Dataset > dataset();
   RefPtr< const Dataset > dataset() const;
+  /// Set the dataset the item's data is written to. If the item's data is not
+  /// memory resident and has not been loaded yet, it still lives in the
+  /// previous dataset, which is kept as the source dataset.
   void setDataset( RefPtr< Dataset > ds );
 
+  /// Get the dataset that holds the item's data on disk when it is not memory
+  /// resident. This is the item's dataset unless the dataset was replaced
+  /// before the data was loaded.
+  RefPtr< Dataset > sourceDataset();
+  /// Set the dataset that holds the item's data on disk.
+  void setSourceDataset( RefPtr< Dataset > ds );
+
   /// Set the type for this data.
   void setDataType( primitiveType::Value dataType );
   /// Get the type for this data.
@@ -182,6 +192,7 @@ private:
   primitiveType::Value mDataType;
   DataShape<> mDataspace;
   RefPtr< Dataset > mDataset;
+  RefPtr< Dataset > mSourceDataset;
   RefPtr< MemoryAdapter > mData;
 };
 
@@ -45,8 +45,14 @@ public:
   VectorBase( RefPtr< VectorRefImp< T > > imp, std::size_t index ) :
     mImp( imp ), mIndex( index ) {}
 
-  const T& operator[]( std::size_t i ) const {
-    return mImp->at( mIndex, i );
+  /// Elements are read by value so that implementations that compute their elements, rather
+  /// than store them, can be read through the same interface.
+  T operator[]( std::size_t i ) const {
+    // Read strided data directly rather than through the virtual value().
+    if ( mImp->isStrided() ) {
+      return mImp->data( i )[ mIndex * mImp->stride() ];
+    }
+    return mImp->value( mIndex, i );
   }
 
   /// @returns The number of elements in the vector.
@@ -59,6 +65,14 @@ protected:
   VectorBase( const VectorBase< T >& other ) :
     mImp( other.mImp ), mIndex( other.mIndex ) {}
 
+  /// Get a reference to stored element i for derived classes that allow modification.
+  T& reference( std::size_t i ) const {
+    if ( mImp->isStrided() ) {
+      return mImp->data( i )[ mIndex * mImp->stride() ];
+    }
+    return const_cast< T& >( mImp->at( mIndex, i ) );
+  }
+
   static void copyReference( const VectorBase< T >& source, VectorBase< T >& dest ) {
     dest.mImp = source.mImp;
     dest.mIndex = source.mIndex;
@@ -107,8 +121,7 @@ public:
   }
 
   T& operator[]( std::size_t i ) {
-    return const_cast< T& >(
-      static_cast< const VectorBase< T >& >( *this )[i] );
+    return this->reference( i );
   }
 
   using VectorBase< T >::operator[];
@@ -146,16 +159,79 @@ private:
 };
 
 /// The base Impementation class held by VectorRefs.
+///
+/// Implementations whose elements are each stored as a strided sequence in memory describe that
+/// layout with setStridedLayout(). Element i of the vector at baseIndex is then found at
+/// data( i )[ baseIndex * stride() ], and VectorRefs use this directly instead of calling the
+/// virtual at(). Code that walks many vectors can do the same with plain pointers.
 template< typename T >
 class VectorRefImp : public ReferencedObject {
 public:
+  VectorRefImp() : mStridedData(), mStride( 0 ) {}
+
   /// @param baseIndex The index of the vector in the underlying container of vectors.
   /// @param i The index of an element of the vector at @arg baseIndex, e.g. for an xyz vector,
   ///        i == 1 refers to the y value.
   virtual const T& at( std::size_t baseIndex, std::size_t i ) const = 0;
 
+  /// Read an element by value. Implementations that compute their elements rather than store
+  /// them override this, since they have no persistent element for at() to refer to.
+  virtual T value( std::size_t baseIndex, std::size_t i ) const {
+    return at( baseIndex, i );
+  }
+
   /// @returns The number of elements in this vector.
   virtual std::size_t size() const = 0;
+
+  /// @returns True if the elements of the vectors are stored as strided sequences in memory.
+  bool isStrided() const {
+    return !mStridedData.empty();
+  }
+
+  /// @pre isStrided()
+  /// @returns A pointer to element i of the first vector.
+  T* data( std::size_t i ) const {
+    assert( i < mStridedData.size() );
+    return mStridedData[i];
+  }
+
+  /// @pre isStrided()
+  /// @returns The distance between the same element of consecutive vectors.
+  std::size_t stride() const {
+    return mStride;
+  }
+
+  /// Copy element i of the vectors in [first, first + count) to an output iterator. Strided
+  /// data is copied with a plain pointer loop.
+  template< typename OutputIterator >
+  OutputIterator copyElements(
+    std::size_t i,
+    std::size_t first,
+    std::size_t count,
+    OutputIterator out ) const {
+    if ( isStrided() ) {
+      const T* source = data( i ) + first * mStride;
+      for ( std::size_t n = 0; n < count; ++n, source += mStride ) {
+        *out++ = *source;
+      }
+    } else {
+      for ( std::size_t n = 0; n < count; ++n ) {
+        *out++ = value( first + n, i );
+      }
+    }
+    return out;
+  }
+
+protected:
+  /// Declare that element i of the vector at baseIndex is at data[i][ baseIndex * stride ].
+  void setStridedLayout( const std::vector< T* >& data, std::size_t stride ) {
+    mStridedData = data;
+    mStride = stride;
+  }
+
+private:
+  std::vector< T* > mStridedData;
+  std::size_t mStride;
 };
 
 /// Factory interface for constructing VectorRefImp objects.
@@ -220,9 +296,20 @@ public:
 
   virtual std::size_t size() const;
 
+  /// @returns The number of vectors in a row along the first (fastest varying) axis.
+  std::size_t rowSize() const;
+
+  /// Copy the vectors of the row along the first axis that contains the vector at baseIndex to
+  /// an output iterator, one vector after another (xyzxyz...). Only the first element varies
+  /// within a row, so the others are looked up once for the whole row.
+  template< typename OutputIterator >
+  OutputIterator copyRow( std::size_t baseIndex, OutputIterator out ) const;
+
 private:
   std::vector< T* > mCoordinateAxisValues;
   std::vector< std::size_t > mAxisSizes;
+  // The distance in vector index between consecutive values along each axis.
+  std::vector< std::size_t > mAxisStrides;
   std::size_t mSize;
 };
 
@@ -230,6 +317,11 @@ private:
 template< typename T >
 SingleArrayOfVectorsImp< T >::SingleArrayOfVectorsImp( T* xyzArray, std::size_t elementsPerVector ) :
   mData( xyzArray ), mSize( elementsPerVector ) {
+  std::vector< T* > data( mSize );
+  for ( std::size_t i = 0; i < mSize; ++i ) {
+    data[i] = mData + i;
+  }
+  this->setStridedLayout( data, mSize );
 }
 
 template< typename T >
@@ -246,6 +338,7 @@ template< typename T >
 MultipleArraysOfVectorElementsImp< T >::MultipleArraysOfVectorElementsImp(
   const std::vector< T* >& arrays ) :
     mArrays( arrays ), mSize( arrays.size() ) {
+  this->setStridedLayout( mArrays, 1 );
 }
 
 template< typename T >
@@ -264,22 +357,62 @@ TensorProductArraysImp< T >::TensorProductArraysImp(
   const std::vector< std::size_t >& axisSizes ) :
     mCoordinateAxisValues( coordinateAxisValues ),
     mAxisSizes( axisSizes ),
+    mAxisStrides( axisSizes.size() ),
     mSize( axisSizes.size() ) {
   assert( axisSizes.size() == coordinateAxisValues.size() );
-}
-
-template< typename T >
-const T& TensorProductArraysImp< T >::at( std::size_t baseIndex, std::size_t i ) const {
   // choose a convention for indexing multi-dimension structured data and
   // stick with it. Following XDMF, let's say z is always considered to be
   // the slowest varying dimension, y next, x fastest.
   std::size_t blockSize = 1;
-  std::vector< std::size_t > location( mSize );
   for ( std::size_t dimension = 0; dimension < mSize; ++dimension ) {
-    location[ dimension ] = baseIndex / blockSize % mAxisSizes[ dimension ];
+    mAxisStrides[ dimension ] = blockSize;
     blockSize *= mAxisSizes[ dimension ];
   }
-  return mCoordinateAxisValues[i][location[i]];
+}
+
+template< typename T >
+const T& TensorProductArraysImp< T >::at( std::size_t baseIndex, std::size_t i ) const {
+  // Only the location along axis i is needed to find the value.
+  return mCoordinateAxisValues[i][ baseIndex / mAxisStrides[i] % mAxisSizes[i] ];
+}
+
+template< typename T >
+std::size_t TensorProductArraysImp< T >::rowSize() const {
+  return mSize > 0 ? mAxisSizes[0] : 0;
+}
+
+template< typename T >
+template< typename OutputIterator >
+OutputIterator TensorProductArraysImp< T >::copyRow(
+  std::size_t baseIndex,
+  OutputIterator out ) const {
+  if ( mSize == 0 ) {
+    return out;
+  }
+  const std::size_t rowStart = baseIndex - baseIndex % mAxisSizes[0];
+  // Gather the elements that are constant along the row on the stack. Ranks too large for the
+  // fixed storage fall back to at().
+  const std::size_t kMaxFixedElements = 8;
+  if ( mSize - 1 > kMaxFixedElements ) {
+    for ( std::size_t n = 0; n < mAxisSizes[0]; ++n ) {
+      for ( std::size_t i = 0; i < mSize; ++i ) {
+        *out++ = at( rowStart + n, i );
+      }
+    }
+    return out;
+  }
+  T fixed[ kMaxFixedElements ];
+  for ( std::size_t i = 1; i < mSize; ++i ) {
+    fixed[i-1] = at( rowStart, i );
+  }
+  const T* x = mCoordinateAxisValues[0];
+  for ( std::size_t n = 0; n < mAxisSizes[0]; ++n ) {
+    *out++ = x[n];
+    for ( std::size_t i = 1; i < mSize; ++i ) {
+      *out++ = fixed[i-1];
+    }
+  }
+  return out;
 }
 
 template< typename T >
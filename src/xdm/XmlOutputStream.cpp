@@ -99,5 +99,24 @@ void XmlOutputStream::closeStream() {
   }
 }
 
+void XmlOutputStream::restoreContext( RefPtr< XmlObject > obj ) {
+  mContextStack.push( obj );
+  if( obj->hasChildren() ) {
+    XmlObject::ChildIterator finalChild = obj->endChildren();
+    --finalChild;
+    restoreContext( *finalChild );
+  }
+}
+
+void XmlOutputStream::writeContextFooters( std::ostream& output ) const {
+  // Work on a copy of the stack so that the open contexts are unchanged.
+  std::stack< RefPtr< XmlObject > > contexts( mContextStack );
+  while ( !contexts.empty() ) {
+    RefPtr< XmlObject > top = contexts.top();
+    contexts.pop();
+    top->printFooter( output, contexts.size() );
+  }
+}
+
 } // namespace xdm
 
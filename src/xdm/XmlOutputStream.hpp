@@ -57,6 +57,15 @@ public:
   /// Close the stream, completing all open contexts.
   void closeStream();
 
+  /// Push the contexts that openContext would open for the object without
+  /// writing anything. This resumes a stream whose headers were written
+  /// earlier, such as a file that is being appended to.
+  void restoreContext( RefPtr< XmlObject > obj );
+
+  /// Write the footers of all open contexts to a stream without closing
+  /// them. The output is the same as closeStream would produce.
+  void writeContextFooters( std::ostream& output ) const;
+
 private:
   std::ostream& mOutput;
   std::stack< RefPtr< XmlObject > > mContextStack;
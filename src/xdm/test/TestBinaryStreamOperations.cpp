@@ -155,6 +155,56 @@ BOOST_AUTO_TEST_CASE( HyperslabDataSelectionRoundtrip ) {
   BOOST_CHECK_EQUAL( answer.hyperslab(), result.hyperslab() );
 }
 
+BOOST_AUTO_TEST_CASE( CoordinateDataSelectionRoundtrip ) {
+  Fixture test;
+
+  std::vector< size_t > points;
+  points.push_back( 0 );
+  points.push_back( 2 );
+  points.push_back( 5 );
+  points.push_back( 1 );
+  xdm::CoordinateDataSelection answer( 
+    xdm::CoordinateArray<>( &points[0], 2, 2 ) );
+
+  test.stream << answer << xdm::flush;
+
+  xdm::CoordinateDataSelection result;
+  test.stream >> result;
+  BOOST_CHECK( answer == result );
+
+  // the result owns its own copy of the coordinates.
+  BOOST_CHECK( result.coordinates().values() != &points[0] );
+}
+
+BOOST_AUTO_TEST_CASE( CoordinateDataSelectionMapRoundtrip ) {
+  Fixture test;
+
+  std::vector< size_t > points;
+  points.push_back( 7 );
+  points.push_back( 3 );
+  xdm::RefPtr< xdm::CoordinateDataSelection > answerDomain(
+    new xdm::CoordinateDataSelection( 
+      xdm::CoordinateArray<>( &points[0], 1, 2 ) ) );
+  xdm::RefPtr< xdm::AllDataSelection > answerRange( 
+    new xdm::AllDataSelection );
+  xdm::DataSelectionMap answer( answerDomain, answerRange );
+
+  test.stream << answer << xdm::flush;
+
+  xdm::DataSelectionMap result;
+  test.stream >> result;
+
+  CheckDataSelectionSubclassesEqual< xdm::CoordinateDataSelection > domainCheck(
+    answerDomain.get() );
+  result.domain()->accept( domainCheck );
+  BOOST_CHECK( domainCheck.result );
+
+  CheckDataSelectionSubclassesEqual< xdm::AllDataSelection > rangeCheck( 
+    answerRange.get() );
+  result.range()->accept( rangeCheck );
+  BOOST_CHECK( rangeCheck.result );
+}
+
 BOOST_AUTO_TEST_CASE( DataSelectionMapRoundtrip ) {
   Fixture test;
   
@@ -0,0 +1,203 @@
+//==============================================================================
+// This software developed by Stellar Science Ltd Co and the U.S. Government.
+// Copyright (C) 2009 Stellar Science. Government-purpose rights granted.
+//
+// This file is part of XDM
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//------------------------------------------------------------------------------
+#define BOOST_TEST_MODULE SerializeDataOperation
+#include <boost/test/unit_test.hpp>
+
+#include <xdm/SerializeDataOperation.hpp>
+
+#include <xdm/AllDataSelection.hpp>
+#include <xdm/ArrayAdapter.hpp>
+#include <xdm/DataSelectionMap.hpp>
+#include <xdm/DataSelectionVisitor.hpp>
+#include <xdm/HyperslabDataSelection.hpp>
+#include <xdm/UniformDataItem.hpp>
+#include <xdm/VectorStructuredArray.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Find the slab selected on a dataset, or the whole dataset for an
+// AllDataSelection.
+class SlabVisitor : public xdm::DataSelectionVisitor {
+public:
+  xdm::HyperSlab<> slab;
+  SlabVisitor( const xdm::DataShape<>& shape ) : slab( shape ) {
+    std::fill( slab.beginStart(), slab.endStart(), 0 );
+    std::fill( slab.beginStride(), slab.endStride(), 1 );
+    std::copy( shape.begin(), shape.end(), slab.beginCount() );
+  }
+  void apply( const xdm::HyperslabDataSelection& s ) {
+    slab = s.hyperslab();
+  }
+};
+
+// Two dimensional integer dataset held in memory that records how it is used.
+class VectorDataset : public xdm::Dataset {
+public:
+  xdm::DataShape<> shape;
+  std::vector< int > values;
+  int initializeCount;
+  size_t largestTransfer;
+  // Datasets with the same non-empty location name refer to the same data.
+  std::string location;
+
+  VectorDataset() : 
+    shape(), values(), initializeCount( 0 ), largestTransfer( 0 ), location() {}
+
+  const char* format() { return "Vector"; }
+  void writeTextContent( xdm::XmlTextContent& ) {}
+
+  bool isSameLocation( const xdm::Dataset& other ) const {
+    const VectorDataset* vector = dynamic_cast< const VectorDataset* >( &other );
+    return ( this == &other ) 
+      || ( vector && !location.empty() && vector->location == location );
+  }
+
+  xdm::DataShape<> initializeImplementation(
+    xdm::primitiveType::Value,
+    const xdm::DataShape<>& s,
+    const Dataset::InitializeMode& ) {
+    initializeCount++;
+    shape = s;
+    values.resize( shape[0] * shape[1] );
+    return shape;
+  }
+
+  void serializeImplementation(
+    const xdm::StructuredArray* data,
+    const xdm::DataSelectionMap& selectionMap ) {
+    SlabVisitor file( shape );
+    selectionMap.range()->accept( file );
+    const int* in = static_cast< const int* >( data->data() );
+    forEach( file.slab, in, true );
+  }
+
+  void deserializeImplementation(
+    xdm::StructuredArray* data,
+    const xdm::DataSelectionMap& selectionMap ) {
+    SlabVisitor file( shape );
+    selectionMap.domain()->accept( file );
+    int* out = static_cast< int* >( data->data() );
+    forEach( file.slab, out, false );
+  }
+
+  void finalizeImplementation() {}
+
+private:
+  template< typename T >
+  void forEach( const xdm::HyperSlab<>& slab, T* array, bool write ) {
+    size_t n = 0;
+    for ( size_t i = 0; i < slab.count( 0 ); ++i ) {
+      for ( size_t j = 0; j < slab.count( 1 ); ++j, ++n ) {
+        int& value = values[
+          ( slab.start( 0 ) + i ) * shape[1] + slab.start( 1 ) + j];
+        if ( write ) {
+          value = array[n];
+        } else {
+          const_cast< int& >( array[n] ) = value;
+        }
+      }
+    }
+    largestTransfer = std::max( largestTransfer, n );
+  }
+};
+
+// Build an item whose data has not been loaded from the given dataset.
+xdm::RefPtr< xdm::UniformDataItem > createOnDiskItem(
+  xdm::RefPtr< xdm::Dataset > dataset ) {
+  xdm::RefPtr< xdm::UniformDataItem > item( new xdm::UniformDataItem(
+    xdm::primitiveType::kInt, xdm::makeShape( 4, 6 ) ) );
+  item->setDataset( dataset );
+  xdm::RefPtr< xdm::ArrayAdapter > adapter( new xdm::ArrayAdapter(
+    xdm::makeRefPtr( new xdm::VectorStructuredArray< int >( 0 ) ) ) );
+  adapter->setIsMemoryResident( false );
+  item->setData( adapter );
+  return item;
+}
+
+BOOST_AUTO_TEST_CASE( skipSameDataset ) {
+  xdm::RefPtr< VectorDataset > dataset( new VectorDataset );
+  xdm::RefPtr< xdm::UniformDataItem > item = createOnDiskItem( dataset );
+
+  xdm::SerializeDataOperation serializer;
+  item->accept( serializer );
+
+  // the data is already where it belongs, so the dataset is never touched.
+  BOOST_CHECK_EQUAL( 0, dataset->initializeCount );
+  BOOST_CHECK( item->sourceDataset() == dataset );
+}
+
+BOOST_AUTO_TEST_CASE( blockTransfer ) {
+  xdm::RefPtr< VectorDataset > source( new VectorDataset );
+  source->shape = xdm::makeShape( 4, 6 );
+  source->values.resize( 24 );
+  for ( int i = 0; i < 24; ++i ) {
+    source->values[i] = i;
+  }
+
+  // replacing the dataset before the data is loaded keeps the original as the
+  // source.
+  xdm::RefPtr< xdm::UniformDataItem > item = createOnDiskItem( source );
+  xdm::RefPtr< VectorDataset > destination( new VectorDataset );
+  item->setDataset( destination );
+  BOOST_CHECK( item->sourceDataset() == source );
+
+  // allow a buffer of 10 integers, less than a full copy.
+  xdm::SerializeDataOperation serializer( 
+    xdm::Dataset::kCreate, 10 * sizeof( int ) );
+  item->accept( serializer );
+
+  BOOST_CHECK_EQUAL_COLLECTIONS( 
+    source->values.begin(), source->values.end(),
+    destination->values.begin(), destination->values.end() );
+  BOOST_CHECK( source->largestTransfer <= 10 );
+  BOOST_CHECK( item->sourceDataset() == destination );
+
+  // the item's memory was never filled.
+  BOOST_CHECK_EQUAL( 0, item->data()->array()->size() );
+}
+
+BOOST_AUTO_TEST_CASE( skipDatasetAtSameLocation ) {
+  xdm::RefPtr< VectorDataset > source( new VectorDataset );
+  source->location = "data";
+  source->shape = xdm::makeShape( 4, 6 );
+  source->values.resize( 24, 7 );
+
+  // a separate dataset object for the same location must not be created over
+  // the data it would have to read.
+  xdm::RefPtr< xdm::UniformDataItem > item = createOnDiskItem( source );
+  xdm::RefPtr< VectorDataset > destination( new VectorDataset );
+  destination->location = "data";
+  item->setDataset( destination );
+  BOOST_CHECK( item->sourceDataset() == destination );
+
+  xdm::SerializeDataOperation serializer( xdm::Dataset::kCreate );
+  item->accept( serializer );
+
+  BOOST_CHECK_EQUAL( 0, source->initializeCount );
+  BOOST_CHECK_EQUAL( 0, destination->initializeCount );
+}
+
+} // namespace
+
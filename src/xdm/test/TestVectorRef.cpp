@@ -147,6 +147,93 @@ BOOST_AUTO_TEST_CASE( tensorProduct )
   }
 }
 
+BOOST_AUTO_TEST_CASE( tensorProductRow )
+{
+  double x[3] = { 0.0, 1.0, 2.0 };
+  double y[2] = { 10.0, 20.0 };
+  double z[2] = { 100.0, 200.0 };
+  std::vector< double* > coordinateAxisValues;
+  coordinateAxisValues.push_back( x );
+  coordinateAxisValues.push_back( y );
+  coordinateAxisValues.push_back( z );
+  std::vector< std::size_t > axisSizes;
+  axisSizes.push_back( 3 );
+  axisSizes.push_back( 2 );
+  axisSizes.push_back( 2 );
+  xdm::RefPtr< xdm::TensorProductArraysImp< double > > imp(
+    new xdm::TensorProductArraysImp< double >( coordinateAxisValues, axisSizes ) );
+
+  BOOST_CHECK_EQUAL( 3, imp->rowSize() );
+
+  // Every vector index agrees with the per-axis values.
+  for ( std::size_t k = 0; k < 2; ++k ) {
+    for ( std::size_t j = 0; j < 2; ++j ) {
+      for ( std::size_t i = 0; i < 3; ++i ) {
+        std::size_t index = ( k * 2 + j ) * 3 + i;
+        BOOST_CHECK_EQUAL( x[i], imp->at( index, 0 ) );
+        BOOST_CHECK_EQUAL( y[j], imp->at( index, 1 ) );
+        BOOST_CHECK_EQUAL( z[k], imp->at( index, 2 ) );
+      }
+    }
+  }
+
+  // The row for j = 1, k = 1 from any vector in it.
+  double answer[9] = {
+    0.0, 20.0, 200.0,
+    1.0, 20.0, 200.0,
+    2.0, 20.0, 200.0 };
+  std::vector< double > row( 9 );
+  imp->copyRow( 10, row.begin() );
+  BOOST_CHECK_EQUAL_COLLECTIONS( row.begin(), row.end(), answer, answer + 9 );
+}
+
+BOOST_AUTO_TEST_CASE( stridedLayout )
+{
+  double data[6] = { 0.0, 1.0, 2.0, 3.0, 4.0, 5.0 }; // three 2D vectors.
+  double x[3] = { 0.0, 2.0, 4.0 };
+  double y[3] = { 1.0, 3.0, 5.0 };
+  std::vector< double* > arrays;
+  arrays.push_back( x );
+  arrays.push_back( y );
+  std::vector< double* > axes( arrays );
+  std::vector< std::size_t > axisSizes( 2, 3 );
+
+  xdm::RefPtr< xdm::VectorRefImp< double > > single(
+    new xdm::SingleArrayOfVectorsImp< double >( data, 2 ) );
+  xdm::RefPtr< xdm::VectorRefImp< double > > multiple(
+    new xdm::MultipleArraysOfVectorElementsImp< double >( arrays ) );
+  xdm::RefPtr< xdm::VectorRefImp< double > > tensor(
+    new xdm::TensorProductArraysImp< double >( axes, axisSizes ) );
+
+  BOOST_REQUIRE( single->isStrided() );
+  BOOST_CHECK_EQUAL( single->stride(), 2 );
+  BOOST_CHECK_EQUAL( single->data( 1 ), data + 1 );
+  BOOST_REQUIRE( multiple->isStrided() );
+  BOOST_CHECK_EQUAL( multiple->stride(), 1 );
+  BOOST_CHECK_EQUAL( multiple->data( 1 ), y );
+  BOOST_CHECK( !tensor->isStrided() );
+
+  // The strided layout must agree with at() for every element.
+  for ( std::size_t n = 0; n < 3; ++n ) {
+    for ( std::size_t i = 0; i < 2; ++i ) {
+      BOOST_CHECK_EQUAL( single->data( i )[ n * single->stride() ], single->at( n, i ) );
+      BOOST_CHECK_EQUAL( multiple->data( i )[ n * multiple->stride() ], multiple->at( n, i ) );
+    }
+  }
+
+  // Bulk copies give the same values for strided and non-strided layouts.
+  double answer[2] = { 3.0, 5.0 };
+  std::vector< double > result( 2 );
+  single->copyElements( 1, 1, 2, result.begin() );
+  BOOST_CHECK_EQUAL_COLLECTIONS( result.begin(), result.end(), answer, answer + 2 );
+  multiple->copyElements( 1, 1, 2, result.begin() );
+  BOOST_CHECK_EQUAL_COLLECTIONS( result.begin(), result.end(), answer, answer + 2 );
+  // Tensor product vector 1 is (x[1], y[0]) and vector 2 is (x[2], y[0]).
+  double tensorAnswer[2] = { 2.0, 4.0 };
+  tensor->copyElements( 0, 1, 2, result.begin() );
+  BOOST_CHECK_EQUAL_COLLECTIONS( result.begin(), result.end(), tensorAnswer, tensorAnswer + 2 );
+}
+
 BOOST_AUTO_TEST_CASE( copyConstruct )
 {
   double data[20]; // to be indexed as [10][2], i.e. 10 2D vectors.
@@ -111,5 +111,44 @@ BOOST_AUTO_TEST_CASE( closeStream ) {
   test.closeStream();
 }
 
+BOOST_AUTO_TEST_CASE( writeContextFooters ) {
+  RefPtr< XmlObject > obj( new XmlObject( "obj" ) );
+  RefPtr< XmlObject > chi( new XmlObject( "chi" ) );
+  obj->appendChild( chi );
+
+  std::stringstream result;
+  XmlOutputStream test( result );
+  test.openContext( obj );
+
+  std::stringstream footers;
+  test.writeContextFooters( footers );
+  BOOST_CHECK_EQUAL( "  </chi>\n</obj>\n", footers.str() );
+
+  // The contexts remain open and close to the same footers.
+  std::string header = result.str();
+  test.closeStream();
+  BOOST_CHECK_EQUAL( header + footers.str(), result.str() );
+}
+
+BOOST_AUTO_TEST_CASE( restoreContext ) {
+  RefPtr< XmlObject > obj( new XmlObject( "obj" ) );
+  RefPtr< XmlObject > chi( new XmlObject( "chi" ) );
+  obj->appendChild( chi );
+
+  std::stringstream result;
+  XmlOutputStream test( result );
+  test.restoreContext( obj );
+  test.writeObject( RefPtr< XmlObject >( new XmlObject( "new" ) ) );
+  test.closeStream();
+
+  char const * const answer =
+    "<?xml version='1.0'?>\n"
+    "    <new>\n"
+    "    </new>\n"
+    "  </chi>\n"
+    "</obj>\n";
+  BOOST_CHECK_EQUAL( answer, result.str() );
+}
+
 } // namespace
 
@@ -25,12 +25,23 @@ namespace xdmComm {
 
 CoalescingStreamBuffer::CoalescingStreamBuffer(
   size_t bufSize,
-  MPI_Comm communicator ) :
+  MPI_Comm communicator,
+  size_t numberOfBuffers ) :
   xdm::BinaryStreamBuffer( bufSize ),
-  mCommunicator( communicator ) {
+  mCommunicator( communicator ),
+  mCurrentSource( MPI_ANY_SOURCE ),
+  mBuffers( 1, bufferStart() ),
+  mAdditionalStorage( numberOfBuffers > 1 ? numberOfBuffers - 1 : 0,
+    std::vector< char >( bufSize ) ),
+  mRequests( numberOfBuffers > 1 ? numberOfBuffers : 1, MPI_REQUEST_NULL ),
+  mActiveBuffer( 0 ) {
+  for ( size_t i = 0; i < mAdditionalStorage.size(); i++ ) {
+    mBuffers.push_back( &mAdditionalStorage[i][0] );
+  }
 }
 
 CoalescingStreamBuffer::~CoalescingStreamBuffer() {
+  waitAll();
 }
 
 bool CoalescingStreamBuffer::poll( int source ) {
@@ -57,12 +68,58 @@ int CoalescingStreamBuffer::currentSource() const {
   return mCurrentSource;
 }
 
+size_t CoalescingStreamBuffer::numberOfBuffers() const {
+  return mBuffers.size();
+}
+
+void CoalescingStreamBuffer::waitAll() {
+  MPI_Waitall( mRequests.size(), &mRequests[0], MPI_STATUSES_IGNORE );
+}
+
+void CoalescingStreamBuffer::rotateBuffer() {
+  // look for a buffer that is not waiting on a send, starting with the one
+  // after the active buffer so that the buffers are used in turn.
+  size_t count = mBuffers.size();
+  for ( size_t i = 1; i <= count; i++ ) {
+    size_t candidate = ( mActiveBuffer + i ) % count;
+    if ( mRequests[candidate] == MPI_REQUEST_NULL ) {
+      mActiveBuffer = candidate;
+      setbuf( mBuffers[candidate], bufferSize() );
+      return;
+    }
+  }
+
+  // Every buffer is in flight. Wait until at least one of them is delivered;
+  // completed requests are reset to MPI_REQUEST_NULL.
+  std::vector< int > completed( count );
+  int numberCompleted = 0;
+  MPI_Waitsome(
+    count,
+    &mRequests[0],
+    &numberCompleted,
+    &completed[0],
+    MPI_STATUSES_IGNORE );
+  mActiveBuffer = completed[0];
+  setbuf( mBuffers[mActiveBuffer], bufferSize() );
+}
+
 int CoalescingStreamBuffer::sync() {
   // get the process rank to decide what to do
   int localRank;
   MPI_Comm_rank( mCommunicator, &localRank );
 
-  if ( localRank != 0 ) {
+  if ( localRank != 0 && mBuffers.size() > 1 ) {
+    // post the send and continue writing into the next free buffer.
+    MPI_Isend(
+      bufferStart(),
+      bufferSize(),
+      MPI_BYTE,
+      0,
+      MpiMessageTag::kWriteData,
+      mCommunicator,
+      &mRequests[mActiveBuffer] );
+    rotateBuffer();
+  } else if ( localRank != 0 ) {
     // non-zero ranks send to rank 0
     MPI_Ssend( 
       bufferStart(),
@@ -109,8 +166,13 @@ int CoalescingStreamBuffer::uflow() {
   std::streamsize bufferSize = egptr() - eback();
 
   if ( eback() && bufferSize ) {
-    // spin until we have another message from the current source.
-    while( !poll( mCurrentSource ) );
+    // block until we have another message from the current source.
+    MPI_Status status;
+    MPI_Probe(
+      mCurrentSource,
+      MpiMessageTag::kWriteData,
+      mCommunicator,
+      &status );
     // there is a message from the current source, receive it and continue to
     // read data.
     if ( sync() == 0 ) {
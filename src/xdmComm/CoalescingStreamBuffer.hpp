@@ -25,6 +25,7 @@
 
 #include <mpi.h>
 
+#include <vector>
 
 
 namespace xdmComm {
@@ -46,11 +47,29 @@ namespace xdmComm {
 /// synchronization call only between 256 byte blocks will ensure a minimum of
 /// communication traffic, as synchronization is the only call that results
 /// in MPI messages being sent.
+///
+/// By default, sends are synchronous and a sending process waits until rank 0
+/// has received each message. If the buffer is constructed with more than one
+/// buffer, sends are instead posted with MPI_Isend and the stream continues in
+/// the next free buffer, so the sending process can go back to work while
+/// previous messages are still in flight. A sending process blocks only when
+/// every buffer holds a message that has not yet been delivered.
 class CoalescingStreamBuffer : public xdm::BinaryStreamBuffer {
 private:
   MPI_Comm mCommunicator;
   int mCurrentSource;
 
+  // Rotating send buffers and their outstanding requests. The first buffer is
+  // the storage owned by the base class.
+  std::vector< char* > mBuffers;
+  std::vector< std::vector< char > > mAdditionalStorage;
+  std::vector< MPI_Request > mRequests;
+  size_t mActiveBuffer;
+
+  // Switch the stream to a buffer with no outstanding send, waiting for one
+  // or more sends to complete if necessary.
+  void rotateBuffer();
+
 public:
   /// Constructor initializes the communicator and the buffer size. As described
   /// in the class documentation, clients can use knowledge of their own
@@ -61,8 +80,14 @@ public:
   /// @param bufSize Size of buffer to use in messaging.
   /// @param communicator MPI communicator containing all participating
   /// processes.
-  CoalescingStreamBuffer( size_t bufSize, MPI_Comm communicator );
-
+  /// @param numberOfBuffers Number of buffers to rotate through when sending.
+  /// A value of 1 uses blocking sends, larger values use non-blocking sends.
+  CoalescingStreamBuffer(
+    size_t bufSize,
+    MPI_Comm communicator,
+    size_t numberOfBuffers = 1 );
+
+  /// Destructor waits for any outstanding sends to complete.
   virtual ~CoalescingStreamBuffer();
 
   /// Poll for messages from a CoalescingStreamBuffer on a remote machine from
@@ -76,6 +101,13 @@ public:
   /// communicator.
   /// @return The process that will be queried upon the next call to pubsync().
   int currentSource() const;
+
+  /// Query the number of buffers used for sending.
+  size_t numberOfBuffers() const;
+
+  /// Block until every message sent from this process has been delivered.
+  /// This has no effect for blocking sends.
+  void waitAll();
   
 protected:
 
@@ -0,0 +1,78 @@
+//==============================================================================
+// This software developed by Stellar Science Ltd Co and the U.S. Government.
+// Copyright (C) 2009 Stellar Science. Government-purpose rights granted.
+//
+// This file is part of XDM
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//------------------------------------------------------------------------------
+#include <xdmComm/FileTurn.hpp>
+
+#include <xdmComm/MpiMessageTag.hpp>
+
+namespace xdmComm {
+
+FileTurn::FileTurn( MPI_Comm communicator ) :
+  mCommunicator( communicator ),
+  mRank( 0 ),
+  mSize( 1 ),
+  mTurnOutstanding( false ),
+  mPassRequest( MPI_REQUEST_NULL ),
+  mToken( 0 ) {
+  MPI_Comm_rank( mCommunicator, &mRank );
+  MPI_Comm_size( mCommunicator, &mSize );
+}
+
+FileTurn::~FileTurn() {
+}
+
+void FileTurn::wait() {
+  // The previous rank in the ring hands over the file. For rank 0 that is the
+  // last rank finishing the previous turn, if there was one.
+  if ( mRank > 0 || mTurnOutstanding ) {
+    char token;
+    int previous = ( mRank > 0 ) ? mRank - 1 : mSize - 1;
+    MPI_Recv( &token, 1, MPI_BYTE, previous, MpiMessageTag::kFileTurn,
+      mCommunicator, MPI_STATUS_IGNORE );
+    mTurnOutstanding = false;
+  }
+}
+
+void FileTurn::pass() {
+  if ( mSize == 1 ) {
+    return;
+  }
+  // The send does not wait for the next rank to take the turn. The previous
+  // send has been received by now, since the turn came back around.
+  MPI_Wait( &mPassRequest, MPI_STATUS_IGNORE );
+  MPI_Isend( &mToken, 1, MPI_BYTE, ( mRank + 1 ) % mSize,
+    MpiMessageTag::kFileTurn, mCommunicator, &mPassRequest );
+  if ( mRank == 0 ) {
+    mTurnOutstanding = true;
+  }
+}
+
+void FileTurn::finish() {
+  if ( mRank == 0 && mTurnOutstanding ) {
+    wait();
+  }
+  MPI_Wait( &mPassRequest, MPI_STATUS_IGNORE );
+}
+
+bool FileTurn::first() const {
+  return mRank == 0;
+}
+
+} // namespace xdmComm
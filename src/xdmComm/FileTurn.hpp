@@ -0,0 +1,70 @@
+//==============================================================================
+// This software developed by Stellar Science Ltd Co and the U.S. Government.
+// Copyright (C) 2009 Stellar Science. Government-purpose rights granted.
+//
+// This file is part of XDM
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//------------------------------------------------------------------------------
+#ifndef xdmComm_FileTurn_hpp
+#define xdmComm_FileTurn_hpp
+
+#include <xdm/ReferencedObject.hpp>
+
+#include <mpi.h>
+
+
+
+namespace xdmComm {
+
+/// Passes the use of a file around the processes of a communicator in rank
+/// order, like a token around a ring. Every dataset that writes the file
+/// through the same communicator shares one FileTurn, so rank 0 waits for the
+/// last rank to finish a turn before it starts the next one, but no process
+/// waits for the others after its own turn.
+class FileTurn : public xdm::ReferencedObject {
+public:
+  /// @param communicator The processes that take turns writing.
+  explicit FileTurn( MPI_Comm communicator );
+  virtual ~FileTurn();
+
+  /// Wait until this process may use the file.
+  void wait();
+  /// Hand the file to the next process.
+  void pass();
+  /// Wait until the last turn has gone all the way around. Call this
+  /// before the communicator is freed.
+  void finish();
+
+  /// @returns True if this process is the first to write in each turn.
+  bool first() const;
+
+private:
+  MPI_Comm mCommunicator;
+  int mRank;
+  int mSize;
+  // Rank 0 has passed a turn that has not come back from the last rank yet.
+  bool mTurnOutstanding;
+  MPI_Request mPassRequest;
+  char mToken;
+
+  // The turn holds a pending request, so it cannot be copied.
+  FileTurn( const FileTurn& );
+  FileTurn& operator=( const FileTurn& );
+};
+
+} // namespace xdmComm
+
+#endif // xdmComm_FileTurn_hpp
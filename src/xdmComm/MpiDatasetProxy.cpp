@@ -33,14 +33,27 @@
 #include <xdm/DataSelectionMap.hpp>
 #include <xdm/DataSelectionVisitor.hpp>
 #include <xdm/DataShape.hpp>
+#include <xdm/HyperSlabBlockIterator.hpp>
 #include <xdm/HyperslabDataSelection.hpp>
 #include <xdm/StructuredArray.hpp>
 #include <xdm/VectorStructuredArray.hpp>
 
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
 namespace xdmComm {
 
 namespace {
 
+// Default largest message of array data: 64 MiB.
+const size_t kDefaultPieceSize = 64 * 1024 * 1024;
+
+size_t product( std::vector< size_t >::const_iterator begin,
+  std::vector< size_t >::const_iterator end ) {
+  return std::accumulate( begin, end, size_t( 1 ), std::multiplies< size_t >() );
+}
+
 // receive and write off core data to a dataset.
 // Precondition: There must be a message available to receive.
 void receiveAndWriteProcessData( 
@@ -67,14 +80,96 @@ void receiveAndWriteProcessData(
 MpiDatasetProxy::MpiDatasetProxy( 
   MPI_Comm communicator, 
   xdm::RefPtr< xdm::Dataset > dataset,
-  size_t bufSizeHint ) :
+  size_t bufSizeHint,
+  size_t numberOfBuffers ) :
   xdm::ProxyDataset( dataset ),
   mCommunicator( communicator ),
-  mCommBuffer( new CoalescingStreamBuffer( bufSizeHint, communicator ) ),
-  mArrayBuffer( new xdm::ByteArray( bufSizeHint ) ) {
+  mCommBuffer( new CoalescingStreamBuffer(
+    bufSizeHint, communicator, numberOfBuffers ) ),
+  mArrayBuffer( new xdm::ByteArray( bufSizeHint ) ),
+  mCompletionRequest( MPI_REQUEST_NULL ),
+  mCompletionSignal( 1 ),
+  mPieceSize( kDefaultPieceSize ),
+  mDataShape() {
 }
 
 MpiDatasetProxy::~MpiDatasetProxy() {
+  MPI_Wait( &mCompletionRequest, MPI_STATUS_IGNORE );
+}
+
+void MpiDatasetProxy::setPieceSize( size_t bytes ) {
+  mPieceSize = bytes;
+}
+
+size_t MpiDatasetProxy::pieceSize() const {
+  return mPieceSize;
+}
+
+bool MpiDatasetProxy::sendInPieces(
+  const xdm::StructuredArray& array,
+  const xdm::DataSelectionMap& selectionMap ) {
+
+  if ( array.memorySize() <= mPieceSize ) {
+    return false;
+  }
+
+  // The array elements must map in order onto a hyperslab of the dataset.
+  if ( ! xdm::dynamic_pointer_cast< const xdm::AllDataSelection >(
+    selectionMap.domain() ) ) {
+    return false;
+  }
+  xdm::HyperSlab<> slab;
+  xdm::RefPtr< const xdm::HyperslabDataSelection > rangeSlab =
+    xdm::dynamic_pointer_cast< const xdm::HyperslabDataSelection >(
+      selectionMap.range() );
+  if ( rangeSlab ) {
+    slab = rangeSlab->hyperslab();
+  } else if ( xdm::dynamic_pointer_cast< const xdm::AllDataSelection >(
+    selectionMap.range() ) ) {
+    slab.setShape( mDataShape );
+    std::fill( slab.beginStart(), slab.endStart(), 0 );
+    std::fill( slab.beginStride(), slab.endStride(), 1 );
+    std::copy( mDataShape.begin(), mDataShape.end(), slab.beginCount() );
+  } else {
+    return false;
+  }
+  if ( slab.shape().rank() == 0 ||
+    product( slab.beginCount(), slab.endCount() ) != array.size() ) {
+    return false;
+  }
+
+  // Blocks that span every dimension but the first are contiguous in the
+  // array, so each piece is a run of whole rows.
+  size_t rowSize = product( slab.beginCount() + 1, slab.endCount() ) * array.elementSize();
+  size_t rowsPerPiece = std::max( mPieceSize / std::max( rowSize, size_t( 1 ) ), size_t( 1 ) );
+  if ( rowsPerPiece >= slab.count( 0 ) ) {
+    return false;
+  }
+  xdm::DataShape<> blockSize( slab.shape().rank() );
+  std::copy( slab.beginCount(), slab.endCount(), blockSize.begin() );
+  blockSize[0] = rowsPerPiece;
+
+  // Pieces are written with the same layout as a whole StructuredArray, so rank
+  // 0 receives them as ordinary messages.
+  const char* bytes = reinterpret_cast< const char* >( array.data() );
+  xdm::BinaryOStream dataStream( mCommBuffer.get() );
+  xdm::HyperSlabBlockIterator<> end;
+  for ( xdm::HyperSlabBlockIterator<> piece( slab, blockSize ); piece != end; ++piece ) {
+    xdm::HyperSlab<> pieceSlab( slab.shape() );
+    std::copy( piece->beginStart(), piece->endStart(), pieceSlab.beginStart() );
+    std::copy( piece->beginStride(), piece->endStride(), pieceSlab.beginStride() );
+    std::copy( piece->beginCount(), piece->endCount(), pieceSlab.beginCount() );
+    size_t pieceElements = product( pieceSlab.beginCount(), pieceSlab.endCount() );
+
+    dataStream << array.dataType() << pieceElements;
+    dataStream.write( bytes, pieceElements * array.elementSize() );
+    dataStream << xdm::DataSelectionMap(
+      xdm::makeRefPtr( new xdm::AllDataSelection ),
+      xdm::makeRefPtr( new xdm::HyperslabDataSelection( pieceSlab ) ) );
+    dataStream << xdm::flush;
+    bytes += pieceElements * array.elementSize();
+  }
+  return true;
 }
 
 xdm::DataShape<> MpiDatasetProxy::initializeImplementation(
@@ -84,6 +179,9 @@ xdm::DataShape<> MpiDatasetProxy::initializeImplementation(
   
   MPI_Barrier( mCommunicator );
 
+  // Keep the shape so that selections of all of the data can be split.
+  mDataShape = shape;
+
   int rank;
   MPI_Comm_rank( mCommunicator, &rank );
   if ( rank == 0 ) {
@@ -103,6 +201,9 @@ void MpiDatasetProxy::serializeImplementation(
   // Rank 0 in the communicator writes local data and polls for messages from
   // other processes.
   if ( localRank != 0 ) {
+    if ( sendInPieces( *array, selectionMap ) ) {
+      return;
+    }
     xdm::BinaryOStream dataStream( mCommBuffer.get() );
     dataStream << *array;
     dataStream << selectionMap;
@@ -137,32 +238,24 @@ void MpiDatasetProxy::finalizeImplementation() {
   int rank;
   MPI_Comm_rank( mCommunicator, &rank );
 
-  char datasetCompleteSignalBuffer[1];
-  datasetCompleteSignalBuffer[0] = 1;
-
   if ( rank == 0 ) {
     
-    // wait for all processes to signal that they are done with this dataset
+    // wait for all processes to signal that they are done with this dataset.
+    // Probing for any tag means a completion signal is never seen before the
+    // data a process sent ahead of it.
     int processesCompleted = 1;
     while ( processesCompleted < size ) {
       MPI_Status status;
-      int flag;
-      MPI_Iprobe(
-        MPI_ANY_SOURCE, 
-        MpiMessageTag::kProcessCompleted,
-        mCommunicator,
-        &flag,
-        &status );
+      MPI_Probe( MPI_ANY_SOURCE, MPI_ANY_TAG, mCommunicator, &status );
       
-      // if a process signalled complete, swallow the message and increment
-      if ( flag ) {
-        MPI_Recv( datasetCompleteSignalBuffer, 1, MPI_BYTE, MPI_ANY_SOURCE,
+      if ( status.MPI_TAG == MpiMessageTag::kProcessCompleted ) {
+        // a process signalled complete, swallow the message and increment
+        char signal;
+        MPI_Recv( &signal, 1, MPI_BYTE, status.MPI_SOURCE,
           MpiMessageTag::kProcessCompleted, mCommunicator, &status );
         processesCompleted++;
-      }
-
-      // poll and process any new messages
-      while ( mCommBuffer->poll() ) {
+      } else if ( mCommBuffer->poll( status.MPI_SOURCE ) ) {
+        // receive and write the new message
         receiveAndWriteProcessData(
           mCommBuffer.get(),
           innerDataset().get(),
@@ -170,9 +263,15 @@ void MpiDatasetProxy::finalizeImplementation() {
       }
     }
     xdm::ProxyDataset::finalizeImplementation();
+  } else if ( mCommBuffer->numberOfBuffers() > 1 ) {
+    // Signal without waiting for rank 0 to finish with our data. The previous
+    // signal from this proxy was received long ago, but complete its request.
+    MPI_Wait( &mCompletionRequest, MPI_STATUS_IGNORE );
+    MPI_Isend( &mCompletionSignal, 1, MPI_BYTE, 0,
+      MpiMessageTag::kProcessCompleted, mCommunicator, &mCompletionRequest );
   } else {
     // Not rank 0 and local process is done with current dataset.  Signal.
-    MPI_Ssend( datasetCompleteSignalBuffer, 1, MPI_BYTE, 0, 
+    MPI_Ssend( &mCompletionSignal, 1, MPI_BYTE, 0, 
       MpiMessageTag::kProcessCompleted, mCommunicator );
   }
 }
@@ -21,6 +21,7 @@
 #ifndef xdmComm_MpiDatasetProxy_hpp
 #define xdmComm_MpiDatasetProxy_hpp
 
+#include <xdm/DataShape.hpp>
 #include <xdm/ProxyDataset.hpp>
 
 #include <mpi.h>
@@ -59,6 +60,18 @@ class CoalescingStreamBuffer;
 /// communication traffic. Clients with knowledge of their own array sizes can
 /// tune this parameter to ensure a minimum of communication is required when
 /// passing arrays with dataset contents between processes.
+///
+/// If more than one communication buffer is requested, processes other than
+/// rank 0 do not wait for their data to be delivered. They post their messages
+/// and return as soon as there is a free buffer, so they may continue working
+/// while rank 0 receives and writes the data.
+///
+/// Large arrays are sent to rank 0 in pieces of at most pieceSize() bytes, each
+/// with its own hyperslab selection, so that rank 0 only ever holds one piece
+/// from another process in memory. Rank 0 writes each piece to the dataset
+/// while the next one is still on its way. This applies when the whole array is
+/// mapped to a hyperslab of the dataset, or to all of it; other selections are
+/// sent in one message.
 class MpiDatasetProxy : public xdm::ProxyDataset {
 public:
   // Code Review Matter (open): Naming conventions.
@@ -74,13 +87,23 @@ public:
   /// @param communicator Communicator with relevant processes.
   /// @param dataset The actual dataset that will handle writing.
   /// @param bufSizeHint Suggested size for communication buffer.
+  /// @param numberOfBuffers Number of communication buffers. More than one
+  /// buffer enables non-blocking communication.
   MpiDatasetProxy( 
     MPI_Comm communicator, 
     xdm::RefPtr< xdm::Dataset > dataset,
-    size_t bufSizeHint );
+    size_t bufSizeHint,
+    size_t numberOfBuffers = 1 );
 
   virtual ~MpiDatasetProxy();
 
+  /// Set the largest number of bytes of array data sent in a single message.
+  /// Arrays are split along their first dimension, so a piece always holds at
+  /// least one row of the selected hyperslab.
+  void setPieceSize( size_t bytes );
+  /// Get the largest number of bytes of array data sent in a single message.
+  size_t pieceSize() const;
+
 protected:
   /// Initialization calls underlying dataset initialization only if this
   /// process is rank 0 within the communicator.
@@ -109,6 +132,18 @@ private:
   MPI_Comm mCommunicator;
   std::auto_ptr< xdmComm::CoalescingStreamBuffer > mCommBuffer;
   xdm::RefPtr< xdm::ByteArray > mArrayBuffer;
+  // Outstanding completion signal for non-blocking communication.
+  MPI_Request mCompletionRequest;
+  char mCompletionSignal;
+  size_t mPieceSize;
+  xdm::DataShape<> mDataShape;
+
+  // Send the array to rank 0 in pieces if it is larger than the piece size.
+  // Returns false if the array was not sent because it fits in one piece or
+  // the selection cannot be split.
+  bool sendInPieces(
+    const xdm::StructuredArray& array,
+    const xdm::DataSelectionMap& selectionMap );
 };
 
 } // namespace xdmComm
@@ -34,7 +34,8 @@ class MpiMessageTag {
 public:
   enum Value {
     kWriteData,
-    kProcessCompleted
+    kProcessCompleted,
+    kFileTurn
   };
 };
 
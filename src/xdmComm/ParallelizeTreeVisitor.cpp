@@ -20,28 +20,204 @@
 //------------------------------------------------------------------------------
 #include <xdmComm/ParallelizeTreeVisitor.hpp>
 
+#include <xdmComm/FileTurn.hpp>
 #include <xdmComm/MpiDatasetProxy.hpp>
 
 #include <xdm/Dataset.hpp>
 #include <xdm/UniformDataItem.hpp>
 
+#ifdef XDM_COMM_HDF
+#include <xdmComm/SequentialHdfDataset.hpp>
+
+#include <xdmHdf/HdfDataset.hpp>
+#endif
+
+#ifdef XDM_COMM_PARALLEL_HDF
+#include <xdmHdf/ParallelHdfDataset.hpp>
+#endif
+
+#include <cassert>
+
 #include <mpi.h>
 
 namespace xdmComm {
 
-ParallelizeTreeVisitor::ParallelizeTreeVisitor( size_t bufferSize ) :
-  mBufferSize( bufferSize ) {
+ParallelizeTreeVisitor::ParallelizeTreeVisitor(
+  size_t bufferSize,
+  size_t numberOfBuffers ) :
+  mCommunicator( MPI_COMM_WORLD ),
+  mAggregatorCommunicator( MPI_COMM_NULL ),
+  mAggregatorsCommunicator( MPI_COMM_NULL ),
+  mFileTurn(),
+  mAggregatorGroup( 0 ),
+  mNumberOfAggregators( 1 ),
+  mBufferSize( bufferSize ),
+  mNumberOfBuffers( numberOfBuffers ),
+  mUseCollectiveHdf( false ) {
+}
+
+ParallelizeTreeVisitor::ParallelizeTreeVisitor(
+  MPI_Comm communicator,
+  size_t bufferSize,
+  size_t numberOfBuffers ) :
+  mCommunicator( communicator ),
+  mAggregatorCommunicator( MPI_COMM_NULL ),
+  mAggregatorsCommunicator( MPI_COMM_NULL ),
+  mFileTurn(),
+  mAggregatorGroup( 0 ),
+  mNumberOfAggregators( 1 ),
+  mBufferSize( bufferSize ),
+  mNumberOfBuffers( numberOfBuffers ),
+  mUseCollectiveHdf( false ) {
 }
 
 ParallelizeTreeVisitor::~ParallelizeTreeVisitor() {
+  freeAggregatorCommunicator();
+}
+
+void ParallelizeTreeVisitor::freeAggregatorCommunicator() {
+  int finalized = 0;
+  MPI_Finalized( &finalized );
+  // Take back the last turn with the file before its communicator goes away.
+  if ( !finalized && mFileTurn ) {
+    mFileTurn->finish();
+  }
+  mFileTurn = xdm::RefPtr< FileTurn >();
+  if ( !finalized && mAggregatorCommunicator != MPI_COMM_NULL ) {
+    MPI_Comm_free( &mAggregatorCommunicator );
+  }
+  if ( !finalized && mAggregatorsCommunicator != MPI_COMM_NULL ) {
+    MPI_Comm_free( &mAggregatorsCommunicator );
+  }
+  mAggregatorCommunicator = MPI_COMM_NULL;
+  mAggregatorsCommunicator = MPI_COMM_NULL;
+  mAggregatorGroup = 0;
+  mNumberOfAggregators = 1;
+}
+
+void ParallelizeTreeVisitor::setAggregatorCommunicator( MPI_Comm group ) {
+  freeAggregatorCommunicator();
+  mAggregatorCommunicator = group;
+
+  // The aggregators count themselves in rank order, then tell their group
+  // which number they got.
+  int groupRank;
+  MPI_Comm_rank( mAggregatorCommunicator, &groupRank );
+  int isAggregator = ( groupRank == 0 ) ? 1 : 0;
+  int aggregatorsBefore = 0;
+  MPI_Exscan( &isAggregator, &aggregatorsBefore, 1, MPI_INT, MPI_SUM, mCommunicator );
+  int rank;
+  MPI_Comm_rank( mCommunicator, &rank );
+  mAggregatorGroup = ( rank == 0 ) ? 0 : aggregatorsBefore;
+  MPI_Bcast( &mAggregatorGroup, 1, MPI_INT, 0, mAggregatorCommunicator );
+  MPI_Allreduce( &isAggregator, &mNumberOfAggregators, 1, MPI_INT, MPI_SUM,
+    mCommunicator );
+
+  // Ordering the aggregators by rank also orders them by group.
+  MPI_Comm_split( mCommunicator, isAggregator ? 0 : MPI_UNDEFINED, rank,
+    &mAggregatorsCommunicator );
+  if ( mAggregatorsCommunicator != MPI_COMM_NULL ) {
+    mFileTurn = xdm::makeRefPtr( new FileTurn( mAggregatorsCommunicator ) );
+  }
+}
+
+void ParallelizeTreeVisitor::setNumberOfAggregators( int aggregators ) {
+  int processes;
+  MPI_Comm_size( mCommunicator, &processes );
+  int rank;
+  MPI_Comm_rank( mCommunicator, &rank );
+  assert( aggregators > 0 && aggregators <= processes );
+
+  // Spread the processes as evenly as possible over consecutive rank groups.
+  int color = (int)( ( (long long)rank * aggregators ) / processes );
+  MPI_Comm group;
+  MPI_Comm_split( mCommunicator, color, rank, &group );
+  setAggregatorCommunicator( group );
+}
+
+void ParallelizeTreeVisitor::setAggregatorPerNode() {
+  int rank;
+  MPI_Comm_rank( mCommunicator, &rank );
+  MPI_Comm group;
+#if MPI_VERSION >= 3
+  MPI_Comm_split_type( mCommunicator, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &group );
+#else
+  MPI_Comm_split( mCommunicator, 0, rank, &group );
+#endif
+  setAggregatorCommunicator( group );
+}
+
+int ParallelizeTreeVisitor::numberOfAggregators() const {
+  return mNumberOfAggregators;
+}
+
+int ParallelizeTreeVisitor::aggregatorGroup() const {
+  return mAggregatorGroup;
+}
+
+void ParallelizeTreeVisitor::setUseCollectiveHdf( bool value ) {
+  mUseCollectiveHdf = value;
+}
+
+bool ParallelizeTreeVisitor::useCollectiveHdf() const {
+  return mUseCollectiveHdf;
+}
+
+bool ParallelizeTreeVisitor::collectiveHdfAvailable() {
+#ifdef XDM_COMM_PARALLEL_HDF
+  return true;
+#else
+  return false;
+#endif
+}
+
+xdm::RefPtr< xdm::Dataset > ParallelizeTreeVisitor::aggregatorDataset(
+  xdm::RefPtr< xdm::Dataset > dataset,
+  int /* group */,
+  MPI_Comm aggregators ) {
+
+#ifdef XDM_COMM_HDF
+  xdm::RefPtr< xdmHdf::HdfDataset > hdfDataset =
+    xdm::dynamic_pointer_cast< xdmHdf::HdfDataset >( dataset );
+  if ( hdfDataset && aggregators != MPI_COMM_NULL && mNumberOfAggregators > 1 ) {
+    return xdm::makeRefPtr( new SequentialHdfDataset( hdfDataset, mFileTurn ) );
+  }
+#endif
+
+  return dataset;
 }
 
 void ParallelizeTreeVisitor::apply( xdm::UniformDataItem& item ) {
   xdm::RefPtr< xdm::Dataset > itemDataset = item.dataset();
-  xdm::RefPtr< MpiDatasetProxy > proxy( new MpiDatasetProxy(
-    MPI_COMM_WORLD, itemDataset, mBufferSize ) );
-  item.setDataset( proxy );
+
+#ifdef XDM_COMM_PARALLEL_HDF
+  // HDF datasets can do their own parallel IO, so they don't need a proxy.
+  if ( mUseCollectiveHdf ) {
+    if ( dynamic_cast< xdmHdf::ParallelHdfDataset* >( itemDataset.get() ) ) {
+      return;
+    }
+    xdmHdf::HdfDataset* hdfDataset =
+      dynamic_cast< xdmHdf::HdfDataset* >( itemDataset.get() );
+    if ( hdfDataset ) {
+      item.setDataset( xdm::makeRefPtr(
+        new xdmHdf::ParallelHdfDataset( *hdfDataset, mCommunicator ) ) );
+      return;
+    }
+  }
+#endif
+
+  // Without aggregator groups, everything goes to rank 0 of the communicator.
+  if ( mAggregatorCommunicator == MPI_COMM_NULL ) {
+    item.setDataset( xdm::makeRefPtr( new MpiDatasetProxy(
+      mCommunicator, itemDataset, mBufferSize, mNumberOfBuffers ) ) );
+    return;
+  }
+
+  item.setDataset( xdm::makeRefPtr( new MpiDatasetProxy(
+    mAggregatorCommunicator,
+    aggregatorDataset( itemDataset, mAggregatorGroup, mAggregatorsCommunicator ),
+    mBufferSize,
+    mNumberOfBuffers ) ) );
 }
 
 } // namespace xdmComm
-
@@ -21,23 +21,116 @@
 #ifndef xdmComm_ParallelizeTreeVisitor_hpp
 #define xdmComm_ParallelizeTreeVisitor_hpp
 
+#include <xdmComm/FileTurn.hpp>
+
 #include <xdm/ItemVisitor.hpp>
+#include <xdm/RefPtr.hpp>
 
+#include <mpi.h>
 
+namespace xdm {
+  class Dataset;
+}
 
 namespace xdmComm {
 
 /// Tree operation that replaces any datasets held by a UniformDataItem with an
 /// MpiDatasetProxy to handle communication between processes.
+///
+/// By default, every process sends its data to rank 0 of the communicator. For
+/// large process counts, the processes can instead be split into groups that
+/// each send their data to their own aggregator, the lowest rank in the group,
+/// with setNumberOfAggregators or setAggregatorPerNode. Each aggregator writes
+/// the dataset returned by aggregatorDataset for its group. The aggregators
+/// take turns writing HDF datasets, so the data from every group ends up in the
+/// file that the metadata refers to.
+///
+/// If collective HDF IO is enabled and the library was built against an HDF5
+/// with MPI-IO support, HDF datasets are instead replaced by an
+/// xdmHdf::ParallelHdfDataset so that every process writes its own portion of
+/// the file directly.
 class ParallelizeTreeVisitor : public xdm::ItemVisitor {
 private:
+  MPI_Comm mCommunicator;
+  MPI_Comm mAggregatorCommunicator;
+  // The aggregators of all groups, in group order. Null on other processes.
+  MPI_Comm mAggregatorsCommunicator;
+  // The order in which the aggregators write shared files.
+  xdm::RefPtr< FileTurn > mFileTurn;
+  int mAggregatorGroup;
+  int mNumberOfAggregators;
   size_t mBufferSize;
+  size_t mNumberOfBuffers;
+  bool mUseCollectiveHdf;
+
+  // The visitor owns its aggregator communicator, so it cannot be copied.
+  ParallelizeTreeVisitor( const ParallelizeTreeVisitor& );
+  ParallelizeTreeVisitor& operator=( const ParallelizeTreeVisitor& );
+
+  // Take ownership of a communicator for the group of processes this process
+  // belongs to and number the groups in order of their lowest rank.
+  void setAggregatorCommunicator( MPI_Comm group );
+  void freeAggregatorCommunicator();
 
 public:
-  ParallelizeTreeVisitor( size_t bufferSize );
+  /// Constructor takes the communication buffer configuration for the
+  /// MpiDatasetProxy objects it creates. The proxies communicate over
+  /// MPI_COMM_WORLD.
+  /// @param bufferSize Suggested size for each communication buffer.
+  /// @param numberOfBuffers Number of communication buffers per dataset. More
+  /// than one buffer enables non-blocking communication.
+  ParallelizeTreeVisitor( size_t bufferSize, size_t numberOfBuffers = 1 );
+
+  /// Constructor for proxies that communicate over the given communicator.
+  /// @see ParallelizeTreeVisitor( size_t, size_t )
+  ParallelizeTreeVisitor(
+    MPI_Comm communicator,
+    size_t bufferSize,
+    size_t numberOfBuffers = 1 );
+
   virtual ~ParallelizeTreeVisitor();
 
+  /// Split the processes into the given number of groups of consecutive ranks,
+  /// each with its own aggregator. This is collective over the communicator.
+  /// @pre 0 < aggregators <= the size of the communicator.
+  void setNumberOfAggregators( int aggregators );
+
+  /// Split the processes into one group per shared memory node, so that data
+  /// only leaves a node once it has been aggregated. This is collective over
+  /// the communicator. Without MPI-3 support, this uses a single aggregator.
+  void setAggregatorPerNode();
+
+  /// Get the number of aggregator groups.
+  int numberOfAggregators() const;
+  /// Get the index of the aggregator group this process belongs to.
+  int aggregatorGroup() const;
+
+  /// Choose to write HDF datasets collectively with MPI-IO rather than sending
+  /// all data to an aggregator. If collective HDF IO is not available, datasets
+  /// are wrapped in an MpiDatasetProxy as usual.
+  /// @see collectiveHdfAvailable
+  void setUseCollectiveHdf( bool value );
+  /// Determine if collective HDF IO was requested.
+  bool useCollectiveHdf() const;
+
+  /// Determine if the library was built with collective HDF IO support.
+  static bool collectiveHdfAvailable();
+
   virtual void apply( xdm::UniformDataItem& item );
+
+protected:
+  /// Get the dataset that the aggregator of a group writes. When there is more
+  /// than one group, each HDF dataset is wrapped in a SequentialHdfDataset so
+  /// that the aggregators take turns writing their regions of the same file.
+  /// All of these datasets share one turn order, which the visitor takes back
+  /// when it is destroyed, so the visitor must outlive the writes. Other datasets are used unchanged. Override this to route the groups
+  /// differently.
+  /// @param aggregators Communicator of the aggregators of all groups, or
+  /// MPI_COMM_NULL on processes that are not aggregators.
+  virtual xdm::RefPtr< xdm::Dataset > aggregatorDataset(
+    xdm::RefPtr< xdm::Dataset > dataset,
+    int group,
+    MPI_Comm aggregators );
 };
 
 } // namespace xdmComm
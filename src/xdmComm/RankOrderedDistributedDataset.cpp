@@ -25,21 +25,23 @@
 #include <xdm/DataSelection.hpp>
 #include <xdm/DataSelectionVisitor.hpp>
 #include <xdm/HyperslabDataSelection.hpp>
-#include <xdm/StaticAssert.hpp>
+#include <xdm/ThrowMacro.hpp>
 
 #include <algorithm>
-
-#include <climits>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
 
 namespace xdmComm {
 
 namespace {
   // SelectionVisitor that turns the different selection types into coordinate
-  // or hyperslab selections with an offset in the first dimension.
+  // or hyperslab selections with an offset in each dimension.
   class OffsetSelectionVisitor : public xdm::DataSelectionVisitor {
   public:
     OffsetSelectionVisitor(
-      xdm::DataShape<>::size_type offset,
+      const xdm::DataShape<>& offset,
       const xdm::DataShape<>& shape ) :
       xdm::DataSelectionVisitor(),
       mOffset( offset ),
@@ -49,47 +51,53 @@ namespace {
     virtual ~OffsetSelectionVisitor() {}
 
     // An AllDataSelection is converted to a hyperslab data selection with a
-    // start of offset in the first dimension, 0 in all others, a stride of 1 in
-    // all dimensions, and a count to match the number of elements in all
-    // dimensions.
+    // start of offset, a stride of 1 in all dimensions, and a count to match
+    // the number of elements in all dimensions.
     virtual void apply( const xdm::AllDataSelection& ) {
       xdm::HyperSlab<> resultSlab( mShape );
-      xdm::HyperSlab<>::iterator start = resultSlab.beginStart();
-      *start = mOffset;
-      std::fill( ++start, resultSlab.endStart(), 0 );
+      std::copy( mOffset.begin(), mOffset.end(), resultSlab.beginStart() );
       std::fill( resultSlab.beginStride(), resultSlab.endStride(), 1 );
       std::copy( mShape.begin(), mShape.end(), resultSlab.beginCount() );
       mResult = xdm::makeRefPtr( new xdm::HyperslabDataSelection( resultSlab ) );
     }
 
-    // A HyperslabDataSelection is left alone, except the start location in the
-    // first dimension is set to offset.
+    // A HyperslabDataSelection is left alone, except the start location in
+    // each dimension is moved by the offset.
     virtual void apply( const xdm::HyperslabDataSelection& selection ) {
       xdm::HyperSlab<> resultSlab = selection.hyperslab();
-      resultSlab.setStart( 0, mOffset );
+      for ( xdm::DataShape<>::size_type dim = 0; dim < mOffset.rank(); ++dim ) {
+        resultSlab.setStart( dim, resultSlab.start( dim ) + mOffset[dim] );
+      }
       mResult = xdm::makeRefPtr( new xdm::HyperslabDataSelection( resultSlab ) );
     }
 
-/*
-    // A coordinate data selection gets the offset added to the first component
-    // of each vertex.
+    // A coordinate data selection gets the offset added to each vertex. The
+    // input coordinates are shared with the caller, so the result is built
+    // from a copy of them.
     virtual void apply( const xdm::CoordinateDataSelection& selection ) {
-      // make a shallow copy of the coordinate values.
-      xdm::CoordinateArray<> resultCoordinates(
-        const_cast< xdm::CoordinateArray<>& >( selection.coordinates() ) );
-      size_t * begin = resultCoordinates.values();
-      size_t * end = begin + resultCoordinates.numberOfElements();
-      for ( size_t * p = begin; p < end; p += resultCoordinates.rank() ) {
-        *p += mOffset;
+      const xdm::CoordinateArray<>& coordinates = selection.coordinates();
+      std::vector< xdm::CoordinateArray<>::size_type > values(
+        coordinates.values(),
+        coordinates.values() + 
+          coordinates.rank() * coordinates.numberOfElements() );
+      for ( size_t i = 0; i < values.size(); i += coordinates.rank() ) {
+        for ( size_t dim = 0; dim < coordinates.rank(); ++dim ) {
+          values[i + dim] += mOffset[dim];
+        }
       }
-      mResult = xdm::makeRefPtr( new xdm::CoordinateDataSelection( resultCoordinates ) );
+      xdm::RefPtr< xdm::CoordinateDataSelection > result(
+        new xdm::CoordinateDataSelection );
+      result->copyCoordinates( xdm::CoordinateArray<>( 
+        values.empty() ? 0 : &values[0],
+        coordinates.rank(),
+        coordinates.numberOfElements() ) );
+      mResult = result;
     }
-*/
 
     xdm::RefPtr< xdm::DataSelection > result() { return mResult; }
 
   private:
-    xdm::DataShape<>::size_type mOffset;
+    xdm::DataShape<> mOffset;
     xdm::DataShape<> mShape;
     xdm::RefPtr< xdm::DataSelection > mResult;
   };
@@ -100,11 +108,85 @@ RankOrderedDistributedDataset::RankOrderedDistributedDataset(
   MPI_Comm communicator ) :
   xdm::ProxyDataset( dataset ),
   mCommunicator( communicator ),
-  mStartLocation( 0 ),
+  mProcessGrid(),
+  mGridCoordinates(),
+  mLineCommunicators(),
+  mStartLocation(),
+  mDataShape() {
+
+  // All of the processes are lined up along the first dimension, so the
+  // communicator itself connects them.
+  int processes;
+  MPI_Comm_size( mCommunicator, &processes );
+  int rank;
+  MPI_Comm_rank( mCommunicator, &rank );
+  mProcessGrid.push_back( processes );
+  mGridCoordinates.push_back( rank );
+  mLineCommunicators.push_back( mCommunicator );
+}
+
+RankOrderedDistributedDataset::RankOrderedDistributedDataset(
+  xdm::RefPtr< xdm::Dataset > dataset,
+  MPI_Comm communicator,
+  const std::vector< int >& processGrid ) :
+  xdm::ProxyDataset( dataset ),
+  mCommunicator( communicator ),
+  mProcessGrid( processGrid ),
+  mGridCoordinates(),
+  mLineCommunicators(),
+  mStartLocation(),
   mDataShape() {
+
+  int processes;
+  MPI_Comm_size( mCommunicator, &processes );
+  int gridProcesses = std::accumulate( mProcessGrid.begin(), mProcessGrid.end(),
+    1, std::multiplies< int >() );
+  if ( mProcessGrid.empty() || gridProcesses != processes ) {
+    XDM_THROW( std::invalid_argument(
+      "The process grid does not match the size of the communicator." ) );
+  }
+  createLineCommunicators();
 }
 
 RankOrderedDistributedDataset::~RankOrderedDistributedDataset() {
+  int finalized = 0;
+  MPI_Finalized( &finalized );
+  for ( std::size_t dim = 0; dim < mLineCommunicators.size(); ++dim ) {
+    MPI_Comm& line = mLineCommunicators[dim];
+    if ( !finalized && line != MPI_COMM_NULL && line != mCommunicator ) {
+      MPI_Comm_free( &line );
+    }
+  }
+}
+
+void RankOrderedDistributedDataset::createLineCommunicators() {
+  int rank;
+  MPI_Comm_rank( mCommunicator, &rank );
+
+  // Rank to grid coordinates in row major order.
+  std::size_t gridRank = mProcessGrid.size();
+  mGridCoordinates.resize( gridRank );
+  int remainder = rank;
+  for ( std::size_t dim = gridRank; dim > 0; --dim ) {
+    mGridCoordinates[dim - 1] = remainder % mProcessGrid[dim - 1];
+    remainder /= mProcessGrid[dim - 1];
+  }
+
+  // The processes along a decomposed dimension share all of their other grid
+  // coordinates, so the grid index with this dimension's coordinate zeroed
+  // identifies the line. Ordering by the coordinate keeps the scan in order.
+  mLineCommunicators.assign( gridRank, MPI_COMM_NULL );
+  for ( std::size_t dim = 0; dim < gridRank; ++dim ) {
+    if ( mProcessGrid[dim] == 1 ) {
+      continue;
+    }
+    int color = 0;
+    for ( std::size_t d = 0; d < gridRank; ++d ) {
+      color = color * mProcessGrid[d] + ( d == dim ? 0 : mGridCoordinates[d] );
+    }
+    MPI_Comm_split( mCommunicator, color, mGridCoordinates[dim],
+      &mLineCommunicators[dim] );
+  }
 }
 
 xdm::DataShape<> RankOrderedDistributedDataset::initializeImplementation(
@@ -112,69 +194,56 @@ xdm::DataShape<> RankOrderedDistributedDataset::initializeImplementation(
   const xdm::DataShape<> &shape,
   const xdm::Dataset::InitializeMode &mode )
 {
-  int processes;
-  MPI_Comm_size( mCommunicator, &processes );
-  int rank;
-  MPI_Comm_rank( mCommunicator, &rank );
+  for ( std::size_t dim = shape.rank(); dim < mProcessGrid.size(); ++dim ) {
+    if ( mProcessGrid[dim] != 1 ) {
+      XDM_THROW( std::invalid_argument(
+        "The data has fewer dimensions than the process grid decomposes." ) );
+    }
+  }
 
   // save the original shape for use later.
   mDataShape = shape;
+  mStartLocation = xdm::DataShape<>( shape.rank() );
 
-  // allocate a working buffer for the communication.
-  typedef std::vector< xdm::DataShape<>::size_type > SizeVector;
-  SizeVector commBuffer( processes, 0 );
-
-  // The gather and scatter calls below assume that a byte and a char are the
-  // same size. Fail to compile if they aren't.
-  XDM_STATIC_ASSERT( CHAR_BIT == 8 );
-
-  // Gather the first dimension from all participating processes.
-  mStartLocation = shape[0];
-  MPI_Gather(
-    &mStartLocation,
-    sizeof( xdm::DataShape<>::size_type ),
-    MPI_BYTE,
-    &commBuffer[0],
-    sizeof( xdm::DataShape<>::size_type ),
-    MPI_BYTE,
-    0,
-    mCommunicator );
-
-  // Rank 0 now has the start location for all processes. Compute a running sum
-  // to determine each process' starting location from those before it.
-  xdm::DataShape<>::size_type sum( 0 );
-  for ( SizeVector::iterator p = commBuffer.begin(); p != commBuffer.end(); ++p ) {
-    xdm::DataShape<>::size_type tmp = *p;
-    *p = sum;
-    sum += tmp;
+  // Each process' start location along a decomposed dimension is the sum of
+  // the sizes of the processes before it on its line of the grid. The extent
+  // of the dimension is the sum along any one line, so only the line through
+  // the origin of the grid contributes to the reduction below.
+  const std::size_t decomposedRank = std::min( shape.rank(), mLineCommunicators.size() );
+  std::vector< unsigned long long > extents( decomposedRank, 0 );
+  for ( std::size_t dim = 0; dim < decomposedRank; ++dim ) {
+    if ( mLineCommunicators[dim] == MPI_COMM_NULL ) {
+      continue;
+    }
+    unsigned long long size = shape[dim];
+    unsigned long long start = 0;
+    MPI_Exscan( &size, &start, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM,
+      mLineCommunicators[dim] );
+    // The scan result is undefined on the first process of the line.
+    mStartLocation[dim] = ( mGridCoordinates[dim] == 0 ) ? 0 : start;
+
+    bool onOriginLine = true;
+    for ( std::size_t d = 0; d < mGridCoordinates.size(); ++d ) {
+      if ( d != dim && mGridCoordinates[d] != 0 ) {
+        onOriginLine = false;
+      }
+    }
+    if ( onOriginLine ) {
+      extents[dim] = size;
+    }
+  }
+  if ( decomposedRank > 0 ) {
+    MPI_Allreduce( MPI_IN_PLACE, &extents[0], (int)decomposedRank,
+      MPI_UNSIGNED_LONG_LONG, MPI_SUM, mCommunicator );
   }
 
-  // Now the comm buffer has the start location for each process at the index
-  // specified by the process rank. Scatter back to all processes and store
-  // the result for this process in the start location member variable for use
-  // during serialization.
-  MPI_Scatter(
-    &commBuffer[0],
-    sizeof( xdm::DataShape<>::size_type ),
-    MPI_BYTE,
-    &mStartLocation,
-    sizeof( xdm::DataShape<>::size_type ),
-    MPI_BYTE,
-    0,
-    mCommunicator );
-
-  // Rank 0 is the only one to contain the complete sum, broadcast this
-  // information to everyone else so they can call initialize with the correct
-  // dimensions.
-  MPI_Bcast(
-    &sum,
-    sizeof( xdm::DataShape<>::size_type ),
-    MPI_BYTE,
-    0,
-    mCommunicator );
   // initialize with modified dimensions.
   xdm::DataShape<> expandedBounds( shape );
-  expandedBounds[0] = sum;
+  for ( std::size_t dim = 0; dim < decomposedRank; ++dim ) {
+    if ( mLineCommunicators[dim] != MPI_COMM_NULL ) {
+      expandedBounds[dim] = extents[dim];
+    }
+  }
   return xdm::ProxyDataset::initializeImplementation( type, expandedBounds, mode );
 }
 
@@ -23,8 +23,9 @@
 
 #include <xdm/ProxyDataset.hpp>
 
-#include <mpi.h>
+#include <vector>
 
+#include <mpi.h>
 
 
 namespace xdmComm {
@@ -39,22 +40,45 @@ namespace xdmComm {
 /// communicator has 5 processes, then the resultant dataset will be 5*n x 3
 /// elements in size with rank 0's data occupying the first n elements, rank 1's
 /// data occupying the next n elements and so on.
+///
+/// The data can also be arranged as a block decomposition along any subset of
+/// the dimensions by providing a process grid. For example, with a process grid
+/// of 2 x 2 and four processes writing n x m blocks, the resultant dataset will
+/// be 2*n x 2*m elements in size. Ranks are laid out on the process grid in row
+/// major order, as MPI_Cart_create does without reordering, so the last
+/// dimension varies fastest: rank 1 holds the block at 0 x m and rank 2 holds
+/// the block at n x 0.
 class RankOrderedDistributedDataset : public xdm::ProxyDataset {
 public:
+  /// Arrange the data from each process contiguously in the first dimension.
   RankOrderedDistributedDataset(
     xdm::RefPtr< xdm::Dataset > dataset,
     MPI_Comm communicator );
+
+  /// Arrange the data from each process as a block decomposition.
+  /// @param processGrid The number of processes along each dimension of the
+  ///        data. A dimension with a single process is not decomposed, and
+  ///        missing trailing dimensions are treated as 1. The product of the
+  ///        entries must equal the size of the communicator.
+  /// This constructor is collective over the communicator.
+  /// @throws std::invalid_argument if the grid does not match the communicator.
+  RankOrderedDistributedDataset(
+    xdm::RefPtr< xdm::Dataset > dataset,
+    MPI_Comm communicator,
+    const std::vector< int >& processGrid );
+
   virtual ~RankOrderedDistributedDataset();
 
 protected:
 
   /// Initialize determines the shape that all participating processes are
-  /// requesting and expands the first dimension of the inner dataset to hold
-  /// each one of them.
+  /// requesting and expands the decomposed dimensions of the inner dataset to
+  /// hold each one of them. Each process' offset is computed with a single
+  /// MPI_Exscan per decomposed dimension.
   ///
   /// All processes must be requesting the same type of access, and the
-  /// data shape for all processes must match in every dimension except the
-  /// first.
+  /// data shape for all processes in the same row of the process grid must
+  /// match in every dimension except the decomposed ones.
   virtual xdm::DataShape<> initializeImplementation(
     xdm::primitiveType::Value type,
     const xdm::DataShape<>& shape,
@@ -62,15 +86,22 @@ protected:
 
   /// Serialize uses the information that was distributed to all processes
   /// during initialization to convert the input selection to a hyperslab or
-  /// coordinate selection that will offset the first dimension so that all
-  /// processes write their data in rank order.
+  /// coordinate selection that will offset the decomposed dimensions so that
+  /// all processes write their data in rank order.
   virtual void serializeImplementation(
     const xdm::StructuredArray* data,
     const xdm::DataSelectionMap& selectionMap );
 
 private:
+  // Create the communicators that connect the processes along each decomposed
+  // dimension of the process grid.
+  void createLineCommunicators();
+
   MPI_Comm mCommunicator;
-  xdm::DataShape<>::size_type mStartLocation;
+  std::vector< int > mProcessGrid;
+  std::vector< int > mGridCoordinates;
+  std::vector< MPI_Comm > mLineCommunicators;
+  xdm::DataShape<> mStartLocation;
   xdm::DataShape<> mDataShape;
 };
 
@@ -0,0 +1,60 @@
+//==============================================================================
+// This software developed by Stellar Science Ltd Co and the U.S. Government.
+// Copyright (C) 2009 Stellar Science. Government-purpose rights granted.
+//
+// This file is part of XDM
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//------------------------------------------------------------------------------
+#include <xdmComm/SequentialHdfDataset.hpp>
+
+#include <xdmHdf/HdfDataset.hpp>
+
+namespace xdmComm {
+
+SequentialHdfDataset::SequentialHdfDataset(
+  xdm::RefPtr< xdmHdf::HdfDataset > dataset,
+  xdm::RefPtr< FileTurn > turn ) :
+  xdm::ProxyDataset( dataset ),
+  mHdfDataset( dataset ),
+  mTurn( turn ) {
+}
+
+SequentialHdfDataset::~SequentialHdfDataset() {
+}
+
+xdm::DataShape<> SequentialHdfDataset::initializeImplementation(
+  xdm::primitiveType::Value type,
+  const xdm::DataShape<>& shape,
+  const xdm::Dataset::InitializeMode& mode ) {
+
+  mTurn->wait();
+
+  // Creating the dataset again would erase what earlier ranks wrote.
+  xdm::Dataset::InitializeMode turnMode = mode;
+  if ( !mTurn->first() && mode == xdm::Dataset::kCreate ) {
+    turnMode = xdm::Dataset::kModify;
+  }
+
+  return xdm::ProxyDataset::initializeImplementation( type, shape, turnMode );
+}
+
+void SequentialHdfDataset::finalizeImplementation() {
+  xdm::ProxyDataset::finalizeImplementation();
+  mHdfDataset->close();
+  mTurn->pass();
+}
+
+} // namespace xdmComm
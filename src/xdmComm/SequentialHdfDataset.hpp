@@ -0,0 +1,78 @@
+//==============================================================================
+// This software developed by Stellar Science Ltd Co and the U.S. Government.
+// Copyright (C) 2009 Stellar Science. Government-purpose rights granted.
+//
+// This file is part of XDM
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//------------------------------------------------------------------------------
+#ifndef xdmComm_SequentialHdfDataset_hpp
+#define xdmComm_SequentialHdfDataset_hpp
+
+#include <xdmComm/FileTurn.hpp>
+
+#include <xdm/ProxyDataset.hpp>
+#include <xdm/RefPtr.hpp>
+
+namespace xdmHdf {
+  class HdfDataset;
+}
+
+namespace xdmComm {
+
+/// Dataset proxy that lets the processes of a communicator write to the same
+/// HDF dataset without MPI-IO by taking turns in rank order. Each process opens
+/// the file when its turn starts and closes it again when its turn ends, so
+/// that a serial HDF5 library never has the file open in two processes at
+/// once. The first process initializes the dataset with the requested mode and
+/// later processes modify it, so the processes must write disjoint regions.
+///
+/// The turn goes around the communicator as a ring shared by every dataset
+/// that writes through it. A process passes the turn on as soon as it has
+/// closed the file and does not wait for the others, so rank 0 can gather the
+/// next dataset while the other ranks are still writing this one. All
+/// processes in the communicator must initialize and finalize their proxies
+/// in the same order.
+class SequentialHdfDataset : public xdm::ProxyDataset {
+public:
+  /// @param dataset The HDF dataset that all processes share.
+  /// @param turn The turn order of the processes that write the dataset.
+  SequentialHdfDataset(
+    xdm::RefPtr< xdmHdf::HdfDataset > dataset,
+    xdm::RefPtr< FileTurn > turn );
+  virtual ~SequentialHdfDataset();
+
+protected:
+  /// Wait for this process's turn with the file, then initialize the inner
+  /// dataset. Ranks other than 0 open an existing dataset in kModify mode
+  /// rather than creating it again.
+  virtual xdm::DataShape<> initializeImplementation(
+    xdm::primitiveType::Value type,
+    const xdm::DataShape<>& shape,
+    const xdm::Dataset::InitializeMode& mode );
+
+  /// Finalize and close the inner dataset, then pass the turn to the next
+  /// rank.
+  virtual void finalizeImplementation();
+
+private:
+  xdm::RefPtr< xdmHdf::HdfDataset > mHdfDataset;
+  xdm::RefPtr< FileTurn > mTurn;
+};
+
+} // namespace xdmComm
+
+#endif // xdmComm_SequentialHdfDataset_hpp
+
@@ -133,5 +133,48 @@ BOOST_AUTO_TEST_CASE( overflow ) {
   }
 }
 
+BOOST_AUTO_TEST_CASE( nonBlocking ) {
+  xdmComm::BarrierOnExit barrier( MPI_COMM_WORLD );
+
+  // Use a 3 byte buffer and rotate through 2 of them so that a single message
+  // is spread over several sends that are in flight at the same time.
+  xdmComm::CoalescingStreamBuffer test( 3, MPI_COMM_WORLD, 2 );
+  BOOST_CHECK_EQUAL( 2, test.numberOfBuffers() );
+  std::vector< int > result( globalFixture.processes() * 4, 0 );
+
+  // each process will send an array of ints with 4 copies of it's rank
+  int message[4];
+  std::fill( message, message + 4, globalFixture.localRank() );
+
+  if ( globalFixture.localRank() != 0 ) {
+    test.sputn( reinterpret_cast< char* >( message ), sizeof( int ) * 4 );
+    test.pubsync();
+    test.waitAll();
+  } else {
+    std::copy( message, message + 4, result.begin() );
+
+    int received = 1;
+    while ( received < globalFixture.processes() ) {
+      while ( test.poll() ) {
+        test.pubsync();
+        test.sgetn( reinterpret_cast< char* >( message ), sizeof( int ) * 4 );
+        int source = test.currentSource();
+        std::copy( message, message + 4, result.begin() + 4 * source );
+        received++;
+      }
+    }
+
+    std::vector< int > answer( globalFixture.processes() * 4 );
+    for ( int i = 0; i < globalFixture.processes(); i++ ) {
+      for ( int j = 4*i; j < 4*i + 4; j++ ) {
+        answer[j] = i;
+      }
+    }
+    BOOST_CHECK_EQUAL_COLLECTIONS( answer.begin(), answer.end(),
+      result.begin(), result.end() );
+
+  }
+}
+
 } // namespace
 
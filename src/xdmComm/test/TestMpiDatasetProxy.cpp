@@ -27,6 +27,7 @@
 
 #include <xdm/AllDataSelection.hpp>
 #include <xdm/ContiguousArray.hpp>
+#include <xdm/CoordinateDataSelection.hpp>
 #include <xdm/DataSelectionVisitor.hpp>
 #include <xdm/DataShape.hpp>
 #include <xdm/HyperslabDataSelection.hpp>
@@ -55,6 +56,11 @@ public:
     assert( s.hyperslab().shape().rank() == 1 );
     startIndex = s.hyperslab().start( 0 );
   }
+
+  void apply( const xdm::CoordinateDataSelection& s ) {
+    assert( s.coordinates().rank() == 1 );
+    startIndex = s.coordinates().values()[0];
+  }
 };
 
 BOOST_AUTO_TEST_CASE( TestSelectionVisitorApplyHyperslab ) {
@@ -131,7 +137,10 @@ BOOST_AUTO_TEST_CASE( mpi ) {
   }
 }
 
-BOOST_AUTO_TEST_CASE( coalesce ) {
+// Write each process' rank to the rank'th location of a dataset through an
+// MpiDatasetProxy with the given number of communication buffers. The location
+// is selected with either a hyperslab or a single point.
+void checkCoalesce( size_t numberOfBuffers, bool selectPoint = false ) {
   // get process info
   int processes;
   MPI_Comm_size( MPI_COMM_WORLD, &processes );
@@ -142,7 +151,7 @@ BOOST_AUTO_TEST_CASE( coalesce ) {
   // communication
   xdm::RefPtr< TestDataset > testDataset( new TestDataset );
   xdm::RefPtr< xdm::Dataset > dataset( new xdmComm::MpiDatasetProxy(
-    MPI_COMM_WORLD, testDataset, 3 ) );
+    MPI_COMM_WORLD, testDataset, 3, numberOfBuffers ) );
 
   // set up the data selection for the local process.  We select the hyperslab
   // consisting of one element which starts at the global array location
@@ -154,6 +163,11 @@ BOOST_AUTO_TEST_CASE( coalesce ) {
   slab.setCount( 0, 1 );
   xdm::RefPtr< xdm::DataSelection > localSelection(
     new xdm::HyperslabDataSelection( slab ) );
+  size_t point = rank;
+  if ( selectPoint ) {
+    localSelection = xdm::makeRefPtr( new xdm::CoordinateDataSelection(
+      xdm::CoordinateArray<>( &point, 1, 1 ) ) );
+  }
   // define the selection map to select all the input data (for this test case a
   // single integer) and map it to the rank'th location in the global structure
   xdm::DataSelectionMap map(
@@ -180,5 +194,128 @@ BOOST_AUTO_TEST_CASE( coalesce ) {
   }
 }
 
+BOOST_AUTO_TEST_CASE( coalesce ) {
+  checkCoalesce( 1 );
+}
+
+BOOST_AUTO_TEST_CASE( coalesceNonBlocking ) {
+  // Try both double buffering and more than two rotating buffers.
+  checkCoalesce( 2 );
+  checkCoalesce( 3 );
+}
+
+BOOST_AUTO_TEST_CASE( coalesceCoordinates ) {
+  checkCoalesce( 1, true );
+  checkCoalesce( 2, true );
+}
+
+class SlabSelectionVisitor : public xdm::DataSelectionVisitor {
+public:
+  xdm::HyperSlab<> slab;
+
+  void apply( const xdm::HyperslabDataSelection& s ) {
+    slab = s.hyperslab();
+  }
+};
+
+// Dataset that writes contiguous hyperslabs of a 2D array of ints and records
+// the largest array it was handed and how many writes it saw.
+class SlabDataset : public xdm::Dataset {
+public:
+  std::vector< int > mValues;
+  size_t mColumns;
+  size_t mLargestArray;
+  size_t mWrites;
+
+  SlabDataset() : mValues(), mColumns( 0 ), mLargestArray( 0 ), mWrites( 0 ) {}
+
+  virtual const char* format() { return "SlabDataset"; }
+  virtual void writeTextContent( xdm::XmlTextContent& ) {}
+
+  virtual xdm::DataShape<> initializeImplementation(
+    xdm::primitiveType::Value,
+    const xdm::DataShape<>& shape,
+    const xdm::Dataset::InitializeMode& )
+  {
+    mColumns = shape[1];
+    mValues.resize( shape[0] * shape[1] );
+    return shape;
+  }
+
+  virtual void serializeImplementation(
+    const xdm::StructuredArray* data,
+    const xdm::DataSelectionMap& selectionMap )
+  {
+    // selections received from other processes are proxies, so visit them.
+    SlabSelectionVisitor rangeVisitor;
+    selectionMap.range()->accept( rangeVisitor );
+    const xdm::HyperSlab<>& slab = rangeVisitor.slab;
+    BOOST_REQUIRE_EQUAL( slab.count( 0 ) * slab.count( 1 ), data->size() );
+
+    const int* values = reinterpret_cast< const int* >( data->data() );
+    for ( size_t row = 0; row < slab.count( 0 ); ++row ) {
+      std::copy( values + row * slab.count( 1 ), values + ( row + 1 ) * slab.count( 1 ),
+        &mValues[( slab.start( 0 ) + row ) * mColumns + slab.start( 1 )] );
+    }
+    mLargestArray = std::max( mLargestArray, data->size() );
+    ++mWrites;
+  }
+
+  virtual void deserializeImplementation(
+    xdm::StructuredArray*,
+    const xdm::DataSelectionMap& ) {
+  }
+
+  virtual void finalizeImplementation() {}
+};
+
+BOOST_AUTO_TEST_CASE( streamInPieces ) {
+  int processes;
+  MPI_Comm_size( MPI_COMM_WORLD, &processes );
+  int rank;
+  MPI_Comm_rank( MPI_COMM_WORLD, &rank );
+
+  // each process writes 4 rows of 3 columns, sent one row per message.
+  const size_t rows = 4;
+  const size_t columns = 3;
+  xdm::RefPtr< SlabDataset > testDataset( new SlabDataset );
+  xdm::RefPtr< xdmComm::MpiDatasetProxy > dataset( new xdmComm::MpiDatasetProxy(
+    MPI_COMM_WORLD, testDataset, 64, 2 ) );
+  dataset->setPieceSize( columns * sizeof( int ) );
+  BOOST_CHECK_EQUAL( columns * sizeof( int ), dataset->pieceSize() );
+
+  xdm::HyperSlab<> slab( xdm::makeShape( processes * rows, columns ) );
+  slab.setStart( 0, rank * rows );
+  slab.setStart( 1, 0 );
+  slab.setStride( 0, 1 );
+  slab.setStride( 1, 1 );
+  slab.setCount( 0, rows );
+  slab.setCount( 1, columns );
+  xdm::DataSelectionMap map(
+    xdm::makeRefPtr( new xdm::AllDataSelection ),
+    xdm::makeRefPtr( new xdm::HyperslabDataSelection( slab ) ) );
+
+  std::vector< int > values( rows * columns );
+  for ( size_t i = 0; i < values.size(); ++i ) {
+    values[i] = rank * rows * columns + i;
+  }
+  xdm::ContiguousArray< int > array( &values[0], values.size() );
+
+  dataset->initialize( xdm::primitiveType::kInt,
+    xdm::makeShape( processes * rows, columns ), xdm::Dataset::kCreate );
+  dataset->serialize( &array, map );
+  dataset->finalize();
+
+  if ( rank == 0 ) {
+    BOOST_REQUIRE_EQUAL( processes * rows * columns, testDataset->mValues.size() );
+    for ( size_t i = 0; i < testDataset->mValues.size(); ++i ) {
+      BOOST_CHECK_EQUAL( i, testDataset->mValues[i] );
+    }
+    // rank 0 writes its own array whole, everything else arrives a row at a time.
+    BOOST_CHECK_EQUAL( rows * columns, testDataset->mLargestArray );
+    BOOST_CHECK_EQUAL( 1 + ( processes - 1 ) * rows, testDataset->mWrites );
+  }
+}
+
 } // namespace
 
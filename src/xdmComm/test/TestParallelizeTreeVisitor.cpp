@@ -0,0 +1,145 @@
+//==============================================================================
+// This software developed by Stellar Science Ltd Co and the U.S. Government.
+// Copyright (C) 2009 Stellar Science. Government-purpose rights granted.
+//
+// This file is part of XDM
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//------------------------------------------------------------------------------
+#define BOOST_TEST_MODULE ParallelizeTreeVisitor
+#include <boost/test/unit_test.hpp>
+
+#include <xdmComm/ParallelizeTreeVisitor.hpp>
+
+#include <xdmComm/MpiDatasetProxy.hpp>
+#include <xdmComm/test/MpiTestFixture.hpp>
+
+#ifdef XDM_COMM_HDF
+#include <xdmHdf/HdfDataset.hpp>
+#endif
+
+#include <xdm/AllDataSelection.hpp>
+#include <xdm/ArrayAdapter.hpp>
+#include <xdm/DataSelectionMap.hpp>
+#include <xdm/FileSystem.hpp>
+#include <xdm/HyperslabDataSelection.hpp>
+#include <xdm/SerializeDataOperation.hpp>
+#include <xdm/UniformDataItem.hpp>
+#include <xdm/VectorStructuredArray.hpp>
+#include <xdm/XmlObject.hpp>
+#include <xdm/XmlTextContent.hpp>
+
+#include <algorithm>
+#include <string>
+
+#include <mpi.h>
+
+namespace {
+
+xdmComm::test::MpiTestFixture globalFixture;
+
+BOOST_AUTO_TEST_CASE( singleAggregator ) {
+  xdmComm::ParallelizeTreeVisitor visitor( MPI_COMM_WORLD, 1024 );
+  BOOST_CHECK_EQUAL( 1, visitor.numberOfAggregators() );
+  BOOST_CHECK_EQUAL( 0, visitor.aggregatorGroup() );
+}
+
+BOOST_AUTO_TEST_CASE( consecutiveRankGroups ) {
+  xdmComm::ParallelizeTreeVisitor visitor( MPI_COMM_WORLD, 1024 );
+  visitor.setNumberOfAggregators( 2 );
+  BOOST_CHECK_EQUAL( 2, visitor.numberOfAggregators() );
+  BOOST_CHECK_EQUAL(
+    globalFixture.localRank() * 2 / globalFixture.processes(),
+    visitor.aggregatorGroup() );
+
+  // going back to one group per process is allowed too.
+  visitor.setNumberOfAggregators( globalFixture.processes() );
+  BOOST_CHECK_EQUAL( globalFixture.processes(), visitor.numberOfAggregators() );
+  BOOST_CHECK_EQUAL( globalFixture.localRank(), visitor.aggregatorGroup() );
+}
+
+BOOST_AUTO_TEST_CASE( aggregatorPerNode ) {
+  xdmComm::ParallelizeTreeVisitor visitor( MPI_COMM_WORLD, 1024 );
+  visitor.setAggregatorPerNode();
+  BOOST_CHECK( visitor.numberOfAggregators() >= 1 );
+  BOOST_CHECK( visitor.aggregatorGroup() < visitor.numberOfAggregators() );
+}
+
+#ifdef XDM_COMM_HDF
+BOOST_AUTO_TEST_CASE( aggregatorsShareFile ) {
+  const char* kFile = "ParallelizeTreeVisitor.h5";
+  const int kColumns = 3;
+  if ( globalFixture.localRank() == 0 ) {
+    xdm::remove( xdm::FileSystemPath( kFile ) );
+  }
+  globalFixture.waitAll();
+
+  // Each process writes its own row of the dataset.
+  xdm::RefPtr< xdm::UniformDataItem > item( new xdm::UniformDataItem(
+    xdm::primitiveType::kInt,
+    xdm::makeShape( globalFixture.processes(), kColumns ) ) );
+  item->setDataset( xdm::makeRefPtr(
+    new xdmHdf::HdfDataset( kFile, xdmHdf::GroupPath(), "values" ) ) );
+  xdm::RefPtr< xdm::VectorStructuredArray< int > > row(
+    new xdm::VectorStructuredArray< int >( kColumns ) );
+  for ( int i = 0; i < kColumns; ++i ) {
+    (*row)[i] = globalFixture.localRank() * kColumns + i;
+  }
+  xdm::HyperSlab<> slab( xdm::makeShape( globalFixture.processes(), kColumns ) );
+  slab.setStart( 0, globalFixture.localRank() );
+  slab.setStart( 1, 0 );
+  std::fill( slab.beginStride(), slab.endStride(), 1 );
+  slab.setCount( 0, 1 );
+  slab.setCount( 1, kColumns );
+  xdm::RefPtr< xdm::ArrayAdapter > adapter( new xdm::ArrayAdapter( row ) );
+  adapter->setSelectionMap( xdm::DataSelectionMap(
+    xdm::makeRefPtr( new xdm::AllDataSelection ),
+    xdm::makeRefPtr( new xdm::HyperslabDataSelection( slab ) ) ) );
+  item->setData( adapter );
+
+  xdmComm::ParallelizeTreeVisitor visitor( MPI_COMM_WORLD, 1024 );
+  visitor.setNumberOfAggregators( 2 );
+  BOOST_REQUIRE_EQUAL( 2, visitor.numberOfAggregators() );
+  item->accept( visitor );
+
+  // Write two steps to check that the aggregators hand the file back in order.
+  for ( int step = 0; step < 2; ++step ) {
+    xdm::SerializeDataOperation serialize;
+    item->accept( serialize );
+  }
+  globalFixture.waitAll();
+
+  // The metadata written by rank 0 refers to a single file, so it must hold
+  // the data from every group.
+  if ( globalFixture.localRank() == 0 ) {
+    xdm::XmlTextContent text( xdm::makeRefPtr( new xdm::XmlObject ) );
+    item->dataset()->writeTextContent( text );
+    BOOST_CHECK_EQUAL( std::string( kFile ) + ":/values", text.contentLine( 0 ) );
+
+    xdm::VectorStructuredArray< int > result( globalFixture.processes() * kColumns );
+    xdmHdf::HdfDataset dataset( kFile, xdmHdf::GroupPath(), "values" );
+    dataset.initialize( xdm::primitiveType::kInt,
+      xdm::makeShape( globalFixture.processes(), kColumns ), xdm::Dataset::kRead );
+    dataset.deserialize( &result, xdm::DataSelectionMap() );
+    dataset.finalize();
+    for ( int i = 0; i < globalFixture.processes() * kColumns; ++i ) {
+      BOOST_CHECK_EQUAL( i, result[i] );
+    }
+  }
+  globalFixture.waitAll();
+}
+#endif
+
+} // namespace
@@ -25,12 +25,15 @@
 
 #include <xdmComm/test/MpiTestFixture.hpp>
 
+#include <xdm/CoordinateDataSelection.hpp>
 #include <xdm/DataShape.hpp>
 #include <xdm/HyperslabDataSelection.hpp>
 
 #include <mpi.h>
 
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace {
 
@@ -39,8 +42,10 @@ xdmComm::test::MpiTestFixture globalFixture;
 class TestDataset : public xdm::Dataset {
 public:
   std::string data;
+  xdm::DataShape<> initializedShape;
+  xdm::HyperSlab<> lastSlab;
 
-  TestDataset() : data() {}
+  TestDataset() : data(), initializedShape(), lastSlab() {}
   virtual ~TestDataset() {}
 
   virtual const char* format() { return "Test"; }
@@ -51,6 +56,7 @@ protected:
     xdm::primitiveType::Value type,
     const xdm::DataShape<> &shape,
     const xdm::Dataset::InitializeMode &mode ) {
+    initializedShape = shape;
     data.resize( shape[0] );
     std::fill( data.begin(), data.end(), 'x' );
     return xdm::DataShape<>();
@@ -62,9 +68,21 @@ protected:
 
     xdm::RefPtr< const xdm::DataSelection > disk( selectionMap.range() );
 
+    xdm::RefPtr< const xdm::CoordinateDataSelection > diskPoints
+      = xdm::dynamic_pointer_cast< const xdm::CoordinateDataSelection >( disk );
+    if ( diskPoints ) {
+      const xdm::CoordinateArray<>& points = diskPoints->coordinates();
+      BOOST_REQUIRE_EQUAL( 1, points.rank() );
+      for ( size_t i = 0; i < points.numberOfElements(); i++ ) {
+        data[points.values()[i]] = 'a';
+      }
+      return;
+    }
+
     xdm::RefPtr< const xdm::HyperslabDataSelection > diskSlab
       = xdm::dynamic_pointer_cast< const xdm::HyperslabDataSelection >( disk );
     BOOST_REQUIRE( diskSlab );
+    lastSlab = diskSlab->hyperslab();
 
     std::size_t startIndex = diskSlab->hyperslab().start( 0 );
     std::size_t stride = diskSlab->hyperslab().stride( 0 );
@@ -145,4 +163,74 @@ BOOST_AUTO_TEST_CASE( selectHyperslabShift ) {
   BOOST_CHECK_EQUAL( answer, result->data );
 }
 
+BOOST_AUTO_TEST_CASE( selectCoordinateShift ) {
+  xdm::RefPtr< TestDataset > result( new TestDataset );
+  xdm::RefPtr< xdmComm::RankOrderedDistributedDataset > test(
+    new xdmComm::RankOrderedDistributedDataset( result, MPI_COMM_WORLD ) );
+
+  test->initialize(
+    xdm::primitiveType::kChar,
+    xdm::makeShape( 4 ),
+    xdm::Dataset::kCreate );
+
+  std::vector< size_t > points;
+  points.push_back( 3 );
+  points.push_back( 1 );
+  xdm::DataSelectionMap selectionMap;
+  selectionMap.setRange( xdm::makeRefPtr( new xdm::CoordinateDataSelection(
+    xdm::CoordinateArray<>( &points[0], 1, 2 ) ) ) );
+
+  test->serialize( 0, selectionMap );
+
+  // the selected points are shifted into the 4 positions for this process, and
+  // the caller's coordinates are left alone.
+  std::string answer;
+  answer.resize( globalFixture.processes() * 4 );
+  std::fill( answer.begin(), answer.end(), 'x' );
+  answer[globalFixture.localRank() * 4 + 1]  = 'a';
+  answer[globalFixture.localRank() * 4 + 3]  = 'a';
+
+  BOOST_CHECK_EQUAL( answer, result->data );
+  BOOST_CHECK_EQUAL( 3, points[0] );
+  BOOST_CHECK_EQUAL( 1, points[1] );
+}
+
+BOOST_AUTO_TEST_CASE( blockDecomposition2D ) {
+  // Arrange the processes on a 2 x p/2 grid with each one writing a 2 x 3 block.
+  BOOST_REQUIRE_EQUAL( 0, globalFixture.processes() % 2 );
+  std::vector< int > processGrid;
+  processGrid.push_back( 2 );
+  processGrid.push_back( globalFixture.processes() / 2 );
+
+  xdm::RefPtr< TestDataset > result( new TestDataset );
+  xdm::RefPtr< xdmComm::RankOrderedDistributedDataset > test(
+    new xdmComm::RankOrderedDistributedDataset( result, MPI_COMM_WORLD, processGrid ) );
+
+  test->initialize(
+    xdm::primitiveType::kChar,
+    xdm::makeShape( 2, 3 ),
+    xdm::Dataset::kCreate );
+  BOOST_CHECK_EQUAL( 4, result->initializedShape[0] );
+  BOOST_CHECK_EQUAL( 3 * processGrid[1], result->initializedShape[1] );
+
+  xdm::DataSelectionMap selectionMap; // default all to all selection
+  test->serialize( 0, selectionMap );
+
+  // ranks fill the grid in row major order.
+  int row = globalFixture.localRank() / processGrid[1];
+  int column = globalFixture.localRank() % processGrid[1];
+  BOOST_CHECK_EQUAL( 2 * row, result->lastSlab.start( 0 ) );
+  BOOST_CHECK_EQUAL( 3 * column, result->lastSlab.start( 1 ) );
+  BOOST_CHECK_EQUAL( 2, result->lastSlab.count( 0 ) );
+  BOOST_CHECK_EQUAL( 3, result->lastSlab.count( 1 ) );
+}
+
+BOOST_AUTO_TEST_CASE( invalidProcessGrid ) {
+  std::vector< int > processGrid( 1, globalFixture.processes() + 1 );
+  xdm::RefPtr< TestDataset > result( new TestDataset );
+  BOOST_CHECK_THROW(
+    xdmComm::RankOrderedDistributedDataset( result, MPI_COMM_WORLD, processGrid ),
+    std::invalid_argument );
+}
+
 } // namespace
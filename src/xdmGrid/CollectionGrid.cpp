@@ -42,6 +42,7 @@ CollectionGrid::CollectionGrid() :
   mElementIndices(),
   mFaceEdgeIndices(),
   mElementOffsets(),
+  mGridCounts(),
   mReferenceTypes() {
 }
 
@@ -199,33 +200,22 @@ xdm::RefPtr< Attribute > CollectionGrid::createAttribute(
 }
 
 std::size_t CollectionGrid::numberOfElements() const {
-  if ( mElementOffsets.size() != mGrids.size() ) {
-    updateOffsets();
-  }
-  return mElementOffsets.back();
+  const std::vector< std::size_t >& offsets = elementOffsets();
+  return offsets.empty() ? 0 : offsets.back();
 }
 
 Element CollectionGrid::element( const std::size_t& elementIndex ) const
 {
   std::pair< std::size_t, std::size_t > found = findGrid( elementIndex );
+  return gridElement( found.first, found.second );
+}
 
-  // Special treatment for null element index list: assume we are referencing the whole
-  // grid.
-  std::size_t element = found.second;
-  if ( mElementIndices[ found.first ] ) {
-    element = mElementIndices[ found.first ]->atIndex< std::size_t >( found.second );
-  }
+CollectionGrid::ConstElementIterator CollectionGrid::beginElements() const {
+  return ConstElementIterator( this, 0 );
+}
 
-  switch( mReferenceTypes[ found.first ] ) {
-  case kFace:
-    return mGrids[ found.first ]->element( element ).face(
-      mFaceEdgeIndices[ found.first ]->atIndex< std::size_t >( found.second ) );
-  case kEdge:
-    return mGrids[ found.first ]->element( element ).edge(
-      mFaceEdgeIndices[ found.first ]->atIndex< std::size_t >( found.second ) );
-   default:
-    return mGrids[ found.first ]->element( element );
-  }
+CollectionGrid::ConstElementIterator CollectionGrid::endElements() const {
+  return ConstElementIterator( this, mGrids.size() );
 }
 
 void CollectionGrid::traverse( xdm::ItemVisitor& iv ) {
@@ -253,12 +243,9 @@ void CollectionGrid::writeMetadata( xdm::XmlMetadataWrapper& xml ) {
 // Finds the grid index and element offset index.
 std::pair< std::size_t, std::size_t > CollectionGrid::findGrid( const std::size_t& elementIndex ) const {
 
-  if ( mElementOffsets.size() != mGrids.size() ) {
-    updateOffsets();
-  }
-
+  const std::vector< std::size_t >& offsets = elementOffsets();
   std::vector< std::size_t >::const_iterator found =
-    std::upper_bound( mElementOffsets.begin(), mElementOffsets.end(), elementIndex );
+    std::upper_bound( offsets.begin(), offsets.end(), elementIndex );
   // Code Review Matter (open): assert vs exception
   // Is it possible for a data driven process to cause an invalid elementIndex to be
   // supplied to this method? Would an exception be more appropriate?
@@ -271,8 +258,8 @@ std::pair< std::size_t, std::size_t > CollectionGrid::findGrid( const std::size_
   // by faulty code in this class implementation or by an elementIndex that is too large.
   // This is akin to overstepping an array bound, which is traditionally caught only
   // in debug builds with an assert.
-  assert( found != mElementOffsets.end() );
-  std::size_t gridIndex = found - mElementOffsets.begin();
+  assert( found != offsets.end() );
+  std::size_t gridIndex = found - offsets.begin();
   std::size_t offsetIndex = elementIndex;
   if ( gridIndex > 0 ) {
     offsetIndex -= *(--found);
@@ -282,25 +269,61 @@ std::pair< std::size_t, std::size_t > CollectionGrid::findGrid( const std::size_
     offsetIndex );
 }
 
+Element CollectionGrid::gridElement( std::size_t gridIndex, std::size_t offsetIndex ) const {
+
+  // Special treatment for null element index list: assume we are referencing the whole
+  // grid.
+  std::size_t element = offsetIndex;
+  if ( mElementIndices[ gridIndex ] ) {
+    element = mElementIndices[ gridIndex ]->atIndex< std::size_t >( offsetIndex );
+  }
+
+  switch( mReferenceTypes[ gridIndex ] ) {
+  case kFace:
+    return mGrids[ gridIndex ]->element( element ).face(
+      mFaceEdgeIndices[ gridIndex ]->atIndex< std::size_t >( offsetIndex ) );
+  case kEdge:
+    return mGrids[ gridIndex ]->element( element ).edge(
+      mFaceEdgeIndices[ gridIndex ]->atIndex< std::size_t >( offsetIndex ) );
+   default:
+    return mGrids[ gridIndex ]->element( element );
+  }
+}
+
+std::size_t CollectionGrid::gridCount( std::size_t gridIndex ) const {
+  // A null entry in mElementIndices means that every element of the grid is referenced.
+  if ( mElementIndices[ gridIndex ] ) {
+    return mElementIndices[ gridIndex ]->dataspace()[0];
+  }
+  return mGrids[ gridIndex ]->numberOfElements();
+}
+
+const std::vector< std::size_t >& CollectionGrid::elementOffsets() const {
+  // The offsets only depend on the number of elements taken from each grid, so they are
+  // current as long as none of those counts has changed since they were built.
+  bool current = ( mGridCounts.size() == mGrids.size() );
+  for ( std::size_t i = 0; current && i < mGrids.size(); ++i ) {
+    current = ( mGridCounts[ i ] == gridCount( i ) );
+  }
+  if ( ! current ) {
+    updateOffsets();
+  }
+  return mElementOffsets;
+}
+
 void CollectionGrid::updateOffsets() const {
 
   // This routine updates mElementOffsets to coincide with whatever grids are currently
   // being referenced by the collection. This is a cumulative index, so we are basically
-  // just adding the number of elements we want from each grid to the previous index.
-  // However, there are a few conditional branches because 1) a null entry in
-  // mElementIndices means we use the whole grid (every element will become part of the
-  // CollectionGrid) and 2) the first grid does not have a previous grid.
+  // just adding the number of elements we want from each grid to the previous index. The
+  // counts are kept as well so that elementOffsets() can tell when they change.
 
   mElementOffsets.clear();
-  for ( std::size_t arrayIndex = 0; arrayIndex < mElementIndices.size(); ++arrayIndex ) {
-    if ( mElementIndices[ arrayIndex ] ) {
-      // First get the number of elements that will be referenced from the grid.
-      mElementOffsets.push_back( mElementIndices[ arrayIndex ]->dataspace()[0] );
-    } else {
-      // Special treatment if the pointer is null: this means that the whole
-      // grid is being used. Thus, we add every element from that grid.
-      mElementOffsets.push_back( mGrids[ arrayIndex ]->numberOfElements() );
-    }
+  mGridCounts.clear();
+  for ( std::size_t arrayIndex = 0; arrayIndex < mGrids.size(); ++arrayIndex ) {
+    // First get the number of elements that will be referenced from the grid.
+    mGridCounts.push_back( gridCount( arrayIndex ) );
+    mElementOffsets.push_back( mGridCounts.back() );
 
     // The entry in mElementOffsets is the cumulative size of the CollectionGrid, so
     // for every entry other than the first entry, we need to add the sum of all of
@@ -311,5 +334,73 @@ void CollectionGrid::updateOffsets() const {
   }
 }
 
+// -------------------------------------------------------------------------------------------------
+CollectionGrid::ConstElementIterator::ConstElementIterator() :
+  mCollection( 0 ),
+  mGridIndex( 0 ),
+  mOffsetIndex( 0 ),
+  mIndex( 0 ) {
+}
+
+CollectionGrid::ConstElementIterator::ConstElementIterator(
+  const CollectionGrid* grid,
+  std::size_t gridIndex ) :
+  mCollection( grid ),
+  mGridIndex( gridIndex ),
+  mOffsetIndex( 0 ),
+  mIndex( 0 ) {
+
+  const std::vector< std::size_t >& offsets = mCollection->elementOffsets();
+  if ( mGridIndex > 0 && mGridIndex <= offsets.size() ) {
+    mIndex = offsets[ mGridIndex - 1 ];
+  }
+  skipEmptyGrids();
+}
+
+Element CollectionGrid::ConstElementIterator::operator*() const {
+  assert( mCollection && mGridIndex < mCollection->mGrids.size() );
+  return mCollection->gridElement( mGridIndex, mOffsetIndex );
+}
+
+CollectionGrid::ConstElementIterator& CollectionGrid::ConstElementIterator::operator++() {
+  ++mOffsetIndex;
+  ++mIndex;
+  skipEmptyGrids();
+  return *this;
+}
+
+CollectionGrid::ConstElementIterator CollectionGrid::ConstElementIterator::operator++( int ) {
+  ConstElementIterator result( *this );
+  ++( *this );
+  return result;
+}
+
+std::size_t CollectionGrid::ConstElementIterator::index() const {
+  return mIndex;
+}
+
+bool CollectionGrid::ConstElementIterator::operator==(
+  const ConstElementIterator& other ) const {
+  return mCollection == other.mCollection
+    && mGridIndex == other.mGridIndex
+    && mOffsetIndex == other.mOffsetIndex;
+}
+
+bool CollectionGrid::ConstElementIterator::operator!=(
+  const ConstElementIterator& other ) const {
+  return ! ( *this == other );
+}
+
+void CollectionGrid::ConstElementIterator::skipEmptyGrids() {
+  // Move on to the next grid once every element of the current grid has been visited. The
+  // end of the current grid is the index where the next grid's elements begin. The offsets
+  // were checked when the iterator was created, so they are read without checking again.
+  const std::vector< std::size_t >& offsets = mCollection->mElementOffsets;
+  while ( mGridIndex < offsets.size() && mIndex == offsets[ mGridIndex ] ) {
+    ++mGridIndex;
+    mOffsetIndex = 0;
+  }
+}
+
 } // namespace xdmGrid
 
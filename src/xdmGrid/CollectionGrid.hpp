@@ -26,6 +26,9 @@
 #include <xdm/Forward.hpp>
 #include <xdm/UniformDataItem.hpp>
 
+#include <cstddef>
+#include <iterator>
+#include <vector>
 
 
 namespace xdmGrid {
@@ -112,14 +115,54 @@ public:
     xdm::primitiveType::Value dataType );
 
   /// Since the CollectionGrid can contain subsets of many different topologies,
-  /// this function returns the total number of referenced elements. This is an
-  /// expensive call because it recomputes the total number of elements at each
-  /// function call.
+  /// this function returns the total number of referenced elements. The count is
+  /// cached along with the element offsets of each referenced grid, and the cache is
+  /// rebuilt when the number of elements taken from any referenced grid changes.
   virtual std::size_t numberOfElements() const;
 
   /// Get an element by index. All elements are const in that they only have const functions.
+  /// Finding the referenced grid is a binary search over the cached element offsets.
   virtual Element element( const std::size_t& elementIndex ) const;
 
+  /// Const iterator that visits the elements of the collection in order by walking the
+  /// referenced grids, so no search is needed to find the grid of each element. Changing
+  /// the number of elements in a referenced grid invalidates the iterator.
+  class ConstElementIterator {
+  public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef Element value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const Element* pointer;
+    typedef Element reference;
+
+    ConstElementIterator();
+
+    Element operator*() const;
+    ConstElementIterator& operator++();
+    ConstElementIterator operator++( int );
+
+    /// Get the index of the current element in the collection.
+    std::size_t index() const;
+
+    bool operator==( const ConstElementIterator& other ) const;
+    bool operator!=( const ConstElementIterator& other ) const;
+
+  private:
+    friend class CollectionGrid;
+    ConstElementIterator( const CollectionGrid* grid, std::size_t gridIndex );
+    void skipEmptyGrids();
+
+    const CollectionGrid* mCollection;
+    std::size_t mGridIndex;
+    std::size_t mOffsetIndex;
+    std::size_t mIndex;
+  };
+
+  /// Get an iterator pointing to the first element of the collection.
+  ConstElementIterator beginElements() const;
+  /// Get an iterator pointing past the last element of the collection.
+  ConstElementIterator endElements() const;
+
   /// Definition of visitor traversal.
   virtual void traverse( xdm::ItemVisitor& iv );
 
@@ -156,7 +199,10 @@ private:
   // example, if we want 3 elements from the 1st grid, 5 elements from the 2nd grid, and
   // 2 elements from the 3rd grid, then we have:
   //   mElementOffsets == { 3, 8, 10 }
+  // mGridCounts holds the number of elements taken from each grid when the offsets were
+  // built, and the offsets are rebuilt when any of them no longer matches.
   mutable std::vector< std::size_t > mElementOffsets;
+  mutable std::vector< std::size_t > mGridCounts;
 
   // For each grid in mGrids, mReferenceTypes indicates whether we are accessing elements,
   // faces, or edges on the elements in that grid. This allows the use of heterogeneous
@@ -167,7 +213,10 @@ private:
   std::vector< ReferenceType > mReferenceTypes;
 
   std::pair< std::size_t, std::size_t > findGrid( const std::size_t& elementIndex ) const;
+  Element gridElement( std::size_t gridIndex, std::size_t offsetIndex ) const;
+  std::size_t gridCount( std::size_t gridIndex ) const;
   void updateOffsets() const;
+  const std::vector< std::size_t >& elementOffsets() const;
 };
 
 } // namespace xdmGrid
@@ -20,8 +20,18 @@
 //------------------------------------------------------------------------------
 #include <xdmGrid/Element.hpp>
 
-
+#include <xdmGrid/Topology.hpp>
 
 namespace xdmGrid {
 
+ElementRange::ElementRange( const Topology& topology, const Geometry& geometry ) :
+  mConnectivity( topology.connectivityLayout() ),
+  mNodes( geometry.nodeLayout() ),
+  mTopo(),
+  mSize( topology.numberOfElements() ) {
+  if ( mSize > 0 ) {
+    mTopo = topology.elementTopology( 0 );
+  }
+}
+
 } // namespace xdmGrid
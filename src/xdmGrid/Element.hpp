@@ -26,13 +26,18 @@
 
 #include <xdm/ReferencedObject.hpp>
 #include <xdm/RefPtr.hpp>
+#include <xdm/VectorRef.hpp>
 
+#include <cstddef>
+#include <iterator>
 #include <vector>
 
 
 
 namespace xdmGrid {
 
+class Topology;
+
 /// A shared lookup class for Elements. Elements refer connectivity and geometry queries to this
 /// shared class.
 class ElementSharedConnectivityLookup : public xdm::ReferencedObject {
@@ -119,6 +124,139 @@ private:
   std::size_t mIndex;
 };
 
+/// A non-owning handle to an element of a UniformGrid. The view reads connectivity and node
+/// coordinates straight from the shared implementations borrowed from an ElementRange, so
+/// creating and copying views does not touch any reference counts. A view is only valid
+/// while the ElementRange that produced it exists.
+class ElementView {
+public:
+  ElementView(
+    const xdm::VectorRefImp< std::size_t >* connectivity,
+    const xdm::VectorRefImp< double >* nodes,
+    const ElementTopology* elementTopology,
+    std::size_t elementIndex ) :
+      mConnectivity( connectivity ),
+      mNodes( nodes ),
+      mTopo( elementTopology ),
+      mIndex( elementIndex ) {
+  }
+
+  /// Get the index of this element in the topology.
+  std::size_t index() const {
+    return mIndex;
+  }
+
+  /// Get the type of shape.
+  ElementShape::Type shape() const {
+    return mTopo->shape();
+  }
+
+  /// Get the number of nodes on this element.
+  std::size_t numberOfNodes() const {
+    return mTopo->numberOfNodes();
+  }
+
+  /// Get the number of coordinates of each node.
+  std::size_t dimension() const {
+    return mNodes->size();
+  }
+
+  /// Get the global node index into the geometry that corresponds to a local node index for this
+  /// element.
+  std::size_t nodeIndexInGeometry( std::size_t localNodeIndex ) const {
+    return value( *mConnectivity, mIndex, mTopo->node( localNodeIndex ) );
+  }
+
+  /// Get one coordinate of a node on the element.
+  /// @param localNodeIndex The local index of the node on the element.
+  /// @param dim The coordinate direction, e.g. 1 for y.
+  double coordinate( std::size_t localNodeIndex, std::size_t dim ) const {
+    return value( *mNodes, nodeIndexInGeometry( localNodeIndex ), dim );
+  }
+
+private:
+  // Read strided data directly rather than through the virtual value().
+  template< typename T >
+  static T value( const xdm::VectorRefImp< T >& imp, std::size_t base, std::size_t i ) {
+    if ( imp.isStrided() ) {
+      return imp.data( i )[ base * imp.stride() ];
+    }
+    return imp.value( base, i );
+  }
+
+  const xdm::VectorRefImp< std::size_t >* mConnectivity;
+  const xdm::VectorRefImp< double >* mNodes;
+  const ElementTopology* mTopo;
+  std::size_t mIndex;
+};
+
+/// The elements of a UniformGrid as a range of ElementViews. The range holds the shared
+/// connectivity and node implementations for its lifetime, so element-wise loops only pay
+/// for the connectivity and geometry reads. Like UnstructuredTopology, the range assumes
+/// every element has the same ElementTopology.
+class ElementRange {
+public:
+  /// Iterator over the ElementViews of the range in index order.
+  class ConstIterator {
+  public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef ElementView value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const ElementView* pointer;
+    typedef ElementView reference;
+
+    ConstIterator() : mRange( 0 ), mIndex( 0 ) {}
+    ConstIterator( const ElementRange* range, std::size_t index ) :
+      mRange( range ), mIndex( index ) {}
+
+    ElementView operator*() const { return (*mRange)[ mIndex ]; }
+    ElementView operator[]( difference_type n ) const { return (*mRange)[ mIndex + n ]; }
+
+    ConstIterator& operator++() { ++mIndex; return *this; }
+    ConstIterator operator++( int ) { ConstIterator result( *this ); ++mIndex; return result; }
+    ConstIterator& operator--() { --mIndex; return *this; }
+    ConstIterator operator--( int ) { ConstIterator result( *this ); --mIndex; return result; }
+    ConstIterator& operator+=( difference_type n ) { mIndex += n; return *this; }
+    ConstIterator& operator-=( difference_type n ) { mIndex -= n; return *this; }
+    ConstIterator operator+( difference_type n ) const {
+      return ConstIterator( mRange, mIndex + n );
+    }
+    ConstIterator operator-( difference_type n ) const {
+      return ConstIterator( mRange, mIndex - n );
+    }
+    difference_type operator-( const ConstIterator& other ) const {
+      return difference_type( mIndex ) - difference_type( other.mIndex );
+    }
+
+    bool operator==( const ConstIterator& other ) const { return mIndex == other.mIndex; }
+    bool operator!=( const ConstIterator& other ) const { return mIndex != other.mIndex; }
+    bool operator<( const ConstIterator& other ) const { return mIndex < other.mIndex; }
+
+  private:
+    const ElementRange* mRange;
+    std::size_t mIndex;
+  };
+
+  ElementRange( const Topology& topology, const Geometry& geometry );
+
+  /// Get the number of elements in the range.
+  std::size_t size() const { return mSize; }
+
+  /// Get a view of an element by index.
+  ElementView operator[]( std::size_t elementIndex ) const {
+    return ElementView( mConnectivity.get(), mNodes.get(), mTopo.get(), elementIndex );
+  }
+
+  ConstIterator begin() const { return ConstIterator( this, 0 ); }
+  ConstIterator end() const { return ConstIterator( this, mSize ); }
+
+private:
+  xdm::RefPtr< const xdm::VectorRefImp< std::size_t > > mConnectivity;
+  xdm::RefPtr< const xdm::VectorRefImp< double > > mNodes;
+  xdm::RefPtr< const ElementTopology > mTopo;
+  std::size_t mSize;
+};
+
 } // namespace xdmGrid
 
 #endif // xdm_Element_hpp
@@ -222,6 +222,14 @@ xdm::RefPtr< const ElementTopology > elementFactory(
     case ElementShape::Hexahedron:
       element = hexahedronFactory( order );
       break;
+    case ElementShape::Hypercube:
+      // Hypercubes are only linear, and without a rank the lowest one is built. Use
+      // hypercubeFactory() for higher ranks.
+      if ( order != 1 ) {
+        XDM_THROW( std::domain_error( "The order of a hypercube is not 1." ) );
+      }
+      element = hypercubeFactory( 4 );
+      break;
     }
   }
 
@@ -607,6 +615,33 @@ xdm::RefPtr< const ElementTopology > hexahedronFactory(
     name ) );
 }
 
+xdm::RefPtr< const ElementTopology > hypercubeFactory(
+  const std::size_t& rank,
+  std::string name ) {
+
+  if ( rank < 4 ) {
+    XDM_THROW( std::domain_error( "The rank of a hypercube is less than 4." ) );
+  }
+
+  if ( name.size() == 0 ) {
+    std::stringstream ss;
+    ss << "Hypercube" << rank;
+    name = ss.str();
+  }
+
+  std::vector< xdm::RefPtr< const ElementTopology > > faces;
+  std::vector< xdm::RefPtr< const ElementTopology > > edges;
+  std::vector< std::size_t > nodes( std::size_t( 1 ) << rank );
+  iota( nodes.begin(), nodes.end(), 0 );
+
+  return xdm::makeRefPtr( new ElementTopology(
+    faces,
+    edges,
+    nodes,
+    ElementShape::Hypercube,
+    name ) );
+}
+
 ElementDimension::Type elementDimension( const ElementShape::Type& shape ) {
   switch ( shape ) {
   case ElementShape::Vertex:
@@ -621,6 +656,8 @@ ElementDimension::Type elementDimension( const ElementShape::Type& shape ) {
   case ElementShape::Wedge:
   case ElementShape::Hexahedron:
     return ElementDimension::Volume;
+  case ElementShape::Hypercube:
+    return ElementDimension::Hypervolume;
   default:
     XDM_THROW( std::invalid_argument( "Unknown shape." ) );
   }
@@ -48,7 +48,9 @@ namespace ElementShape {
     Tetrahedron,
     Pyramid,
     Wedge,
-    Hexahedron
+    Hexahedron,
+    // Tensor product cell of a structured topology with more than three dimensions.
+    Hypercube
   };
 }
 
@@ -57,7 +59,9 @@ namespace ElementDimension {
     Point = 0,
     Curve = 1,
     Surface = 2,
-    Volume = 3
+    Volume = 3,
+    // Four or more dimensions.
+    Hypervolume = 4
   };
 }
 
@@ -138,6 +142,12 @@ xdm::RefPtr< const ElementTopology > hexahedronFactory(
   const std::size_t& order,
   std::string name = "" );
 
+/// Linear tensor product cell with the 2^rank corner nodes of a structured topology with more
+/// than three dimensions. Faces and edges are not enumerated.
+xdm::RefPtr< const ElementTopology > hypercubeFactory(
+  const std::size_t& rank,
+  std::string name = "" );
+
 ElementDimension::Type elementDimension( const ElementShape::Type& shape );
 
 ///// Get the ElementTopology that corresponds to an Exodus shape string.
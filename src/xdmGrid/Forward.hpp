@@ -29,8 +29,10 @@ class Attribute;
 class CollectionGrid;
 class Domain;
 class Element;
+class ElementRange;
 class ElementTopology;
 class ElementSharedConnectivityLookup;
+class ElementView;
 class Geometry;
 class Grid;
 class InterlacedGeometry;
@@ -62,19 +62,40 @@ std::size_t Geometry::numberOfNodes() const
 
 ConstNode Geometry::node( std::size_t nodeIndex ) const
 {
-  if ( !mSharedVectorImp ) {
-    Geometry& mutableThis = const_cast< Geometry& >( *this );
-    mutableThis.mSharedVectorImp = mutableThis.createVectorImp();
-  }
-  return ConstNode( mSharedVectorImp, nodeIndex );
+  return ConstNode( sharedVectorImp(), nodeIndex );
 }
 
 Node Geometry::node( std::size_t nodeIndex )
+{
+  return Node( sharedVectorImp(), nodeIndex );
+}
+
+xdm::RefPtr< const xdm::VectorRefImp< double > > Geometry::nodeLayout() const
+{
+  return sharedVectorImp();
+}
+
+void Geometry::copyCoordinates(
+  std::size_t firstNode,
+  std::size_t numberOfNodes,
+  double* out ) const
+{
+  xdm::RefPtr< const xdm::VectorRefImp< double > > imp = nodeLayout();
+  std::size_t dim = imp->size();
+  for ( std::size_t node = 0; node < numberOfNodes; ++node ) {
+    for ( std::size_t i = 0; i < dim; ++i ) {
+      *out++ = imp->value( firstNode + node, i );
+    }
+  }
+}
+
+xdm::RefPtr< xdm::VectorRefImp< double > > Geometry::sharedVectorImp() const
 {
   if ( !mSharedVectorImp ) {
-    mSharedVectorImp = this->createVectorImp();
+    Geometry& mutableThis = const_cast< Geometry& >( *this );
+    mutableThis.mSharedVectorImp = mutableThis.createVectorImp();
   }
-  return Node( mSharedVectorImp, nodeIndex );
+  return mSharedVectorImp;
 }
 
 void Geometry::traverse( xdm::ItemVisitor& iv ) {
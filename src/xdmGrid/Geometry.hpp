@@ -70,6 +70,20 @@ public:
   /// Get a constant shared node by index.
   ConstNode node( std::size_t nodeIndex ) const;
 
+  /// Get the implementation shared by all nodes. When its isStrided() is true, coordinates may
+  /// be read through its strided pointers or copyElements() instead of one Node at a time.
+  xdm::RefPtr< const xdm::VectorRefImp< double > > nodeLayout() const;
+
+  /// Copy the coordinates of a range of nodes to a flat array, one node after another
+  /// (xyzxyz...). Subclasses override this with a faster copy for their storage layout.
+  /// @param firstNode The index of the first node to copy.
+  /// @param numberOfNodes The number of nodes to copy.
+  /// @param out Array with room for numberOfNodes * dimension() values.
+  virtual void copyCoordinates(
+    std::size_t firstNode,
+    std::size_t numberOfNodes,
+    double* out ) const;
+
   virtual void traverse( xdm::ItemVisitor& iv );
 
   /// Write geometry metadata.
@@ -88,6 +102,8 @@ protected:
   virtual xdm::RefPtr< xdm::VectorRefImp< double > > createVectorImp() = 0;
 
 private:
+  xdm::RefPtr< xdm::VectorRefImp< double > > sharedVectorImp() const;
+
   std::size_t mNumberOfNodes;
   unsigned int mDimension;
   xdm::RefPtr< xdm::VectorRefImp< double > > mSharedVectorImp;
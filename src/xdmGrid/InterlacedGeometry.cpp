@@ -22,6 +22,7 @@
 
 #include <xdm/VectorRef.hpp>
 
+#include <algorithm>
 #include <stdexcept>
 #include <cassert>
 
@@ -65,6 +66,17 @@ void InterlacedGeometry::writeMetadata( xdm::XmlMetadataWrapper& xml ) {
   }
 }
 
+void InterlacedGeometry::copyCoordinates(
+  std::size_t firstNode,
+  std::size_t numberOfNodes,
+  double* out ) const
+{
+  // The coordinates are already interlaced, so the range is one contiguous block.
+  xdm::RefPtr< const xdm::VectorRefImp< double > > imp = nodeLayout();
+  const double* source = imp->data( 0 ) + firstNode * dimension();
+  std::copy( source, source + numberOfNodes * dimension(), out );
+}
+
 xdm::RefPtr< xdm::VectorRefImp< double > > InterlacedGeometry::createVectorImp()
 {
   return xdm::RefPtr< xdm::VectorRefImp< double > >(
@@ -53,6 +53,12 @@ public:
   /// @throws std::logic_error if called after coordinate values have already been set.
   void setCoordinateValues( xdm::RefPtr< xdm::UniformDataItem > data );
 
+  /// Copy the coordinates of a range of nodes.
+  virtual void copyCoordinates(
+    std::size_t firstNode,
+    std::size_t numberOfNodes,
+    double* out ) const;
+
   virtual void writeMetadata( xdm::XmlMetadataWrapper& xml );
 
 protected:
@@ -95,6 +95,23 @@ void MultiArrayGeometry::writeMetadata( xdm::XmlMetadataWrapper& xml ) {
   }
 }
 
+void MultiArrayGeometry::copyCoordinates(
+  std::size_t firstNode,
+  std::size_t numberOfNodes,
+  double* out ) const
+{
+  // Interlace one coordinate array at a time into the output.
+  xdm::RefPtr< const xdm::VectorRefImp< double > > imp = nodeLayout();
+  std::size_t dim = dimension();
+  for ( std::size_t i = 0; i < dim; ++i ) {
+    const double* source = imp->data( i ) + firstNode;
+    double* target = out + i;
+    for ( std::size_t node = 0; node < numberOfNodes; ++node, target += dim ) {
+      *target = source[ node ];
+    }
+  }
+}
+
 xdm::RefPtr< xdm::VectorRefImp< double > > MultiArrayGeometry::createVectorImp()
 {
   std::vector< double* > arrays( dimension() );
@@ -58,6 +58,12 @@ public:
   /// @throws std::runtime_error if the arrays are not all the same size.
   void setCoordinateValues( unsigned int dim, xdm::RefPtr< xdm::UniformDataItem > data );
 
+  /// Copy the coordinates of a range of nodes.
+  virtual void copyCoordinates(
+    std::size_t firstNode,
+    std::size_t numberOfNodes,
+    double* out ) const;
+
   virtual void writeMetadata( xdm::XmlMetadataWrapper& xml );
 
 protected:
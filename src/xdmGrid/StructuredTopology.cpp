@@ -21,6 +21,7 @@
 #include <xdmGrid/StructuredTopology.hpp>
 
 #include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <numeric>
 #include <sstream>
@@ -44,48 +45,92 @@ StructuredTopologyVectorRefImpFactory::~StructuredTopologyVectorRefImpFactory()
 xdm::RefPtr< xdm::VectorRefImp< std::size_t > > 
 StructuredTopologyVectorRefImpFactory::createVectorRefImp()
 {
-  mTopology.mNodes.clear();
-  switch( mTopology.mShape.rank() ) {
-    case 2:
-      for ( std::size_t y = 0; y < mTopology.mShape[1]; ++y ) {
-        for ( std::size_t x = 0; x < mTopology.mShape[0]; ++x ) {
-          std::size_t xNodes = mTopology.mShape[0] + 1;
-          mTopology.mNodes.push_back( ( x + 0 ) + ( y + 0 ) * xNodes );
-          mTopology.mNodes.push_back( ( x + 1 ) + ( y + 0 ) * xNodes );
-          mTopology.mNodes.push_back( ( x + 1 ) + ( y + 1 ) * xNodes );
-          mTopology.mNodes.push_back( ( x + 0 ) + ( y + 1 ) * xNodes );
-        }
-      }
-      break;
-    case 3:
-      for ( std::size_t z = 0; z < mTopology.mShape[2]; ++z ) {
-        for ( std::size_t y = 0; y < mTopology.mShape[1]; ++y ) {
-          for ( std::size_t x = 0; x < mTopology.mShape[0]; ++x ) {
-            std::size_t xNodes = mTopology.mShape[0] + 1;
-            std::size_t yNodes = mTopology.mShape[1] + 1;
-            mTopology.mNodes.push_back( ( x + 0 ) + ( y + 0 ) * xNodes + ( z + 0 ) * xNodes * yNodes );
-            mTopology.mNodes.push_back( ( x + 1 ) + ( y + 0 ) * xNodes + ( z + 0 ) * xNodes * yNodes );
-            mTopology.mNodes.push_back( ( x + 1 ) + ( y + 1 ) * xNodes + ( z + 0 ) * xNodes * yNodes );
-            mTopology.mNodes.push_back( ( x + 0 ) + ( y + 1 ) * xNodes + ( z + 0 ) * xNodes * yNodes );
-            mTopology.mNodes.push_back( ( x + 0 ) + ( y + 0 ) * xNodes + ( z + 1 ) * xNodes * yNodes );
-            mTopology.mNodes.push_back( ( x + 1 ) + ( y + 0 ) * xNodes + ( z + 1 ) * xNodes * yNodes );
-            mTopology.mNodes.push_back( ( x + 1 ) + ( y + 1 ) * xNodes + ( z + 1 ) * xNodes * yNodes );
-            mTopology.mNodes.push_back( ( x + 0 ) + ( y + 1 ) * xNodes + ( z + 1 ) * xNodes * yNodes );
-          }
-        }
+  return xdm::RefPtr< xdm::VectorRefImp< std::size_t > >(
+    new StructuredConnectivityImp( mTopology.mShape ) );
+}
+
+// -------------------------------------------------------------------------------------------------
+StructuredConnectivityImp::StructuredConnectivityImp( const xdm::DataShape<>& elementShape ) :
+  mElementCounts( elementShape.begin(), elementShape.end() ),
+  mNodeStrides( elementShape.rank() ),
+  mCornerOffsets( std::size_t( 1 ) << elementShape.rank() ),
+  mScratch( 0 ) {
+
+  std::size_t rank = mElementCounts.size();
+  std::size_t stride = 1;
+  for ( std::size_t dim = 0; dim < rank; ++dim ) {
+    mNodeStrides[ dim ] = stride;
+    stride *= mElementCounts[ dim ] + 1;
+  }
+
+  // Corner c is offset by one node along dimension d when bit d of c is set, except that
+  // the first two dimensions go around the face counterclockwise to follow the ExodusII
+  // ordering of quads and hexes: (0,0), (1,0), (1,1), (0,1).
+  for ( std::size_t corner = 0; corner < mCornerOffsets.size(); ++corner ) {
+    std::size_t offset = 0;
+    for ( std::size_t dim = 0; dim < rank; ++dim ) {
+      std::size_t bit = ( corner >> dim ) & 1;
+      if ( dim == 0 && rank > 1 ) {
+        bit ^= ( corner >> 1 ) & 1;
       }
-      break;
-    default:
-      std::stringstream ss;
-      ss << "The rank of the DataShape represents an unknown structured mesh topology (something"
-        " other than 2D or 3D). The rank was " << mTopology.mShape.rank();
-      XDM_THROW( std::runtime_error( ss.str() ) );
+      offset += bit * mNodeStrides[ dim ];
+    }
+    mCornerOffsets[ corner ] = offset;
   }
+}
 
-  return xdm::RefPtr< xdm::VectorRefImp< std::size_t > >(
-    new xdm::SingleArrayOfVectorsImp< std::size_t >( 
-      &mTopology.mNodes[0], 
-      mTopology.mElementTopology->numberOfNodes() ) );
+StructuredConnectivityImp::~StructuredConnectivityImp() {
+}
+
+const std::size_t& StructuredConnectivityImp::at( std::size_t baseIndex, std::size_t i ) const {
+  mScratch = node( baseIndex, i );
+  return mScratch;
+}
+
+std::size_t StructuredConnectivityImp::value( std::size_t baseIndex, std::size_t i ) const {
+  return node( baseIndex, i );
+}
+
+std::size_t StructuredConnectivityImp::size() const {
+  return mCornerOffsets.size();
+}
+
+std::size_t StructuredConnectivityImp::node( std::size_t elementIndex, std::size_t i ) const {
+  return cornerNode( elementIndex ) + mCornerOffsets[ i ];
+}
+
+std::size_t StructuredConnectivityImp::cornerNode( std::size_t elementIndex ) const {
+  // There is one more node than element along each dimension, so unravel the element
+  // index and step by the node strides.
+  std::size_t node = 0;
+  for ( std::size_t dim = 0; dim < mElementCounts.size(); ++dim ) {
+    node += ( elementIndex % mElementCounts[ dim ] ) * mNodeStrides[ dim ];
+    elementIndex /= mElementCounts[ dim ];
+  }
+  return node;
+}
+
+void StructuredConnectivityImp::copyNodes(
+  std::size_t firstElement,
+  std::size_t numberOfElements,
+  std::size_t* out ) const {
+  if ( numberOfElements == 0 ) {
+    return;
+  }
+  const std::size_t rowLength = mElementCounts[0];
+  const std::size_t cornersPerElement = mCornerOffsets.size();
+  std::size_t element = firstElement;
+  const std::size_t last = firstElement + numberOfElements;
+  while ( element < last ) {
+    // Within a row the lowest corner moves one node at a time.
+    std::size_t base = cornerNode( element );
+    std::size_t rowEnd = std::min( last, element - element % rowLength + rowLength );
+    for ( ; element < rowEnd; ++element, ++base ) {
+      for ( std::size_t corner = 0; corner < cornersPerElement; ++corner ) {
+        *out++ = base + mCornerOffsets[ corner ];
+      }
+    }
+  }
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -108,6 +153,13 @@ void StructuredTopology::setShape( const xdm::DataShape<>& shape ) {
     std::accumulate( shape.begin(), shape.end(), 1, std::multiplies< std::size_t>() ) );
   std::size_t rank = mShape.rank();
   switch( rank ) {
+    case 0:
+      XDM_THROW( std::runtime_error(
+        "A structured mesh topology must have at least one dimension." ) );
+      break;
+    case 1:
+      mElementTopology = elementFactory( ElementShape::Curve, 1 );
+      break;
     case 2:
       mElementTopology = elementFactory( ElementShape::Quadrilateral, 1 );
       break;
@@ -115,10 +167,8 @@ void StructuredTopology::setShape( const xdm::DataShape<>& shape ) {
       mElementTopology = elementFactory( ElementShape::Hexahedron, 1 );
       break;
     default:
-      std::stringstream ss;
-      ss << "The rank of the DataShape represents an unknown structured mesh topology (something"
-        " other than 2D or 3D). The rank was " << rank;
-      XDM_THROW( std::runtime_error( ss.str() ) );
+      mElementTopology = hypercubeFactory( rank );
+      break;
   }
 }
 
@@ -132,6 +182,16 @@ xdm::RefPtr< const ElementTopology > StructuredTopology::elementTopology(
   return mElementTopology;
 }
 
+void StructuredTopology::copyConnectivity(
+  std::size_t firstElement,
+  std::size_t numberOfElements,
+  std::size_t* out ) const {
+  assert( firstElement + numberOfElements <= this->numberOfElements() );
+  xdm::RefPtr< const StructuredConnectivityImp > imp =
+    xdm::static_pointer_cast< const StructuredConnectivityImp >( connectivityLayout() );
+  imp->copyNodes( firstElement, numberOfElements, out );
+}
+
 void StructuredTopology::writeMetadata( xdm::XmlMetadataWrapper& xml ) {
   Topology::writeMetadata( xml );
 
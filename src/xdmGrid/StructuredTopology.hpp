@@ -36,7 +36,9 @@ class StructuredTopologyVectorRefImpFactory;
 
 /// Grid topology for which connectivity is implicit.  Namely, node i is
 /// connected to node i+1.  Examples of structured topologies are grid
-/// topologies in two or three dimensions.
+/// topologies in one, two or three dimensions, though any rank is supported.
+/// The connectivity is never stored; it is computed from the element index
+/// and the shape when it is requested.
 class StructuredTopology : public Topology {
 public:
   StructuredTopology();
@@ -45,7 +47,7 @@ public:
   XDM_META_ITEM( StructuredTopology );
 
   /// Get the node odering for the shape of these elements. Always returns ExodusII because
-  /// the elements are either quads or hexes.
+  /// the elements are edges, quads, hexes or their higher dimensional analogue.
   virtual NodeOrderingConvention::Type nodeOrdering() const;
 
   /// Set the shape defined by the elements in the topology.  This shape should
@@ -62,20 +64,66 @@ public:
   /// should have no knowledge of geometric mesh properties.
   const xdm::DataShape<>& shape() const;
 
-  /// Get the type of a particular element. For structured meshes this always returns
-  /// a quad or hex.
+  /// Get the type of a particular element. For structured meshes this returns an edge,
+  /// a quad or a hex for ranks 1, 2 and 3, and a hypercube for higher ranks.
   virtual xdm::RefPtr< const ElementTopology > elementTopology(
     const std::size_t& elementIndex ) const;
 
+  /// Generate the connectivity for a range of elements without computing the
+  /// nodes one at a time through the element connectivity.
+  virtual void copyConnectivity(
+    std::size_t firstElement,
+    std::size_t numberOfElements,
+    std::size_t* out ) const;
+
   virtual void writeMetadata( xdm::XmlMetadataWrapper& xml );
 
 private:
   friend class StructuredTopologyVectorRefImpFactory;
-  std::vector< std::size_t > mNodes;
   xdm::DataShape<> mShape;
   xdm::RefPtr< const ElementTopology > mElementTopology;
 };
 
+/// Connectivity of a structured topology computed with stride arithmetic. The nodes of an
+/// element are the node of its lowest corner plus a fixed offset for each corner, so no
+/// per-element storage is needed regardless of the size of the mesh.
+///
+/// There are no stored nodes to refer to, so the connectivity is best read by value through
+/// value(). at() computes the node into a scratch value so that non-const indexing works, but
+/// writes through that reference do not change the topology.
+class StructuredConnectivityImp : public xdm::VectorRefImp< std::size_t > {
+public:
+  /// @param elementShape The number of elements along each dimension, fastest varying first.
+  explicit StructuredConnectivityImp( const xdm::DataShape<>& elementShape );
+  virtual ~StructuredConnectivityImp();
+
+  /// Compute node i of the element at baseIndex into a scratch value. The reference is only
+  /// valid until the next call.
+  virtual const std::size_t& at( std::size_t baseIndex, std::size_t i ) const;
+
+  /// Compute node i of the element at baseIndex.
+  virtual std::size_t value( std::size_t baseIndex, std::size_t i ) const;
+
+  /// @returns The number of nodes per element, 2^rank.
+  virtual std::size_t size() const;
+
+  /// Compute node i of an element directly.
+  std::size_t node( std::size_t elementIndex, std::size_t i ) const;
+
+  /// Compute the node at the lowest corner of an element.
+  std::size_t cornerNode( std::size_t elementIndex ) const;
+
+  /// Write the nodes of a range of elements to out, one element after another. The corner
+  /// node is only recomputed at the start of each row of elements along the first dimension.
+  void copyNodes( std::size_t firstElement, std::size_t numberOfElements, std::size_t* out ) const;
+
+private:
+  std::vector< std::size_t > mElementCounts;
+  std::vector< std::size_t > mNodeStrides;
+  std::vector< std::size_t > mCornerOffsets;
+  mutable std::size_t mScratch;
+};
+
 /// Implementation class to define the shared vector reference implementation for 
 /// StructuredTopology.
 class StructuredTopologyVectorRefImpFactory :
@@ -27,6 +27,7 @@
 #include <cassert>
 #include <functional>
 #include <stdexcept>
+#include <vector>
 
 #include <xdm/ThrowMacro.hpp>
 
@@ -85,6 +86,48 @@ void TensorProductGeometry::writeMetadata( xdm::XmlMetadataWrapper& xml ) {
   }
 }
 
+void TensorProductGeometry::copyNodeRow( std::size_t nodeIndex, double* out ) const
+{
+  xdm::RefPtr< const xdm::TensorProductArraysImp< double > > imp =
+    xdm::static_pointer_cast< const xdm::TensorProductArraysImp< double > >( nodeLayout() );
+  imp->copyRow( nodeIndex, out );
+}
+
+void TensorProductGeometry::copyCoordinates(
+  std::size_t firstNode,
+  std::size_t numberOfNodes,
+  double* out ) const
+{
+  xdm::RefPtr< const xdm::TensorProductArraysImp< double > > imp =
+    xdm::static_pointer_cast< const xdm::TensorProductArraysImp< double > >( nodeLayout() );
+  const std::size_t dim = dimension();
+  const std::size_t rowSize = imp->rowSize();
+  if ( dim == 0 || rowSize == 0 ) {
+    return;
+  }
+
+  // Whole rows are written straight to the output. Partial rows at either end of the range
+  // go through a scratch row.
+  std::vector< double > scratch;
+  std::size_t node = firstNode;
+  const std::size_t last = firstNode + numberOfNodes;
+  while ( node < last ) {
+    std::size_t rowStart = node - node % rowSize;
+    std::size_t rowEnd = std::min( last, rowStart + rowSize );
+    if ( node == rowStart && rowEnd == rowStart + rowSize ) {
+      out = imp->copyRow( node, out );
+    } else {
+      scratch.resize( rowSize * dim );
+      imp->copyRow( node, &scratch[0] );
+      out = std::copy(
+        scratch.begin() + ( node - rowStart ) * dim,
+        scratch.begin() + ( rowEnd - rowStart ) * dim,
+        out );
+    }
+    node = rowEnd;
+  }
+}
+
 xdm::RefPtr< xdm::VectorRefImp< double > > TensorProductGeometry::createVectorImp()
 {
   std::vector< double* > coordinateArrays( dimension() );
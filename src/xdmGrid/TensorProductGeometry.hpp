@@ -57,6 +57,18 @@ public:
   /// @param dim The dimension.
   std::size_t numberOfCoordinates( const std::size_t& dim ) const;
 
+  /// Copy the coordinates of the row of nodes along the first axis that contains a node, one
+  /// node after another. This is much cheaper than reading the row node by node.
+  /// @param nodeIndex The index of any node in the row.
+  /// @param out Array with room for numberOfCoordinates( 0 ) * dimension() values.
+  void copyNodeRow( std::size_t nodeIndex, double* out ) const;
+
+  /// Copy the coordinates of a range of nodes a row at a time.
+  virtual void copyCoordinates(
+    std::size_t firstNode,
+    std::size_t numberOfNodes,
+    double* out ) const;
+
   virtual void writeMetadata( xdm::XmlMetadataWrapper& xml );
 
 protected:
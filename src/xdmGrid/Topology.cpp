@@ -21,6 +21,7 @@
 #include <xdmGrid/Topology.hpp>
 
 #include <algorithm>
+#include <cassert>
 
 namespace xdmGrid {
 
@@ -44,10 +45,32 @@ std::size_t Topology::numberOfElements() const {
 }
 
 ConstElementConnectivity Topology::elementConnections( std::size_t elementIndex ) const {
+  return ConstElementConnectivity( sharedVectorImp(), elementIndex );
+}
+
+xdm::RefPtr< const xdm::VectorRefImp< std::size_t > > Topology::connectivityLayout() const {
+  return sharedVectorImp();
+}
+
+void Topology::copyConnectivity(
+  std::size_t firstElement,
+  std::size_t numberOfElements,
+  std::size_t* out ) const {
+  assert( firstElement + numberOfElements <= mNumberOfElements );
+  xdm::RefPtr< const xdm::VectorRefImp< std::size_t > > imp = sharedVectorImp();
+  std::size_t nodesPerElement = imp->size();
+  for ( std::size_t element = 0; element < numberOfElements; ++element ) {
+    for ( std::size_t node = 0; node < nodesPerElement; ++node ) {
+      *out++ = imp->value( firstElement + element, node );
+    }
+  }
+}
+
+xdm::RefPtr< xdm::VectorRefImp< std::size_t > > Topology::sharedVectorImp() const {
   if ( ! mSharedVectorImp ) {
     mSharedVectorImp = mSharedVectorFactory->createVectorRefImp();
   }
-  return ConstElementConnectivity( mSharedVectorImp, elementIndex );
+  return mSharedVectorImp;
 }
 
 void Topology::traverse( xdm::ItemVisitor& iv ) {
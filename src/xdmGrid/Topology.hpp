@@ -61,6 +61,21 @@ public:
   /// Get the const connectivity of a single Element.
   ConstElementConnectivity elementConnections( std::size_t elementIndex ) const;
 
+  /// Get the implementation shared by all element connectivity references. Holding onto
+  /// this allows node indices to be read for many elements without creating a
+  /// ConstElementConnectivity for each one.
+  xdm::RefPtr< const xdm::VectorRefImp< std::size_t > > connectivityLayout() const;
+
+  /// Copy the node indices of a range of Elements to a flat array, one Element after another.
+  /// Subclasses override this with a faster copy for their connectivity layout.
+  /// @param firstElement The index of the first Element to copy.
+  /// @param numberOfElements The number of Elements to copy.
+  /// @param out Array with room for numberOfElements times the nodes per Element.
+  virtual void copyConnectivity(
+    std::size_t firstElement,
+    std::size_t numberOfElements,
+    std::size_t* out ) const;
+
   /// Get the type of a particular Element.
   virtual xdm::RefPtr< const ElementTopology > elementTopology(
     const std::size_t& elementIndex ) const = 0;
@@ -72,6 +87,8 @@ public:
   virtual void writeMetadata( xdm::XmlMetadataWrapper& xml );
 
 private:
+  xdm::RefPtr< xdm::VectorRefImp< std::size_t > > sharedVectorImp() const;
+
   mutable xdm::RefPtr< xdm::VectorRefImpFactory< std::size_t > > mSharedVectorFactory;
   mutable xdm::RefPtr< xdm::VectorRefImp< std::size_t > > mSharedVectorImp;
   std::size_t mNumberOfElements;
@@ -203,6 +203,11 @@ Element UniformGrid::element( const std::size_t& elementIndex ) const
   return Element( mElementImp, mTopology->elementTopology( elementIndex ), elementIndex );
 }
 
+ElementRange UniformGrid::elements() const
+{
+  return ElementRange( *mTopology, *mGeometry );
+}
+
 Node UniformGrid::node( std::size_t nodeIndex ) {
   return mGeometry->node( nodeIndex );
 }
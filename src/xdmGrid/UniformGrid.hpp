@@ -86,6 +86,11 @@ public:
   /// Get an element by index. All elements are const in that they only have const functions.
   virtual Element element( const std::size_t& elementIndex ) const;
 
+  /// Get all elements as a range of lightweight views. This is the preferred way to loop over
+  /// the elements of the grid since no reference counted objects are copied per element.
+  /// @pre The geometry and topology have been set.
+  ElementRange elements() const;
+
   /// Get a node by index. This does not take connectivity into consideration.
   /// This means that the input index is the index into the geometry directly,
   /// not into the grid with a node order specified by the topology.
@@ -20,6 +20,8 @@
 //------------------------------------------------------------------------------
 #include <xdmGrid/UnstructuredTopology.hpp>
 
+#include <algorithm>
+#include <cassert>
 #include <sstream>
 
 namespace xdmGrid {
@@ -78,6 +80,18 @@ void UnstructuredTopology::setConnectivity( xdm::RefPtr< xdm::UniformDataItem >
   mConnectivity = connectivity;
 }
 
+void UnstructuredTopology::copyConnectivity(
+  std::size_t firstElement,
+  std::size_t numberOfElements,
+  std::size_t* out ) const {
+  assert( firstElement + numberOfElements <= this->numberOfElements() );
+  // The connectivity is a single array of node indices, so the range is contiguous.
+  xdm::RefPtr< const xdm::VectorRefImp< std::size_t > > imp = connectivityLayout();
+  std::size_t nodesPerElement = imp->size();
+  const std::size_t* source = imp->data( 0 ) + firstElement * nodesPerElement;
+  std::copy( source, source + numberOfElements * nodesPerElement, out );
+}
+
 void UnstructuredTopology::traverse( xdm::ItemVisitor& iv ) {
   if ( mConnectivity.valid() ) {
     mConnectivity->accept( iv );
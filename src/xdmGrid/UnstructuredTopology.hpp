@@ -60,6 +60,12 @@ public:
   /// topology type.
   void setConnectivity( xdm::RefPtr< xdm::UniformDataItem > connectivity );
 
+  /// Copy a range of the connectivity array directly.
+  virtual void copyConnectivity(
+    std::size_t firstElement,
+    std::size_t numberOfElements,
+    std::size_t* out ) const;
+
   virtual void traverse( xdm::ItemVisitor& iv );
 
   virtual void writeMetadata( xdm::XmlMetadataWrapper& xml );
@@ -0,0 +1,150 @@
+//==============================================================================
+// This software developed by Stellar Science Ltd Co and the U.S. Government.
+// Copyright (C) 2009-2010 Stellar Science. Government-purpose rights granted.
+//
+// This file is part of XDM
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//------------------------------------------------------------------------------
+// Measures the cost of reference counting on paths that create and copy many
+// RefPtrs. Build the library with and without XDM_ATOMIC_REFERENCE_COUNT and
+// compare the output to see the overhead of atomic counts on a single thread.
+#include <xdmGrid/test/Cube.hpp>
+
+#include <xdmGrid/Attribute.hpp>
+#include <xdmGrid/CollectionGrid.hpp>
+#include <xdmGrid/Element.hpp>
+#include <xdmGrid/ElementTopology.hpp>
+#include <xdmGrid/InterlacedGeometry.hpp>
+#include <xdmGrid/UniformGrid.hpp>
+#include <xdmGrid/UnstructuredTopology.hpp>
+
+#include <xdm/test/TestHelpers.hpp>
+
+#include <xdm/ReferencedObject.hpp>
+#include <xdm/RefPtr.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+namespace {
+
+// Print the time per operation for a loop of the given length.
+void report( const char * name, std::clock_t start, std::size_t operations ) {
+  double seconds = double( std::clock() - start ) / CLOCKS_PER_SEC;
+  std::printf( "%-24s %10.2f ns/op\n", name, 1.e9 * seconds / operations );
+}
+
+void benchmarkCopy( std::size_t iterations ) {
+  xdm::RefPtr< xdm::ReferencedObject > object( new xdm::ReferencedObject );
+  std::size_t total = 0;
+  std::clock_t start = std::clock();
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    xdm::RefPtr< xdm::ReferencedObject > copy( object );
+    total += copy->referenceCount();
+  }
+  report( "RefPtr copy", start, iterations );
+  if ( total == 0 ) std::printf( "unexpected count\n" );
+}
+
+void benchmarkTreeBuild( CubeOfTets& cube, std::size_t iterations ) {
+  std::clock_t start = std::clock();
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    xdm::RefPtr< xdmGrid::CollectionGrid > collection( new xdmGrid::CollectionGrid );
+    for ( int j = 0; j < 8; ++j ) {
+      xdm::RefPtr< xdmGrid::InterlacedGeometry > geometry(
+        new xdmGrid::InterlacedGeometry( 3 ) );
+      geometry->setCoordinateValues( test::createUniformDataItem(
+        cube.nodeArray(), cube.numberOfNodes() * 3, xdm::primitiveType::kDouble ) );
+
+      xdm::RefPtr< xdmGrid::UnstructuredTopology > topology(
+        new xdmGrid::UnstructuredTopology );
+      topology->setConnectivity( test::createUniformDataItem(
+        cube.connectivityArray(),
+        cube.numberOfElements() * 4,
+        xdm::primitiveType::kLongUnsignedInt ) );
+      topology->setNumberOfElements( cube.numberOfElements() );
+      topology->setElementTopology(
+        xdmGrid::elementFactory( xdmGrid::ElementShape::Tetrahedron, 1 ) );
+
+      xdm::RefPtr< xdmGrid::Attribute > attribute( new xdmGrid::Attribute(
+        xdmGrid::Attribute::kScalar, xdmGrid::Attribute::kNode ) );
+      attribute->setDataItem( test::createUniformDataItem(
+        cube.nodeX(), cube.numberOfNodes(), xdm::primitiveType::kDouble ) );
+
+      xdm::RefPtr< xdmGrid::UniformGrid > grid( new xdmGrid::UniformGrid );
+      grid->setGeometry( geometry );
+      grid->setTopology( topology );
+      grid->addAttribute( attribute );
+      collection->appendGrid( grid );
+    }
+  }
+  report( "tree build (8 grids)", start, iterations );
+}
+
+void benchmarkElementAccess( CubeOfTets& cube, std::size_t iterations ) {
+  xdm::RefPtr< xdmGrid::InterlacedGeometry > geometry(
+    new xdmGrid::InterlacedGeometry( 3 ) );
+  geometry->setCoordinateValues( test::createUniformDataItem(
+    cube.nodeArray(), cube.numberOfNodes() * 3, xdm::primitiveType::kDouble ) );
+  xdm::RefPtr< xdmGrid::UnstructuredTopology > topology(
+    new xdmGrid::UnstructuredTopology );
+  topology->setConnectivity( test::createUniformDataItem(
+    cube.connectivityArray(),
+    cube.numberOfElements() * 4,
+    xdm::primitiveType::kLongUnsignedInt ) );
+  topology->setNumberOfElements( cube.numberOfElements() );
+  topology->setElementTopology(
+    xdmGrid::elementFactory( xdmGrid::ElementShape::Tetrahedron, 1 ) );
+  xdmGrid::UniformGrid grid;
+  grid.setGeometry( geometry );
+  grid.setTopology( topology );
+
+  double sum = 0.0;
+  std::clock_t start = std::clock();
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    xdmGrid::Element element = grid.element( i % cube.numberOfElements() );
+    for ( std::size_t node = 0; node < element.numberOfNodes(); ++node ) {
+      sum += element.node( node )[0];
+    }
+  }
+  report( "element access", start, iterations );
+
+  xdmGrid::ElementRange range = grid.elements();
+  start = std::clock();
+  for ( std::size_t i = 0; i < iterations; ++i ) {
+    xdmGrid::ElementView element = range[ i % range.size() ];
+    for ( std::size_t node = 0; node < element.numberOfNodes(); ++node ) {
+      sum += element.coordinate( node, 0 );
+    }
+  }
+  report( "element view access", start, iterations );
+  if ( sum < 0.0 ) std::printf( "unexpected sum\n" );
+}
+
+} // namespace
+
+int main( int argc, char * argv[] ) {
+  std::size_t scale = ( argc > 1 ) ? std::atoi( argv[1] ) : 1;
+  std::printf( "Atomic reference counts: %s\n",
+    xdm::ReferencedObject::hasAtomicReferenceCount() ? "on" : "off" );
+
+  CubeOfTets cube;
+  benchmarkCopy( scale * 10000000 );
+  benchmarkTreeBuild( cube, scale * 2000 );
+  benchmarkElementAccess( cube, scale * 1000000 );
+  return 0;
+}
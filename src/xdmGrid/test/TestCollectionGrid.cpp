@@ -198,6 +198,54 @@ BOOST_AUTO_TEST_CASE( indirectElementAccess ) {
 
 }
 
+BOOST_AUTO_TEST_CASE( sequentialElementAccess ) {
+  CubeOfTets cube;
+  xdm::RefPtr< xdmGrid::UniformGrid > grid0 = cubeGrid( cube );
+
+  // Reference elements 4 and 1, then nothing, then the whole cube.
+  std::size_t someElements[] = { 4, 1 };
+  xdm::RefPtr< xdm::UniformDataItem > someItem = test::createUniformDataItem(
+    someElements, 2, xdm::primitiveType::kLongUnsignedInt );
+  xdm::RefPtr< xdm::UniformDataItem > noItem = test::createUniformDataItem(
+    someElements, 0, xdm::primitiveType::kLongUnsignedInt );
+
+  xdmGrid::CollectionGrid collection;
+  BOOST_CHECK_EQUAL( 0, collection.numberOfElements() );
+  BOOST_CHECK( collection.beginElements() == collection.endElements() );
+
+  collection.appendGrid( grid0, someItem );
+  collection.appendGrid( grid0, noItem );
+  BOOST_CHECK_EQUAL( 2, collection.numberOfElements() );
+  collection.appendGrid( grid0 );
+  BOOST_REQUIRE_EQUAL( 7, collection.numberOfElements() );
+
+  std::size_t elementMap[] = { 4, 1, 0, 1, 2, 3, 4 };
+  std::size_t count = 0;
+  for ( xdmGrid::CollectionGrid::ConstElementIterator it = collection.beginElements();
+    it != collection.endElements(); ++it, ++count ) {
+    BOOST_REQUIRE( count < 7 );
+    BOOST_CHECK_EQUAL( count, it.index() );
+    xdmGrid::Element elementOrig = grid0->element( elementMap[ count ] );
+    xdmGrid::Element elementSequential = *it;
+    xdmGrid::Element elementRandom = collection.element( count );
+    for ( std::size_t nodeIndex = 0; nodeIndex < 4; ++nodeIndex ) {
+      for ( std::size_t dim = 0; dim < 3; ++dim ) {
+        BOOST_CHECK_EQUAL(
+          elementOrig.node( nodeIndex )[ dim ], elementSequential.node( nodeIndex )[ dim ] );
+        BOOST_CHECK_EQUAL(
+          elementOrig.node( nodeIndex )[ dim ], elementRandom.node( nodeIndex )[ dim ] );
+      }
+    }
+  }
+  BOOST_CHECK_EQUAL( 7, count );
+
+  // Shrinking a referenced grid is seen as soon as the collection is accessed.
+  xdm::RefPtr< xdmGrid::UnstructuredTopology > topology =
+    xdm::dynamic_pointer_cast< xdmGrid::UnstructuredTopology >( grid0->topology() );
+  topology->setNumberOfElements( 3 );
+  BOOST_CHECK_EQUAL( 5, collection.numberOfElements() );
+}
+
 BOOST_AUTO_TEST_CASE( faceAccess ) {
 
   // A smaller, easier version of the above test. Added face access testing.
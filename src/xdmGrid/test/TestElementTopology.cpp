@@ -606,4 +606,19 @@ BOOST_AUTO_TEST_CASE( hex ) {
   }
 }
 
+BOOST_AUTO_TEST_CASE( hypercube ) {
+  xdm::RefPtr< const xdmGrid::ElementTopology > hypercube =
+    xdmGrid::elementFactory( xdmGrid::ElementShape::Hypercube, 1 );
+  BOOST_REQUIRE( hypercube );
+  BOOST_CHECK_EQUAL( hypercube->shape(), xdmGrid::ElementShape::Hypercube );
+  BOOST_CHECK_EQUAL( hypercube->numberOfNodes(), 16 );
+  BOOST_CHECK_EQUAL( xdmGrid::elementDimension( hypercube->shape() ),
+    xdmGrid::ElementDimension::Hypervolume );
+
+  xdm::RefPtr< const xdmGrid::ElementTopology > hypercube5 = xdmGrid::hypercubeFactory( 5 );
+  BOOST_CHECK_EQUAL( hypercube5->name(), "Hypercube5" );
+  BOOST_CHECK_EQUAL( hypercube5->numberOfNodes(), 32 );
+  BOOST_CHECK_EQUAL( hypercube5->node( 31 ), 31 );
+}
+
 } // namespace
@@ -62,5 +62,42 @@ BOOST_AUTO_TEST_CASE( nodeAccess ) {
   BOOST_CHECK_EQUAL( 1., g.node( 7 )[2] );
 }
 
+BOOST_AUTO_TEST_CASE( stridedNodeLayout ) {
+  xdmGrid::InterlacedGeometry g(3);
+
+  CubeOfTets cube;
+  xdm::RefPtr< xdm::UniformDataItem > nodeList = test::createUniformDataItem(
+    cube.nodeArray(), cube.numberOfNodes() * 3, xdm::primitiveType::kDouble );
+  g.setCoordinateValues( nodeList );
+
+  xdm::RefPtr< const xdm::VectorRefImp< double > > layout = g.nodeLayout();
+  BOOST_REQUIRE( layout->isStrided() );
+  BOOST_CHECK_EQUAL( 3, layout->stride() );
+
+  // Sum the z coordinates through the raw pointer.
+  const double * z = layout->data( 2 );
+  double sum = 0.0;
+  for ( std::size_t n = 0; n < cube.numberOfNodes(); ++n, z += layout->stride() ) {
+    sum += *z;
+  }
+  BOOST_CHECK_EQUAL( 4., sum );
+}
+
+BOOST_AUTO_TEST_CASE( copyCoordinates ) {
+  xdmGrid::InterlacedGeometry g(3);
+
+  CubeOfTets cube;
+  g.setCoordinateValues( test::createUniformDataItem(
+    cube.nodeArray(), cube.numberOfNodes() * 3, xdm::primitiveType::kDouble ) );
+
+  double coordinates[ 6 * 3 ];
+  g.copyCoordinates( 2, 6, coordinates );
+  for ( std::size_t n = 0; n < 6; ++n ) {
+    for ( std::size_t i = 0; i < 3; ++i ) {
+      BOOST_CHECK_EQUAL( g.node( n + 2 )[i], coordinates[ n * 3 + i ] );
+    }
+  }
+}
+
 } // namespace
 
@@ -64,5 +64,26 @@ BOOST_AUTO_TEST_CASE( nodeAccess ) {
   BOOST_CHECK_EQUAL( 1., g.node( 7 )[2] );
 }
 
+BOOST_AUTO_TEST_CASE( copyCoordinates ) {
+  xdmGrid::MultiArrayGeometry g(3);
+
+  CubeOfTets cube;
+  g.setCoordinateValues( 0, test::createUniformDataItem(
+    cube.nodeX(), cube.numberOfNodes(), xdm::primitiveType::kDouble ) );
+  g.setCoordinateValues( 1, test::createUniformDataItem(
+    cube.nodeY(), cube.numberOfNodes(), xdm::primitiveType::kDouble ) );
+  g.setCoordinateValues( 2, test::createUniformDataItem(
+    cube.nodeZ(), cube.numberOfNodes(), xdm::primitiveType::kDouble ) );
+
+  // The output is interlaced even though the storage is not.
+  double coordinates[ 6 * 3 ];
+  g.copyCoordinates( 2, 6, coordinates );
+  for ( std::size_t n = 0; n < 6; ++n ) {
+    for ( std::size_t i = 0; i < 3; ++i ) {
+      BOOST_CHECK_EQUAL( g.node( n + 2 )[i], coordinates[ n * 3 + i ] );
+    }
+  }
+}
+
 } // namespace
 
@@ -23,6 +23,8 @@
 
 #include <xdmGrid/StructuredTopology.hpp>
 
+#include <vector>
+
 namespace {
 
 BOOST_AUTO_TEST_CASE( writeMetadata ) {
@@ -46,5 +48,107 @@ BOOST_AUTO_TEST_CASE( writeMetadata ) {
   BOOST_CHECK_EQUAL( "4 3 2", xml.attribute( "Dimensions" ) );
 }
 
+BOOST_AUTO_TEST_CASE( connectivity1D ) {
+  xdmGrid::StructuredTopology t;
+  t.setShape( xdm::makeShape( 4 ) );
+
+  BOOST_CHECK_EQUAL( 4, t.numberOfElements() );
+  BOOST_CHECK_EQUAL( xdmGrid::ElementShape::Curve, t.elementTopology( 0 )->shape() );
+  for ( std::size_t e = 0; e < 4; ++e ) {
+    xdmGrid::ConstElementConnectivity c = t.elementConnections( e );
+    BOOST_REQUIRE_EQUAL( 2, c.size() );
+    BOOST_CHECK_EQUAL( e, c[0] );
+    BOOST_CHECK_EQUAL( e + 1, c[1] );
+  }
+}
+
+BOOST_AUTO_TEST_CASE( connectivity2D ) {
+  xdmGrid::StructuredTopology t;
+  t.setShape( xdm::makeShape( 3, 2 ) );
+
+  // Element 4 is at x = 1, y = 1 in a mesh with 4 nodes along x.
+  xdmGrid::ConstElementConnectivity c = t.elementConnections( 4 );
+  BOOST_REQUIRE_EQUAL( 4, c.size() );
+  BOOST_CHECK_EQUAL( 5, c[0] );
+  BOOST_CHECK_EQUAL( 6, c[1] );
+  BOOST_CHECK_EQUAL( 10, c[2] );
+  BOOST_CHECK_EQUAL( 9, c[3] );
+}
+
+BOOST_AUTO_TEST_CASE( connectivity3D ) {
+  xdmGrid::StructuredTopology t;
+  t.setShape( xdm::makeShape( 1, 2, 3 ) );
+
+  // Element 5 is at x = 0, y = 1, z = 2 with 2x3 nodes in each z plane.
+  xdmGrid::ConstElementConnectivity c = t.elementConnections( 5 );
+  BOOST_REQUIRE_EQUAL( 8, c.size() );
+  std::size_t expected[] = { 14, 15, 17, 16, 20, 21, 23, 22 };
+  for ( std::size_t i = 0; i < 8; ++i ) {
+    BOOST_CHECK_EQUAL( expected[i], c[i] );
+  }
+}
+
+BOOST_AUTO_TEST_CASE( connectivity4D ) {
+  xdm::DataShape<> shape( 4 );
+  shape[0] = 2;
+  shape[1] = 2;
+  shape[2] = 2;
+  shape[3] = 2;
+  xdmGrid::StructuredTopology t;
+  t.setShape( shape );
+
+  BOOST_CHECK_EQUAL( 16, t.numberOfElements() );
+  BOOST_CHECK_EQUAL( 16, t.elementTopology( 0 )->numberOfNodes() );
+
+  // The last element starts at node (1,1,1,1) of a 3x3x3x3 node grid. The last corner is
+  // offset by one node along every dimension but the first.
+  xdmGrid::ConstElementConnectivity c = t.elementConnections( 15 );
+  BOOST_REQUIRE_EQUAL( 16, c.size() );
+  BOOST_CHECK_EQUAL( 1 + 3 + 9 + 27, c[0] );
+  BOOST_CHECK_EQUAL( 40 + 3 + 9 + 27, c[15] );
+}
+
+BOOST_AUTO_TEST_CASE( copyConnectivity ) {
+  xdmGrid::StructuredTopology t;
+  t.setShape( xdm::makeShape( 3, 2, 2 ) );
+
+  // Start and end the range part way through a row of elements.
+  std::vector< std::size_t > out( 8 * 8 );
+  t.copyConnectivity( 2, 8, &out[0] );
+  for ( std::size_t e = 0; e < 8; ++e ) {
+    xdmGrid::ConstElementConnectivity c = t.elementConnections( e + 2 );
+    for ( std::size_t i = 0; i < 8; ++i ) {
+      BOOST_CHECK_EQUAL( c[i], out[ e * 8 + i ] );
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( connectivityOfTwoElementsAtOnce ) {
+  xdmGrid::StructuredTopology t;
+  t.setShape( xdm::makeShape( 3, 2 ) );
+
+  // Values read from one element must not change when another element is read.
+  xdmGrid::ConstElementConnectivity first = t.elementConnections( 0 );
+  xdmGrid::ConstElementConnectivity second = t.elementConnections( 4 );
+  const std::size_t& a = first[2];
+  const std::size_t& b = second[2];
+  BOOST_CHECK_EQUAL( 5, a );
+  BOOST_CHECK_EQUAL( 10, b );
+  BOOST_CHECK_EQUAL( 1, first[1] );
+  BOOST_CHECK_EQUAL( 6, second[1] );
+  BOOST_CHECK_EQUAL( 5, a );
+}
+
+BOOST_AUTO_TEST_CASE( nonConstIndexing ) {
+  // Non-const references index through at(), which computes the node rather than throwing.
+  xdmGrid::ElementConnectivity c(
+    xdm::makeRefPtr( new xdmGrid::StructuredConnectivityImp( xdm::makeShape( 3, 2 ) ) ), 4 );
+  BOOST_REQUIRE_EQUAL( 4, c.size() );
+  BOOST_CHECK_EQUAL( 5, c[0] );
+  BOOST_CHECK_EQUAL( 6, c[1] );
+  BOOST_CHECK_EQUAL( 10, c[2] );
+  BOOST_CHECK_EQUAL( 9, c[3] );
+}
+
 } // namespace 
 
@@ -27,6 +27,8 @@
 
 #include <xdm/test/TestHelpers.hpp>
 
+#include <vector>
+
 namespace {
 
 BOOST_AUTO_TEST_CASE( writeMetadata ) {
@@ -70,6 +72,37 @@ BOOST_AUTO_TEST_CASE( nodeAccess3D ) {
   BOOST_CHECK_CLOSE( 0.25, g.node( 17 )[0], 1.e-8 );
   BOOST_CHECK_CLOSE( 0.40, g.node( 17 )[1], 1.e-8 );
   BOOST_CHECK_CLOSE( 0.30, g.node( 17 )[2], 1.e-8 );
+
+  // The row containing node17 matches node by node access.
+  std::size_t rowSize = g.numberOfCoordinates( 0 );
+  std::vector< double > row( rowSize * 3 );
+  g.copyNodeRow( 17, &row[0] );
+  std::size_t rowStart = 17 - 17 % rowSize;
+  for ( std::size_t n = 0; n < rowSize; ++n ) {
+    for ( std::size_t i = 0; i < 3; ++i ) {
+      BOOST_CHECK_EQUAL( row[ n * 3 + i ], g.node( rowStart + n )[i] );
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( copyCoordinates ) {
+  StructuredCube cube;
+  xdmGrid::TensorProductGeometry g(3);
+  for ( std::size_t d = 0; d < 3; ++d ) {
+    g.setCoordinateValues( d, test::createUniformDataItem(
+      cube.axis( d ), cube.axisSize( d ), xdm::primitiveType::kDouble ) );
+  }
+
+  // Cover partial rows at both ends and whole rows in the middle.
+  std::size_t first = g.numberOfCoordinates( 0 ) - 1;
+  std::size_t count = g.numberOfNodes() - first - 1;
+  std::vector< double > out( count * 3 );
+  g.copyCoordinates( first, count, &out[0] );
+  for ( std::size_t n = 0; n < count; ++n ) {
+    for ( std::size_t i = 0; i < 3; ++i ) {
+      BOOST_CHECK_EQUAL( g.node( first + n )[i], out[ n * 3 + i ] );
+    }
+  }
 }
 
 } // namespace
@@ -36,6 +36,8 @@
 
 #include <xdm/ContiguousArray.hpp>
 
+#include <vector>
+
 namespace {
 
 BOOST_AUTO_TEST_CASE( writeMetadata ) {
@@ -89,6 +91,70 @@ BOOST_AUTO_TEST_CASE( elementAccessSingleNodeArray ) {
   }
 }
 
+BOOST_AUTO_TEST_CASE( elementRange ) {
+  CubeOfTets cube;
+  xdm::RefPtr< xdmGrid::InterlacedGeometry > g( new xdmGrid::InterlacedGeometry(3) );
+  g->setCoordinateValues( test::createUniformDataItem(
+    cube.nodeArray(), cube.numberOfNodes() * 3, xdm::primitiveType::kDouble ) );
+
+  xdm::RefPtr< xdmGrid::UnstructuredTopology > t( new xdmGrid::UnstructuredTopology() );
+  t->setConnectivity( test::createUniformDataItem(
+    cube.connectivityArray(), cube.numberOfElements() * 4, xdm::primitiveType::kLongUnsignedInt ) );
+  t->setNumberOfElements( 5 );
+  t->setElementTopology( xdmGrid::elementFactory( xdmGrid::ElementShape::Tetrahedron, 1 ) );
+
+  xdmGrid::UniformGrid grid;
+  grid.setGeometry( g );
+  grid.setTopology( t );
+
+  // The views must agree with the reference counted elements.
+  xdmGrid::ElementRange range = grid.elements();
+  BOOST_REQUIRE_EQUAL( 5, range.size() );
+  BOOST_CHECK_EQUAL( 5, range.end() - range.begin() );
+  std::size_t count = 0;
+  for ( xdmGrid::ElementRange::ConstIterator it = range.begin(); it != range.end(); ++it ) {
+    xdmGrid::ElementView view = *it;
+    xdmGrid::Element element = grid.element( count );
+    BOOST_CHECK_EQUAL( count, view.index() );
+    BOOST_CHECK_EQUAL( xdmGrid::ElementShape::Tetrahedron, view.shape() );
+    BOOST_REQUIRE_EQUAL( 4, view.numberOfNodes() );
+    BOOST_REQUIRE_EQUAL( 3, view.dimension() );
+    for ( std::size_t node = 0; node < 4; ++node ) {
+      BOOST_CHECK_EQUAL( element.nodeIndexInGeometry( node ), view.nodeIndexInGeometry( node ) );
+      for ( std::size_t dim = 0; dim < 3; ++dim ) {
+        BOOST_CHECK_EQUAL( element.node( node )[dim], view.coordinate( node, dim ) );
+      }
+    }
+    ++count;
+  }
+  BOOST_CHECK_EQUAL( 5, count );
+
+  // Structured topologies and tensor product geometries are not strided.
+  std::vector< double > xvalues( 3, 0.0 );
+  xvalues[1] = 1.0;
+  xvalues[2] = 2.0;
+  std::vector< double > yvalues( 2, 0.0 );
+  yvalues[1] = 0.5;
+  xdm::RefPtr< xdmGrid::TensorProductGeometry > tpg( new xdmGrid::TensorProductGeometry(2) );
+  tpg->setCoordinateValues(
+    0, test::createUniformDataItem( &xvalues[0], 3, xdm::primitiveType::kDouble ) );
+  tpg->setCoordinateValues(
+    1, test::createUniformDataItem( &yvalues[0], 2, xdm::primitiveType::kDouble ) );
+  xdm::RefPtr< xdmGrid::StructuredTopology > st( new xdmGrid::StructuredTopology );
+  st->setShape( xdm::makeShape( 2, 1 ) );
+  xdmGrid::UniformGrid structured;
+  structured.setGeometry( tpg );
+  structured.setTopology( st );
+
+  xdmGrid::ElementRange structuredRange = structured.elements();
+  BOOST_REQUIRE_EQUAL( 2, structuredRange.size() );
+  xdmGrid::ElementView second = structuredRange[1];
+  BOOST_CHECK_EQUAL( xdmGrid::ElementShape::Quadrilateral, second.shape() );
+  BOOST_CHECK_EQUAL( 4, second.nodeIndexInGeometry( 3 ) );
+  BOOST_CHECK_EQUAL( 1.0, second.coordinate( 3, 0 ) );
+  BOOST_CHECK_EQUAL( 0.5, second.coordinate( 3, 1 ) );
+}
+
 BOOST_AUTO_TEST_CASE( elementAccessMultiNodeArray ) {
   CubeOfTets cube;
   xdm::RefPtr< xdmGrid::MultiArrayGeometry > g( new xdmGrid::MultiArrayGeometry(3) );
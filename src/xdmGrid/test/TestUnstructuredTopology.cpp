@@ -40,3 +40,18 @@ BOOST_AUTO_TEST_CASE( writeMetadata ) {
   BOOST_CHECK_EQUAL( "4", xml.attribute( "NodesPerElement" ) );
 }
 
+
+BOOST_AUTO_TEST_CASE( copyConnectivity ) {
+  std::size_t connectivity[] = { 0, 1, 2, 1, 2, 3, 2, 3, 4, 3, 4, 5 };
+  xdmGrid::UnstructuredTopology t;
+  t.setConnectivity( test::createUniformDataItem(
+    connectivity, 12, xdm::primitiveType::kLongUnsignedInt ) );
+  t.setNumberOfElements( 4 );
+  t.setElementTopology( xdmGrid::elementFactory( xdmGrid::ElementShape::Triangle, 1 ) );
+
+  std::size_t out[ 6 ];
+  t.copyConnectivity( 1, 2, out );
+  for ( std::size_t i = 0; i < 6; ++i ) {
+    BOOST_CHECK_EQUAL( connectivity[ i + 3 ], out[i] );
+  }
+}
@@ -20,6 +20,7 @@
 //------------------------------------------------------------------------------
 #include <xdmHdf/DatasetIdentifier.hpp>
 #include <xdmHdf/DataspaceIdentifier.hpp>
+#include <xdmHdf/PropertyListIdentifier.hpp>
 
 #include <xdm/DatasetExcept.hpp>
 #include <xdm/ThrowMacro.hpp>
@@ -42,16 +43,7 @@ struct TypeReleaseFunctor {
 };
 typedef ResourceIdentifier< TypeReleaseFunctor > TypeIdentifier;
 
-// RAII object to manage HDF5 property list identifiers.
-struct PListReleaseFunctor {
-  void operator()( hid_t propertyId ) {
-    if ( propertyId != H5P_DEFAULT ) {
-      H5Pclose( propertyId );
-    }
-  }
-};
-typedef ResourceIdentifier< PListReleaseFunctor > PListIdentifier;
-
+// Get the extent of a simple dataspace.
 xdm::DataShape<> h5sToShape( hid_t space ) {
   int rank = H5Sget_simple_extent_ndims( space );
   xdm::DataShape< hsize_t > retvalue( rank );
@@ -74,24 +66,7 @@ xdm::RefPtr< DatasetIdentifier > openExistingDataset(
     datasetId = new DatasetIdentifier( datasetHid );
   }
 
-  // make sure the space on disk and the requested space match
-  xdm::RefPtr< DataspaceIdentifier > datasetSpace(
-      new DataspaceIdentifier( H5Dget_space( datasetId->get() ) ) );
-
-  H5S_class_t datasetSpaceClass = H5Sget_simple_extent_type( datasetSpace->get() );
-  H5S_class_t parameterSpaceClass = H5Sget_simple_extent_type( parameters.dataspace );
-  if ( datasetSpaceClass != parameterSpaceClass ) {
-    XDM_THROW( xdm::DatasetError( parameters.name, "HDF5 dataspace classes don't match." ) );
-  }
-  htri_t equalExtents = H5Sextent_equal( datasetSpace->get(), parameters.dataspace );
-  if ( equalExtents <= 0 ) {
-    xdm::DataShape<> datasetShape = h5sToShape( datasetSpace->get() );
-    xdm::DataShape<> parameterShape = h5sToShape( parameters.dataspace );
-    XDM_THROW( xdm::DataspaceMismatch(
-      parameters.name,
-      datasetShape,
-      parameterShape ) );
-  }
+  checkDataspace( datasetId->get(), parameters );
 
   // return the existing dataset
   return datasetId;
@@ -130,16 +105,43 @@ void setupChunks( hid_t plist, const xdm::DataShape<>& chunkShape, hid_t spaceId
     &(resultShape[0]) );
 }
 
-// Set up a PList identifier for compression with the given level.
-void setupCompression( hid_t plist, size_t level ) {
+// Set up a PList identifier for compression with the given level. Filters
+// run in the order they are added, so the shuffle goes first to group the
+// bytes of each element before they are deflated.
+void setupCompression( hid_t plist, size_t level, bool shuffle ) {
   // make sure compression is available.
   if ( H5Zfilter_avail( H5Z_FILTER_DEFLATE ) ) {
+    if ( shuffle && H5Zfilter_avail( H5Z_FILTER_SHUFFLE ) ) {
+      H5Pset_shuffle( plist );
+    }
     H5Pset_deflate( plist, level );
   }
 }
 
 } // namespace
 
+//------------------------------------------------------------------------------
+void checkDataspace( hid_t dataset, const DatasetParameters& parameters ) {
+  // make sure the space on disk and the requested space match
+  xdm::RefPtr< DataspaceIdentifier > datasetSpace(
+      new DataspaceIdentifier( H5Dget_space( dataset ) ) );
+
+  H5S_class_t datasetSpaceClass = H5Sget_simple_extent_type( datasetSpace->get() );
+  H5S_class_t parameterSpaceClass = H5Sget_simple_extent_type( parameters.dataspace );
+  if ( datasetSpaceClass != parameterSpaceClass ) {
+    XDM_THROW( xdm::DatasetError( parameters.name, "HDF5 dataspace classes don't match." ) );
+  }
+  htri_t equalExtents = H5Sextent_equal( datasetSpace->get(), parameters.dataspace );
+  if ( equalExtents <= 0 ) {
+    xdm::DataShape<> datasetShape = h5sToShape( datasetSpace->get() );
+    xdm::DataShape<> parameterShape = h5sToShape( parameters.dataspace );
+    XDM_THROW( xdm::DataspaceMismatch(
+      parameters.name,
+      datasetShape,
+      parameterShape ) );
+  }
+}
+
 //------------------------------------------------------------------------------
 xdm::RefPtr< DatasetIdentifier > createDatasetIdentifier(
   const DatasetParameters& parameters ) {
@@ -167,13 +169,15 @@ xdm::RefPtr< DatasetIdentifier > createDatasetIdentifier(
 
   // Determine the dataset access properties based off chunking and compression
   // parameters.
-  xdm::RefPtr< PListIdentifier > createPList( new PListIdentifier( H5P_DEFAULT ) );
+  xdm::RefPtr< PropertyListIdentifier > createPList(
+    new PropertyListIdentifier( H5P_DEFAULT ) );
   if ( parameters.chunked ) {
     createPList->reset( H5Pcreate( H5P_DATASET_CREATE ) );
     setupChunks( createPList->get(), parameters.chunkSize, parameters.dataspace );
     // Chunking is enabled, so check for compression and enable it if possible.
     if ( parameters.compress ) {
-      setupCompression( createPList->get(), parameters.compressionLevel );
+      setupCompression( createPList->get(), parameters.compressionLevel,
+        parameters.shuffle );
     }
   }
 
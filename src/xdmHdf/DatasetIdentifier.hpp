@@ -48,15 +48,21 @@ typedef ResourceIdentifier< DatasetReleaseFunctor > DatasetIdentifier;
 struct DatasetParameters {
   hid_t parent; ///< Parent identifier.
   std::string name; ///< String name for the dataset.
-  int type; ///< Datatype for the dataset.
+  hid_t type; ///< Datatype for the dataset.
   hid_t dataspace; ///< HDF5 dataspace identifier.
   xdm::Dataset::InitializeMode mode; ///< Read write or create mode.
   bool chunked; ///< Use chunked IO.
   xdm::DataShape<> chunkSize; ///< the chunk size for chunked IO.
   bool compress; /// Use compression
   int compressionLevel; ///< If using compression, the compression level.
+  bool shuffle; ///< If using compression, shuffle bytes before compressing.
 };
 
+/// Ensure that an open dataset has the dataspace given in the parameters.
+/// @throw DatasetError The dataspace classes differ.
+/// @throw DataspaceMismatch The dataspace extents differ.
+void checkDataspace( hid_t dataset, const DatasetParameters& parameters );
+
 /// Create a Dataset identifier with the given parameters.
 xdm::RefPtr< DatasetIdentifier > createDatasetIdentifier(
   const DatasetParameters& parameters );
@@ -26,8 +26,11 @@
 namespace xdmHdf {
 
 xdm::RefPtr< FileIdentifier >
-createFileIdentifier( const std::string& filename ) {
-  return FileIdentifierRegistry::instance()->findOrCreateIdentifier( filename );
+createFileIdentifier(
+  const std::string& filename,
+  hid_t accessPropertyList ) {
+  return FileIdentifierRegistry::instance()->findOrCreateIdentifier(
+    filename, accessPropertyList );
 }
 
 } // namespace xdmHdf
@@ -43,8 +43,13 @@ public:
 typedef ResourceIdentifier< FileIdentifierReleaseFunctor > FileIdentifier;
 
 /// Non-member function to create a file identifier given a file name.
+/// @param filename The name of the file to open or create.
+/// @param accessPropertyList File access property list used if the file is not
+/// already open.
 xdm::RefPtr< FileIdentifier > 
-createFileIdentifier( const std::string& filename );
+createFileIdentifier(
+  const std::string& filename,
+  hid_t accessPropertyList = H5P_DEFAULT );
 
 } // namespace xdmHdf
 
@@ -19,17 +19,102 @@
 //                                                                             
 //------------------------------------------------------------------------------
 #include <xdmHdf/FileIdentifierRegistry.hpp>
+#include <xdmHdf/PropertyListIdentifier.hpp>
 
 #include <xdm/ThrowMacro.hpp>
 
 #include <hdf5.h>
 
+#include <algorithm>
 #include <stdexcept>
 
 #include <sys/stat.h>
 
 namespace xdmHdf {
 
+namespace {
+
+// Create a file access property list from the client's list with the given
+// settings applied.
+xdm::RefPtr< PropertyListIdentifier > createAccessPropertyList(
+  hid_t accessPropertyList,
+  const FileAccessSettings& settings ) {
+
+  xdm::RefPtr< PropertyListIdentifier > result( new PropertyListIdentifier(
+    ( accessPropertyList == H5P_DEFAULT ) ?
+      H5Pcreate( H5P_FILE_ACCESS ) : H5Pcopy( accessPropertyList ) ) );
+  hid_t plist = result->get();
+
+  if ( settings.chunkCacheBytes > 0 || settings.chunkCacheSlots > 0 ||
+    settings.chunkCachePreemption >= 0.0 ) {
+    // The metadata element count is ignored by the library.
+    int metadataElements;
+    size_t slots;
+    size_t bytes;
+    double preemption;
+    H5Pget_cache( plist, &metadataElements, &slots, &bytes, &preemption );
+    H5Pset_cache(
+      plist,
+      metadataElements,
+      ( settings.chunkCacheSlots > 0 ) ? settings.chunkCacheSlots : slots,
+      ( settings.chunkCacheBytes > 0 ) ? settings.chunkCacheBytes : bytes,
+      ( settings.chunkCachePreemption >= 0.0 ) ? settings.chunkCachePreemption : preemption );
+  }
+
+  if ( settings.metadataCacheBytes > 0 ) {
+    H5AC_cache_config_t config;
+    config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+    H5Pget_mdc_config( plist, &config );
+    config.set_initial_size = true;
+    config.initial_size = settings.metadataCacheBytes;
+    config.min_size = std::min( config.min_size, settings.metadataCacheBytes );
+    config.max_size = std::max( config.max_size, settings.metadataCacheBytes );
+    H5Pset_mdc_config( plist, &config );
+  }
+
+  if ( settings.alignment > 1 ) {
+    H5Pset_alignment( plist, settings.alignmentThreshold, settings.alignment );
+  }
+
+  if ( settings.metaBlockSize > 0 ) {
+    H5Pset_meta_block_size( plist, settings.metaBlockSize );
+  }
+
+  H5Pset_libver_bounds( plist, settings.lowBound, settings.highBound );
+
+  if ( accessPropertyList == H5P_DEFAULT ) {
+    switch ( settings.driver ) {
+    case FileAccessSettings::kSec2Driver:
+      H5Pset_fapl_sec2( plist );
+      break;
+    case FileAccessSettings::kCoreDriver:
+      H5Pset_fapl_core( plist, settings.coreIncrement, settings.coreBackingStore );
+      break;
+    default:
+      break;
+    }
+  }
+
+  return result;
+}
+
+} // namespace
+
+FileAccessSettings::FileAccessSettings() :
+  chunkCacheBytes( 0 ),
+  chunkCacheSlots( 0 ),
+  chunkCachePreemption( -1.0 ),
+  metadataCacheBytes( 0 ),
+  alignmentThreshold( 1 ),
+  alignment( 1 ),
+  metaBlockSize( 0 ),
+  lowBound( H5F_LIBVER_EARLIEST ),
+  highBound( H5F_LIBVER_LATEST ),
+  driver( kDefaultDriver ),
+  coreIncrement( 1024 * 1024 ),
+  coreBackingStore( true ) {
+}
+
 xdm::RefPtr< FileIdentifierRegistry > FileIdentifierRegistry::sInstance;
 
 xdm::RefPtr< FileIdentifierRegistry > FileIdentifierRegistry::instance() {
@@ -40,18 +125,26 @@ xdm::RefPtr< FileIdentifierRegistry > FileIdentifierRegistry::instance() {
 }
 
 FileIdentifierRegistry::FileIdentifierRegistry() :
-  mIdentifierMapping() {
+  mIdentifierMapping(),
+  mIdentifierCache( new IdentifierCache ),
+  mDefaultAccessSettings(),
+  mAccessSettings() {
 }
 
 xdm::RefPtr< FileIdentifier > FileIdentifierRegistry::findOrCreateIdentifier(
-  const std::string& key ) {
+  const std::string& key,
+  hid_t accessPropertyList ) {
   // try to find an existing identifier in the map
   IdentifierMapping::iterator it = mIdentifierMapping.find( key );
   if ( it != mIdentifierMapping.end() ) {
     return it->second;
   }
 
-  // file not yet opened, check if it exists on disk.
+  // file not yet opened, apply the access settings for it.
+  xdm::RefPtr< PropertyListIdentifier > accessList =
+    createAccessPropertyList( accessPropertyList, accessSettings( key ) );
+
+  // check if it exists on disk.
   struct stat buf;
   hid_t fileId;
   if ( stat( key.c_str(), &buf ) == 0 ) {
@@ -59,14 +152,14 @@ xdm::RefPtr< FileIdentifier > FileIdentifierRegistry::findOrCreateIdentifier(
     fileId = H5Fopen(
       key.c_str(),
       H5F_ACC_RDWR,
-      H5P_DEFAULT );
+      accessList->get() );
   } else {
     // file does not exist, create it
     fileId = H5Fcreate( 
       key.c_str(), 
       H5F_ACC_TRUNC,
       H5P_DEFAULT,
-      H5P_DEFAULT );
+      accessList->get() );
   }
 
   // if the identifier is still bad, then something is wrong
@@ -80,9 +173,44 @@ xdm::RefPtr< FileIdentifier > FileIdentifierRegistry::findOrCreateIdentifier(
   return result;
 }
 
+void FileIdentifierRegistry::setDefaultAccessSettings(
+  const FileAccessSettings& settings ) {
+  mDefaultAccessSettings = settings;
+}
+
+const FileAccessSettings& FileIdentifierRegistry::defaultAccessSettings() const {
+  return mDefaultAccessSettings;
+}
+
+void FileIdentifierRegistry::setAccessSettings(
+  const std::string& key,
+  const FileAccessSettings& settings ) {
+  mAccessSettings[key] = settings;
+}
+
+const FileAccessSettings& FileIdentifierRegistry::accessSettings(
+  const std::string& key ) const {
+  SettingsMapping::const_iterator it = mAccessSettings.find( key );
+  if ( it != mAccessSettings.end() ) {
+    return it->second;
+  }
+  return mDefaultAccessSettings;
+}
+
+xdm::RefPtr< IdentifierCache > FileIdentifierRegistry::identifierCache() {
+  return mIdentifierCache;
+}
+
 void FileIdentifierRegistry::closeAllIdentifiers() {
+  mIdentifierCache->clear();
   mIdentifierMapping.clear();
 }
 
+void FileIdentifierRegistry::closeIdentifier( const std::string& key ) {
+  // Cache keys start with the file name followed by a colon.
+  mIdentifierCache->erasePrefix( key + ":" );
+  mIdentifierMapping.erase( key );
+}
+
 } // namespace xdmHdf
 
@@ -22,10 +22,13 @@
 #define xdmHdf_FileIdentifierRegistry_hpp
 
 #include <xdmHdf/FileIdentifier.hpp>
+#include <xdmHdf/IdentifierCache.hpp>
 
 #include <xdm/ReferencedObject.hpp>
 #include <xdm/RefPtr.hpp>
 
+#include <hdf5.h>
+
 #include <map>
 #include <string>
 
@@ -33,6 +36,36 @@
 
 namespace xdmHdf {
 
+/// File access properties that the FileIdentifierRegistry applies when it
+/// opens or creates a file. The defaults leave the HDF5 library defaults in
+/// place; a size of zero means the library default.
+struct FileAccessSettings {
+  /// Low level file drivers.
+  enum Driver {
+    /// Use the driver of the given access property list, sec2 by default.
+    kDefaultDriver,
+    /// Unbuffered POSIX IO.
+    kSec2Driver,
+    /// Keep the whole file in memory and write it when it is closed.
+    kCoreDriver
+  };
+
+  size_t chunkCacheBytes; ///< Raw data chunk cache size for each dataset.
+  size_t chunkCacheSlots; ///< Hash table slots in each chunk cache.
+  double chunkCachePreemption; ///< Preference for evicting fully read chunks, 0-1, negative for the default.
+  size_t metadataCacheBytes; ///< Initial size of the metadata cache.
+  size_t alignmentThreshold; ///< Objects at least this large are aligned.
+  size_t alignment; ///< Alignment of large objects in the file.
+  size_t metaBlockSize; ///< Minimum size of metadata block allocations.
+  H5F_libver_t lowBound; ///< Earliest library version whose format is used.
+  H5F_libver_t highBound; ///< Latest library version whose format is used.
+  Driver driver; ///< The low level file driver.
+  size_t coreIncrement; ///< Memory growth increment for the core driver.
+  bool coreBackingStore; ///< Write core driver files to disk when closed.
+
+  FileAccessSettings();
+};
+
 /// Singleton registry to hold references to an HDF file identifier.  According
 /// to the HDF documentation, a single application should open a file only once.
 /// This registry allows that to happen by caching the identifier for all open
@@ -42,17 +75,49 @@ public:
   static xdm::RefPtr< FileIdentifierRegistry > instance();
   
   /// Get or create an identifier for a given file name.
+  /// @param key The name of the file.
+  /// @param accessPropertyList File access property list to use if the file
+  /// is not yet open. It is ignored if the file is already in the registry,
+  /// so clients that require a particular file driver (for example MPI-IO)
+  /// must be the first to open the file. The access settings for the file
+  /// are applied to a copy of the list; the driver setting is only used with
+  /// the default list, so that a driver chosen by the client is kept.
   xdm::RefPtr< FileIdentifier > findOrCreateIdentifier( 
-    const std::string& key );
+    const std::string& key,
+    hid_t accessPropertyList = H5P_DEFAULT );
+
+  /// Set the access settings used for files without settings of their own.
+  /// Files that are already open are not affected.
+  void setDefaultAccessSettings( const FileAccessSettings& settings );
+  /// Get the access settings used for files without settings of their own.
+  const FileAccessSettings& defaultAccessSettings() const;
+
+  /// Set the access settings for a single file, overriding the defaults.
+  /// @param key The name of the file.
+  void setAccessSettings( const std::string& key, const FileAccessSettings& settings );
+  /// Get the access settings that will be used for a file.
+  /// @param key The name of the file.
+  const FileAccessSettings& accessSettings( const std::string& key ) const;
+
+  /// Get the cache of group and dataset identifiers within the open files.
+  xdm::RefPtr< IdentifierCache > identifierCache();
 
   /// Force the registry to close all open files. A particular file will be
   /// closed only if there are no other objects holding a reference to its
   /// identifier. If any other object is holding a reference to an identifier,
   /// the identifier will remain valid for the lifetime of that object. When all
   /// objects holding the identifier have been destroyed, then the file will be
-  /// closed.
+  /// closed. Cached group and dataset identifiers are released first so they
+  /// do not keep the files open.
   void closeAllIdentifiers();
 
+  /// Force the registry to close a single file. As with closeAllIdentifiers,
+  /// the file is closed once no other object holds a reference to its
+  /// identifier, and cached group and dataset identifiers within the file are
+  /// released first.
+  /// @param key The name of the file.
+  void closeIdentifier( const std::string& key );
+
 private:
   FileIdentifierRegistry();
 
@@ -60,6 +125,10 @@ private:
   typedef std::map< std::string, xdm::RefPtr< FileIdentifier > >
     IdentifierMapping;
   IdentifierMapping mIdentifierMapping;
+  xdm::RefPtr< IdentifierCache > mIdentifierCache;
+  FileAccessSettings mDefaultAccessSettings;
+  typedef std::map< std::string, FileAccessSettings > SettingsMapping;
+  SettingsMapping mAccessSettings;
 };
 
 } // namespace xdmHdf
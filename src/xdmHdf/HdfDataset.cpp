@@ -24,10 +24,15 @@
 #include <xdmHdf/FileIdentifierRegistry.hpp>
 #include <xdmHdf/GroupIdentifier.hpp>
 #include <xdmHdf/HdfDataset.hpp>
+#include <xdmHdf/IdentifierCache.hpp>
+#include <xdmHdf/PropertyListIdentifier.hpp>
 #include <xdmHdf/SelectionVisitor.hpp>
 
 #include <xdm/Algorithm.hpp>
 #include <xdm/DatasetExcept.hpp>
+#include <xdm/DataSelectionVisitor.hpp>
+#include <xdm/FileSystem.hpp>
+#include <xdm/HyperslabDataSelection.hpp>
 #include <xdm/PrimitiveType.hpp>
 #include <xdm/RefPtr.hpp>
 #include <xdm/ThrowMacro.hpp>
@@ -60,7 +65,7 @@ public:
 static HdfInitializationInstruction initHdf;
 
 struct HdfTypeMapping {
-  std::map< xdm::primitiveType::Value, int > mTypeMap;
+  std::map< xdm::primitiveType::Value, hid_t > mTypeMap;
   HdfTypeMapping() {
     mTypeMap[xdm::primitiveType::kChar] = H5T_NATIVE_CHAR;
     mTypeMap[xdm::primitiveType::kShort] = H5T_NATIVE_SHORT;
@@ -81,7 +86,7 @@ struct HdfTypeMapping {
   // sHdfTypeMapping.toHdf( xdm::primitiveType::kInt );
   // sHdfTypeMapping.toXdm( H5T_NATIVE_INT );
   // -- K. R. Walker on 2010-01-19
-  int operator[]( xdm::primitiveType::Value v ) const {
+  hid_t operator[]( xdm::primitiveType::Value v ) const {
     return (mTypeMap.find( v )->second);
   }
 };
@@ -95,8 +100,75 @@ struct AppendGroup {
   }
 };
 
+// Determine the shape of the memory dataspace for an array from the selection
+// that is applied to it. A multi-dimensional hyperslab describes the layout of
+// the array in memory, so HDF can gather/scatter directly from a strided or
+// sub-block region of the array without packing it first. All other
+// selections treat the array as a flat buffer.
+class MemorySpaceShape : public xdm::DataSelectionVisitor {
+public:
+  MemorySpaceShape( xdm::DataShape<>::size_type arraySize ) :
+    mArraySize( arraySize ),
+    mShape( xdm::makeShape( arraySize ) ) {}
+
+  virtual void apply( const xdm::HyperslabDataSelection& selection ) {
+    const xdm::DataShape<>& slabShape = selection.hyperslab().shape();
+    if ( slabShape.rank() > 1 ) {
+      mShape = slabShape;
+    }
+  }
+
+  // Returns true if the shape describes exactly the number of elements in the
+  // array.
+  bool matchesArray() const {
+    xdm::DataShape<>::size_type size = 1;
+    for ( xdm::DataShape<>::size_type i = 0; i < mShape.rank(); ++i ) {
+      size *= mShape[i];
+    }
+    return ( size == mArraySize );
+  }
+
+  const xdm::DataShape<>& shape() const { return mShape; }
+
+private:
+  xdm::DataShape<>::size_type mArraySize;
+  xdm::DataShape<> mShape;
+};
+
 } // namespace anon
 
+//------------------------------------------------------------------------------
+xdm::DataShape<> chooseChunkShape(
+  const xdm::DataShape<>& shape,
+  size_t elementSize,
+  ChunkAccessPattern pattern,
+  size_t targetBytes ) {
+
+  xdm::DataShape<> chunk( shape );
+  size_t rank = shape.rank();
+  if ( rank == 0 ) {
+    return chunk;
+  }
+
+  // Fill the chunk from the fastest varying dimension outward until it holds
+  // the target number of bytes, then take one element in the rest.
+  size_t targetElements = std::max( targetBytes / std::max( elementSize, size_t( 1 ) ),
+    size_t( 1 ) );
+  size_t chunkElements = 1;
+  for ( size_t dim = rank; dim > 0; --dim ) {
+    size_t extent = std::max( shape[dim - 1], xdm::DataShape<>::size_type( 1 ) );
+    size_t fit = std::max( targetElements / chunkElements, size_t( 1 ) );
+    chunk[dim - 1] = std::min( extent, fit );
+    chunkElements *= chunk[dim - 1];
+  }
+
+  // One step per chunk in time.
+  if ( pattern == kTimeSeriesAccess && rank > 1 ) {
+    chunk[0] = 1;
+  }
+  return chunk;
+}
+
 struct HdfDataset::Private {
   std::string mFile;
   GroupPath mGroupPath;
@@ -112,6 +184,15 @@ struct HdfDataset::Private {
 
   bool mUseCompression;
   size_t mCompressionLevel;
+  bool mUseShuffle;
+
+  bool mAutomaticChunking;
+  ChunkAccessPattern mChunkAccessPattern;
+  size_t mTargetChunkBytes;
+
+  FlushPolicy mFlushPolicy;
+  size_t mFlushInterval;
+  size_t mStepsSinceFlush;
 
   Private() :
     mFile(),
@@ -124,7 +205,14 @@ struct HdfDataset::Private {
     mUseChunkedIo( false ),
     mChunkSize(),
     mUseCompression( false ),
-    mCompressionLevel( 6 ) {}
+    mCompressionLevel( 6 ),
+    mUseShuffle( false ),
+    mAutomaticChunking( false ),
+    mChunkAccessPattern( kFullFieldAccess ),
+    mTargetChunkBytes( kDefaultChunkBytes ),
+    mFlushPolicy( kFlushEveryNSteps ),
+    mFlushInterval( 1 ),
+    mStepsSinceFlush( 0 ) {}
   Private( 
     const std::string& file,
     const GroupPath& groupPath,
@@ -139,7 +227,14 @@ struct HdfDataset::Private {
     mUseChunkedIo( false ),
     mChunkSize(),
     mUseCompression( false ),
-    mCompressionLevel( 6 ) {}
+    mCompressionLevel( 6 ),
+    mUseShuffle( false ),
+    mAutomaticChunking( false ),
+    mChunkAccessPattern( kFullFieldAccess ),
+    mTargetChunkBytes( kDefaultChunkBytes ),
+    mFlushPolicy( kFlushEveryNSteps ),
+    mFlushInterval( 1 ),
+    mStepsSinceFlush( 0 ) {}
 };
 
 HdfDataset::HdfDataset() : 
@@ -154,6 +249,9 @@ HdfDataset::HdfDataset(
 }
 
 HdfDataset::~HdfDataset() {
+  if ( imp->mFlushPolicy == kFlushOnClose && imp->mStepsSinceFlush > 0 ) {
+    H5Fflush( imp->mFileId->get(), H5F_SCOPE_GLOBAL );
+  }
 }
 
 void HdfDataset::setFile( const std::string& file ) {
@@ -180,24 +278,118 @@ const std::string& HdfDataset::dataset() const {
   return imp->mDataset;
 }
 
+bool HdfDataset::isSameLocation( const xdm::Dataset& other ) const {
+  const HdfDataset* hdf = dynamic_cast< const HdfDataset* >( &other );
+  if ( !hdf ) {
+    return false;
+  }
+  return ( imp->mDataset == hdf->imp->mDataset
+    && imp->mGroupPath == hdf->imp->mGroupPath
+    && xdm::equivalent( 
+      xdm::FileSystemPath( imp->mFile ), 
+      xdm::FileSystemPath( hdf->imp->mFile ) ) );
+}
+
+void HdfDataset::close() {
+  imp->mDataspaceId.reset();
+  imp->mDatasetId.reset();
+  imp->mGroupId.reset();
+  imp->mFileId.reset();
+  // Closing the file writes everything to disk.
+  imp->mStepsSinceFlush = 0;
+  FileIdentifierRegistry::instance()->closeIdentifier( imp->mFile );
+}
+
 void HdfDataset::setUseChunkedIo( bool value ) {
   imp->mUseChunkedIo = value;
 }
 
+bool HdfDataset::useChunkedIo() const {
+  return imp->mUseChunkedIo;
+}
+
 void HdfDataset::setChunkSize( const xdm::DataShape<>& dimensions ) {
   imp->mChunkSize = dimensions;
 }
 
+const xdm::DataShape<>& HdfDataset::chunkSize() const {
+  return imp->mChunkSize;
+}
+
 void HdfDataset::setUseCompression( bool value ) {
   // chunking is required for compression
   imp->mUseChunkedIo = value;
   imp->mUseCompression = value;
 }
 
+bool HdfDataset::useCompression() const {
+  return imp->mUseCompression;
+}
+
 void HdfDataset::setCompressionLevel( size_t level ) {
   imp->mCompressionLevel = level;
 }
 
+size_t HdfDataset::compressionLevel() const {
+  return imp->mCompressionLevel;
+}
+
+void HdfDataset::setUseShuffle( bool value ) {
+  imp->mUseShuffle = value;
+}
+
+bool HdfDataset::useShuffle() const {
+  return imp->mUseShuffle;
+}
+
+void HdfDataset::setAutomaticChunking(
+  ChunkAccessPattern pattern,
+  size_t chunkBytes ) {
+  imp->mAutomaticChunking = true;
+  imp->mChunkAccessPattern = pattern;
+  imp->mTargetChunkBytes = chunkBytes;
+  setUseCompression( true );
+  setUseShuffle( true );
+}
+
+bool HdfDataset::automaticChunking() const {
+  return imp->mAutomaticChunking;
+}
+
+ChunkAccessPattern HdfDataset::chunkAccessPattern() const {
+  return imp->mChunkAccessPattern;
+}
+
+size_t HdfDataset::targetChunkBytes() const {
+  return imp->mTargetChunkBytes;
+}
+
+void HdfDataset::copyStorageSettings( const HdfDataset& other ) {
+  imp->mUseChunkedIo = other.imp->mUseChunkedIo;
+  imp->mChunkSize = other.imp->mChunkSize;
+  imp->mUseCompression = other.imp->mUseCompression;
+  imp->mCompressionLevel = other.imp->mCompressionLevel;
+  imp->mUseShuffle = other.imp->mUseShuffle;
+  imp->mAutomaticChunking = other.imp->mAutomaticChunking;
+  imp->mChunkAccessPattern = other.imp->mChunkAccessPattern;
+  imp->mTargetChunkBytes = other.imp->mTargetChunkBytes;
+  imp->mFlushPolicy = other.imp->mFlushPolicy;
+  imp->mFlushInterval = other.imp->mFlushInterval;
+}
+
+void HdfDataset::setFlushPolicy( FlushPolicy policy, size_t interval ) {
+  imp->mFlushPolicy = policy;
+  imp->mFlushInterval = std::max( interval, size_t( 1 ) );
+}
+
+HdfDataset::FlushPolicy HdfDataset::flushPolicy() const {
+  return imp->mFlushPolicy;
+}
+
+size_t HdfDataset::flushInterval() const {
+  return imp->mFlushInterval;
+}
+
 void HdfDataset::writeTextContent( xdm::XmlTextContent& text ) {
   std::stringstream out;
   out << imp->mFile << ":";
@@ -223,9 +415,19 @@ xdm::DataShape<> HdfDataset::initializeImplementation(
   // -- K. R. Walker on 2010-01-19
   
   // open the HDF file for writing
-  imp->mFileId = createFileIdentifier( imp->mFile );
+  xdm::RefPtr< PropertyListIdentifier > accessProperties =
+    fileAccessPropertyList();
+  imp->mFileId = createFileIdentifier( imp->mFile, accessProperties->get() );
   hid_t datasetLocId = imp->mFileId->get();
 
+  // Groups and datasets that were opened for an earlier step are reused from
+  // the cache of open identifiers. They are keyed by the path to the object in
+  // the same form that is written to the metadata.
+  xdm::RefPtr< IdentifierCache > cache =
+    FileIdentifierRegistry::instance()->identifierCache();
+  std::stringstream path;
+  path << imp->mFile << ":";
+
   // construct the group in the file.
   if ( !imp->mGroupPath.empty() ) {
     hid_t parentIdentifier = imp->mFileId->get();
@@ -240,14 +442,20 @@ xdm::DataShape<> HdfDataset::initializeImplementation(
       GroupPath::iterator group = imp->mGroupPath.begin();
       group != imp->mGroupPath.end();
       ++group ) {
-      // Note: we are using the raw resource to identify the parent.  This is ok
-      // because the parent resource will be released after the call to 
-      // createGroupIdentifier.
-      imp->mGroupId = createGroupIdentifier( parentIdentifier, *group );
+      path << "/" << *group;
+      imp->mGroupId = cache->findGroup( path.str() );
+      if ( !imp->mGroupId ) {
+        // Note: we are using the raw resource to identify the parent.  This is
+        // ok because the parent resource is held by the cache or released
+        // after the call to createGroupIdentifier.
+        imp->mGroupId = createGroupIdentifier( parentIdentifier, *group );
+        cache->insertGroup( path.str(), imp->mGroupId );
+      }
       parentIdentifier = imp->mGroupId->get();
     }  
     datasetLocId = imp->mGroupId->get();
   }
+  path << "/" << imp->mDataset;
   
   // construct the file space to correspond to the requested shape
   // convert between size type
@@ -261,12 +469,34 @@ xdm::DataShape<> HdfDataset::initializeImplementation(
   creationParameters.dataspace = imp->mDataspaceId->get();
   creationParameters.mode = mode;
   creationParameters.chunked = imp->mUseChunkedIo;
-  creationParameters.chunkSize =
-    ( imp->mChunkSize.rank() != 0 ) ?
-    imp->mChunkSize : shape;
+  if ( imp->mChunkSize.rank() != 0 ) {
+    creationParameters.chunkSize = imp->mChunkSize;
+  } else if ( imp->mAutomaticChunking ) {
+    creationParameters.chunkSize = chooseChunkShape(
+      shape,
+      H5Tget_size( sHdfTypeMapping[type] ),
+      imp->mChunkAccessPattern,
+      imp->mTargetChunkBytes );
+  } else {
+    creationParameters.chunkSize = shape;
+  }
   creationParameters.compress = imp->mUseCompression;
   creationParameters.compressionLevel = imp->mCompressionLevel;
+  creationParameters.shuffle = imp->mUseShuffle;
+
+  // An existing dataset can be reused if it is being read or modified, but a
+  // create replaces it on disk.
+  if ( mode == xdm::Dataset::kCreate ) {
+    cache->erase( path.str() );
+  } else {
+    imp->mDatasetId = cache->findDataset( path.str() );
+    if ( imp->mDatasetId ) {
+      checkDataspace( imp->mDatasetId->get(), creationParameters );
+      return shape;
+    }
+  }
   imp->mDatasetId = createDatasetIdentifier( creationParameters );
+  cache->insertDataset( path.str(), imp->mDatasetId );
   return shape;
 }
 
@@ -281,10 +511,16 @@ void HdfDataset::serializeImplementation(
   const xdm::StructuredArray* data,
   const xdm::DataSelectionMap& selectionMap ) {
 
-  // create the memory space to match the shape of the array
-  // convert between types for size representation
+  // create the memory space to match the shape of the array, as described by
+  // the selection that is applied to it.
+  MemorySpaceShape memoryShape( data->size() );
+  selectionMap.domain()->accept( memoryShape );
+  if ( !memoryShape.matchesArray() ) {
+    XDM_THROW( xdm::DataspaceMismatch( imp->mDataset,
+      memoryShape.shape(), xdm::makeShape( data->size() ) ) );
+  }
   xdm::RefPtr< DataspaceIdentifier > memorySpace =
-    createDataspaceIdentifier( xdm::makeShape( data->size() ) );
+    createDataspaceIdentifier( memoryShape.shape() );
 
   SelectionVisitor memspaceSelector( memorySpace->get() );
   selectionMap.domain()->accept( memspaceSelector );
@@ -300,12 +536,14 @@ void HdfDataset::serializeImplementation(
   }
 
   // write the array to disk
+  xdm::RefPtr< PropertyListIdentifier > transferProperties =
+    transferPropertyList();
   H5Dwrite( 
     imp->mDatasetId->get(), 
     sHdfTypeMapping[data->dataType()], 
     memorySpace->get(), 
     imp->mDataspaceId->get(),
-    H5P_DEFAULT,
+    transferProperties->get(),
     data->data() );
 }
 
@@ -319,9 +557,16 @@ void HdfDataset::deserializeImplementation(
     XDM_THROW( std::runtime_error( "Null array passed for dataset read" ) );
   }
 
-  // create the memory space to match the shape of the array
-  xdm::RefPtr< DataspaceIdentifier > memorySpace = 
-    createDataspaceIdentifier( xdm::makeShape( data->size() ) );
+  // create the memory space to match the shape of the array, as described by
+  // the selection that is applied to it.
+  MemorySpaceShape memoryShape( data->size() );
+  selectionMap.range()->accept( memoryShape );
+  if ( !memoryShape.matchesArray() ) {
+    XDM_THROW( xdm::DataspaceMismatch( imp->mDataset,
+      memoryShape.shape(), xdm::makeShape( data->size() ) ) );
+  }
+  xdm::RefPtr< DataspaceIdentifier > memorySpace =
+    createDataspaceIdentifier( memoryShape.shape() );
 
   // Apply the input selections. The domain is the data on disk, the range is
   // the array.
@@ -339,17 +584,32 @@ void HdfDataset::deserializeImplementation(
   }
 
   // read the data into the array
+  xdm::RefPtr< PropertyListIdentifier > transferProperties =
+    transferPropertyList();
   H5Dread(
     imp->mDatasetId->get(),
     sHdfTypeMapping[data->dataType()],
     memorySpace->get(),
     imp->mDataspaceId->get(),
-    H5P_DEFAULT,
+    transferProperties->get(),
     data->data() );
 }
 
 void HdfDataset::finalizeImplementation() {
-  H5Fflush( imp->mFileId->get(), H5F_SCOPE_GLOBAL );
+  imp->mStepsSinceFlush++;
+  if ( imp->mFlushPolicy == kFlushEveryNSteps &&
+    imp->mStepsSinceFlush >= imp->mFlushInterval ) {
+    H5Fflush( imp->mFileId->get(), H5F_SCOPE_GLOBAL );
+    imp->mStepsSinceFlush = 0;
+  }
+}
+
+xdm::RefPtr< PropertyListIdentifier > HdfDataset::fileAccessPropertyList() {
+  return xdm::makeRefPtr( new PropertyListIdentifier( H5P_DEFAULT ) );
+}
+
+xdm::RefPtr< PropertyListIdentifier > HdfDataset::transferPropertyList() {
+  return xdm::makeRefPtr( new PropertyListIdentifier( H5P_DEFAULT ) );
 }
 
 // -----------------------------------------------------------------------------
@@ -22,6 +22,7 @@
 #define xdmHdf_HdfDataset_hpp
 
 #include <xdm/Dataset.hpp>
+#include <xdm/RefPtr.hpp>
 
 #include <deque>
 #include <memory>
@@ -31,15 +32,58 @@
 
 namespace xdmHdf {
 
+template< typename ResourceReleaseFunctorT > class ResourceIdentifier;
+class PropertyListReleaseFunctor;
+typedef ResourceIdentifier< PropertyListReleaseFunctor > PropertyListIdentifier;
+
 /// Path of groups identifying a location in the HDF file.
 typedef std::deque< std::string > GroupPath;
 
+/// Expected access patterns used to choose a chunk shape.
+enum ChunkAccessPattern {
+  /// The whole dataset is written or read at once.
+  kFullFieldAccess,
+  /// The first dimension is time and the dataset is written one step at a time.
+  kTimeSeriesAccess
+};
+
+/// Default target size of a chunk. This matches the default HDF5 chunk cache
+/// size, so a chunk being filled stays in the cache.
+const size_t kDefaultChunkBytes = 1024 * 1024;
+
+/// Choose chunk dimensions for a dataset that hold about targetBytes each.
+/// Chunks span whole rows of the trailing dimensions where possible, so that
+/// each chunk is a contiguous run of the row major data. For time series
+/// access, a chunk never spans more than one step so that writing a step does
+/// not rewrite chunks from earlier steps.
+/// @param shape The shape of the dataset.
+/// @param elementSize The size of one element in bytes.
+/// @param pattern The expected access pattern.
+/// @param targetBytes The desired size of a chunk in bytes.
+xdm::DataShape<> chooseChunkShape(
+  const xdm::DataShape<>& shape,
+  size_t elementSize,
+  ChunkAccessPattern pattern,
+  size_t targetBytes = kDefaultChunkBytes );
+
 // Code Review Matter (open): Doxygen comment.
 // Did you consider providing documentation for this class so that others may
 // gain understanding of the class interface and caveats of use?
 // Will Dicharry 2010-01-19
 class HdfDataset : public xdm::Dataset {
 public:
+  /// Policies for flushing the HDF file to disk as the dataset is finalized.
+  /// Open file, group, and dataset handles are kept between steps regardless
+  /// of the policy; this only controls when buffered data is forced to disk.
+  enum FlushPolicy {
+    /// Never flush explicitly. Data reaches disk when the file is closed.
+    kFlushNever,
+    /// Flush every flushInterval() calls to finalize.
+    kFlushEveryNSteps,
+    /// Flush once, when the dataset is destroyed.
+    kFlushOnClose
+  };
+
   /// Default constructor does not associate with a file.
   HdfDataset();
 
@@ -89,12 +133,17 @@ public:
   /// of the entire dataset will be used for the chunk size.
   /// @param value Whether or not to use chunked IO.
   void setUseChunkedIo( bool value );
+  /// Determine if chunked IO is enabled.
+  bool useChunkedIo() const;
   /// Set the chunk size for the dataset. Intelligently chosen chunk sizes can
   /// minimize file IO.
   /// @param dimensions Chunk dimensions for the dataset.
   /// @post Initialize must be called with a space of the same rank as the
   /// chunk size.
   void setChunkSize( const xdm::DataShape<>& dimensions );
+  /// Get the chunk size for the dataset. A rank of zero means the chunk size
+  /// has not been set.
+  const xdm::DataShape<>& chunkSize() const;
 
   /// Turn compression on or off for the dataset. Enabling compression implies
   /// that chunked IO must be used. If the HDF5 library was built without the
@@ -102,16 +151,65 @@ public:
   /// @param value Whether or not to compress the data.
   /// @post Compression and Chunked IO are enabled.
   void setUseCompression( bool value );
+  /// Determine if compression is enabled.
+  bool useCompression() const;
   /// Set the compression level for the dataset. Valid values are 0-9. Lower
   /// numbers mean less compression but faster writes, higher numbers yield
   /// more compression but slower write time. Following GZip, the default
   /// compression level is 6.
   /// @param level Integer between 0 and 9 to determine compression level.
   void setCompressionLevel( size_t level );
+  /// Get the compression level for the dataset.
+  size_t compressionLevel() const;
+  /// Turn the shuffle filter on or off. When compressing, the shuffle filter
+  /// groups the bytes of each element together before deflating, which
+  /// usually compresses numeric data much better.
+  void setUseShuffle( bool value );
+  /// Determine if the shuffle filter is enabled.
+  bool useShuffle() const;
+
+  /// Choose the chunk shape at initialization from the dataset shape, element
+  /// size and expected access pattern, aiming for chunks of about chunkBytes.
+  /// This also enables chunked IO, shuffling and compression. A chunk size set
+  /// with setChunkSize takes precedence.
+  /// @see chooseChunkShape
+  void setAutomaticChunking(
+    ChunkAccessPattern pattern,
+    size_t chunkBytes = kDefaultChunkBytes );
+  /// Determine if the chunk shape is chosen automatically.
+  bool automaticChunking() const;
+  /// Get the access pattern used to choose the chunk shape.
+  ChunkAccessPattern chunkAccessPattern() const;
+  /// Get the target size of automatically chosen chunks.
+  size_t targetChunkBytes() const;
+
+  /// Copy the chunking, compression and flush settings of another dataset.
+  void copyStorageSettings( const HdfDataset& other );
+
+  /// Release the file, group, and dataset identifiers held by this dataset
+  /// and ask the FileIdentifierRegistry to close the file. The file is closed
+  /// once no other object refers to it, at which point another process may
+  /// open it. The identifiers are acquired again by the next initialization.
+  void close();
+
+  /// Set when the file is flushed to disk. The default is to flush on every
+  /// step, which is safest but expensive for long time series.
+  /// @param policy The flush policy.
+  /// @param interval For kFlushEveryNSteps, the number of steps between
+  /// flushes. Ignored by the other policies.
+  void setFlushPolicy( FlushPolicy policy, size_t interval = 1 );
+  /// Get the flush policy.
+  FlushPolicy flushPolicy() const;
+  /// Get the number of steps between flushes for kFlushEveryNSteps.
+  size_t flushInterval() const;
 
   //-- Dataset Implementations --//
   virtual const char* format() { return "HDF"; }
 
+  /// Another HdfDataset is at the same location if it names the same dataset
+  /// in the same group of an equivalent file.
+  virtual bool isSameLocation( const xdm::Dataset& other ) const;
+
   // Code Review Matter (open): Namespace Macros
   // There are macros that optionally create namespaces. If the namespaces
   // are not used, then the following member functions should fail to
@@ -138,6 +236,18 @@ public:
 
   virtual void finalizeImplementation();
 
+protected:
+  /// Get the file access property list to use when the file is first opened.
+  /// Subclasses can override this to select a different file driver. The
+  /// default implementation returns the HDF default property list.
+  virtual xdm::RefPtr< PropertyListIdentifier > fileAccessPropertyList();
+
+  /// Get the transfer property list to use when reading and writing raw data.
+  /// Subclasses can override this to change how data moves between memory and
+  /// the file. The default implementation returns the HDF default property
+  /// list.
+  virtual xdm::RefPtr< PropertyListIdentifier > transferPropertyList();
+
 private:
 
   // Code Review Matter (open): imp vs mImp
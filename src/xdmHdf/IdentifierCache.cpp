@@ -0,0 +1,127 @@
+//==============================================================================
+// This software developed by Stellar Science Ltd Co and the U.S. Government.  
+// Copyright (C) 2009 Stellar Science. Government-purpose rights granted.      
+//                                                                             
+// This file is part of XDM                                                    
+//                                                                             
+// This program is free software: you can redistribute it and/or modify it     
+// under the terms of the GNU Lesser General Public License as published by    
+// the Free Software Foundation, either version 3 of the License, or (at your  
+// option) any later version.                                                  
+//                                                                             
+// This program is distributed in the hope that it will be useful, but WITHOUT 
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        
+// License for more details.                                                   
+//                                                                             
+// You should have received a copy of the GNU Lesser General Public License    
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.       
+//                                                                             
+//------------------------------------------------------------------------------
+#include <xdmHdf/IdentifierCache.hpp>
+
+namespace xdmHdf {
+
+IdentifierCache::IdentifierCache( size_t capacity ) :
+  mCapacity( capacity ),
+  mEntries(),
+  mIndex() {
+}
+
+IdentifierCache::~IdentifierCache() {
+}
+
+void IdentifierCache::setCapacity( size_t capacity ) {
+  mCapacity = capacity;
+  shrink();
+}
+
+size_t IdentifierCache::capacity() const {
+  return mCapacity;
+}
+
+size_t IdentifierCache::size() const {
+  return mEntries.size();
+}
+
+xdm::RefPtr< GroupIdentifier > IdentifierCache::findGroup(
+  const std::string& key ) {
+  Entry* entry = touch( key );
+  return entry ? entry->mGroup : xdm::RefPtr< GroupIdentifier >();
+}
+
+void IdentifierCache::insertGroup(
+  const std::string& key,
+  xdm::RefPtr< GroupIdentifier > identifier ) {
+  Entry entry;
+  entry.mKey = key;
+  entry.mGroup = identifier;
+  insert( entry );
+}
+
+xdm::RefPtr< DatasetIdentifier > IdentifierCache::findDataset(
+  const std::string& key ) {
+  Entry* entry = touch( key );
+  return entry ? entry->mDataset : xdm::RefPtr< DatasetIdentifier >();
+}
+
+void IdentifierCache::insertDataset(
+  const std::string& key,
+  xdm::RefPtr< DatasetIdentifier > identifier ) {
+  Entry entry;
+  entry.mKey = key;
+  entry.mDataset = identifier;
+  insert( entry );
+}
+
+void IdentifierCache::erase( const std::string& key ) {
+  EntryIndex::iterator it = mIndex.find( key );
+  if ( it != mIndex.end() ) {
+    mEntries.erase( it->second );
+    mIndex.erase( it );
+  }
+}
+
+void IdentifierCache::erasePrefix( const std::string& prefix ) {
+  EntryIndex::iterator it = mIndex.lower_bound( prefix );
+  while ( it != mIndex.end() && 
+    it->first.compare( 0, prefix.size(), prefix ) == 0 ) {
+    mEntries.erase( it->second );
+    mIndex.erase( it++ );
+  }
+}
+
+void IdentifierCache::clear() {
+  mIndex.clear();
+  mEntries.clear();
+}
+
+IdentifierCache::Entry* IdentifierCache::touch( const std::string& key ) {
+  EntryIndex::iterator it = mIndex.find( key );
+  if ( it == mIndex.end() ) {
+    return 0;
+  }
+  // move the entry to the front of the list without invalidating iterators.
+  mEntries.splice( mEntries.begin(), mEntries, it->second );
+  return &mEntries.front();
+}
+
+void IdentifierCache::insert( const Entry& entry ) {
+  if ( mCapacity == 0 ) {
+    return;
+  }
+  erase( entry.mKey );
+  mEntries.push_front( entry );
+  mIndex[entry.mKey] = mEntries.begin();
+  shrink();
+}
+
+void IdentifierCache::shrink() {
+  while ( mEntries.size() > mCapacity ) {
+    mIndex.erase( mEntries.back().mKey );
+    mEntries.pop_back();
+  }
+}
+
+} // namespace xdmHdf
+
@@ -0,0 +1,112 @@
+//==============================================================================
+// This software developed by Stellar Science Ltd Co and the U.S. Government.  
+// Copyright (C) 2009 Stellar Science. Government-purpose rights granted.      
+//                                                                             
+// This file is part of XDM                                                    
+//                                                                             
+// This program is free software: you can redistribute it and/or modify it     
+// under the terms of the GNU Lesser General Public License as published by    
+// the Free Software Foundation, either version 3 of the License, or (at your  
+// option) any later version.                                                  
+//                                                                             
+// This program is distributed in the hope that it will be useful, but WITHOUT 
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        
+// License for more details.                                                   
+//                                                                             
+// You should have received a copy of the GNU Lesser General Public License    
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.       
+//                                                                             
+//------------------------------------------------------------------------------
+#ifndef xdmHdf_IdentifierCache_hpp
+#define xdmHdf_IdentifierCache_hpp
+
+#include <xdmHdf/DatasetIdentifier.hpp>
+#include <xdmHdf/GroupIdentifier.hpp>
+
+#include <xdm/ReferencedObject.hpp>
+#include <xdm/RefPtr.hpp>
+
+#include <list>
+#include <map>
+#include <string>
+
+
+
+namespace xdmHdf {
+
+/// Bounded cache of open HDF group and dataset identifiers. Opening groups and
+/// datasets by walking the file is expensive relative to writing a small
+/// amount of data, so datasets that are initialized repeatedly (for example
+/// once per time step) can find their handles here instead. Entries are keyed
+/// by a string that identifies the file and the full path to the object within
+/// it. When the cache is full, the least recently used entry is released.
+/// Releasing an entry only drops the cache's reference; an identifier remains
+/// valid for as long as any other object holds it.
+class IdentifierCache : public xdm::ReferencedObject {
+public:
+  /// Constructor takes the maximum number of identifiers to hold.  A capacity
+  /// of zero disables caching.
+  explicit IdentifierCache( size_t capacity = 64 );
+  virtual ~IdentifierCache();
+
+  /// Set the maximum number of identifiers to hold, releasing the least
+  /// recently used entries if the cache is above the new capacity.
+  void setCapacity( size_t capacity );
+  /// Get the maximum number of identifiers to hold.
+  size_t capacity() const;
+  /// Get the number of identifiers currently held.
+  size_t size() const;
+
+  /// Find a cached group identifier.
+  /// @return The identifier, or an invalid pointer if the key is not cached
+  /// or does not refer to a group.
+  xdm::RefPtr< GroupIdentifier > findGroup( const std::string& key );
+  /// Add a group identifier to the cache, replacing any existing entry.
+  void insertGroup( 
+    const std::string& key, 
+    xdm::RefPtr< GroupIdentifier > identifier );
+
+  /// Find a cached dataset identifier.
+  /// @return The identifier, or an invalid pointer if the key is not cached
+  /// or does not refer to a dataset.
+  xdm::RefPtr< DatasetIdentifier > findDataset( const std::string& key );
+  /// Add a dataset identifier to the cache, replacing any existing entry.
+  void insertDataset( 
+    const std::string& key, 
+    xdm::RefPtr< DatasetIdentifier > identifier );
+
+  /// Remove an entry from the cache if it exists.
+  void erase( const std::string& key );
+
+  /// Remove every entry whose key begins with the given prefix, for example
+  /// all of the objects within one file.
+  void erasePrefix( const std::string& prefix );
+
+  /// Release all cached identifiers.
+  void clear();
+
+private:
+  struct Entry {
+    std::string mKey;
+    xdm::RefPtr< GroupIdentifier > mGroup;
+    xdm::RefPtr< DatasetIdentifier > mDataset;
+  };
+  typedef std::list< Entry > EntryList;
+  typedef std::map< std::string, EntryList::iterator > EntryIndex;
+
+  // Find an entry and mark it as most recently used.
+  Entry* touch( const std::string& key );
+  // Add a new most recently used entry, and release entries beyond capacity.
+  void insert( const Entry& entry );
+  void shrink();
+
+  size_t mCapacity;
+  EntryList mEntries; // most recently used first.
+  EntryIndex mIndex;
+};
+
+} // namespace xdmHdf
+
+#endif // xdmHdf_IdentifierCache_hpp
+
@@ -0,0 +1,86 @@
+//==============================================================================
+// This software developed by Stellar Science Ltd Co and the U.S. Government.  
+// Copyright (C) 2009 Stellar Science. Government-purpose rights granted.      
+//                                                                             
+// This file is part of XDM                                                    
+//                                                                             
+// This program is free software: you can redistribute it and/or modify it     
+// under the terms of the GNU Lesser General Public License as published by    
+// the Free Software Foundation, either version 3 of the License, or (at your  
+// option) any later version.                                                  
+//                                                                             
+// This program is distributed in the hope that it will be useful, but WITHOUT 
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        
+// License for more details.                                                   
+//                                                                             
+// You should have received a copy of the GNU Lesser General Public License    
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.       
+//                                                                             
+//------------------------------------------------------------------------------
+#include <xdmHdf/ParallelHdfDataset.hpp>
+
+namespace xdmHdf {
+
+ParallelHdfDataset::ParallelHdfDataset( MPI_Comm communicator ) :
+  HdfDataset(),
+  mCommunicator( communicator ),
+  mFileAccess(),
+  mTransfer() {
+  createPropertyLists();
+}
+
+ParallelHdfDataset::ParallelHdfDataset(
+  MPI_Comm communicator,
+  const std::string& file,
+  const GroupPath& groupPath,
+  const std::string& dataset ) :
+  HdfDataset( file, groupPath, dataset ),
+  mCommunicator( communicator ),
+  mFileAccess(),
+  mTransfer() {
+  createPropertyLists();
+}
+
+ParallelHdfDataset::ParallelHdfDataset(
+  HdfDataset& serialDataset,
+  MPI_Comm communicator ) :
+  HdfDataset(
+    serialDataset.file(),
+    serialDataset.groupPath(),
+    serialDataset.dataset() ),
+  mCommunicator( communicator ),
+  mFileAccess(),
+  mTransfer() {
+  copyStorageSettings( serialDataset );
+  setUpdateCallback( serialDataset.updateCallback() );
+  createPropertyLists();
+}
+
+ParallelHdfDataset::~ParallelHdfDataset() {
+}
+
+MPI_Comm ParallelHdfDataset::communicator() const {
+  return mCommunicator;
+}
+
+xdm::RefPtr< PropertyListIdentifier >
+ParallelHdfDataset::fileAccessPropertyList() {
+  return mFileAccess;
+}
+
+xdm::RefPtr< PropertyListIdentifier >
+ParallelHdfDataset::transferPropertyList() {
+  return mTransfer;
+}
+
+void ParallelHdfDataset::createPropertyLists() {
+  mFileAccess = new PropertyListIdentifier( H5Pcreate( H5P_FILE_ACCESS ) );
+  H5Pset_fapl_mpio( mFileAccess->get(), mCommunicator, MPI_INFO_NULL );
+
+  mTransfer = new PropertyListIdentifier( H5Pcreate( H5P_DATASET_XFER ) );
+  H5Pset_dxpl_mpio( mTransfer->get(), H5FD_MPIO_COLLECTIVE );
+}
+
+} // namespace xdmHdf
+
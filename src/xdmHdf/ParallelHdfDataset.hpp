@@ -0,0 +1,96 @@
+//==============================================================================
+// This software developed by Stellar Science Ltd Co and the U.S. Government.  
+// Copyright (C) 2009 Stellar Science. Government-purpose rights granted.      
+//                                                                             
+// This file is part of XDM                                                    
+//                                                                             
+// This program is free software: you can redistribute it and/or modify it     
+// under the terms of the GNU Lesser General Public License as published by    
+// the Free Software Foundation, either version 3 of the License, or (at your  
+// option) any later version.                                                  
+//                                                                             
+// This program is distributed in the hope that it will be useful, but WITHOUT 
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        
+// License for more details.                                                   
+//                                                                             
+// You should have received a copy of the GNU Lesser General Public License    
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.       
+//                                                                             
+//------------------------------------------------------------------------------
+#ifndef xdmHdf_ParallelHdfDataset_hpp
+#define xdmHdf_ParallelHdfDataset_hpp
+
+#include <xdmHdf/HdfDataset.hpp>
+#include <xdmHdf/PropertyListIdentifier.hpp>
+
+#include <xdm/RefPtr.hpp>
+
+#include <hdf5.h>
+
+#include <mpi.h>
+
+#include <string>
+
+
+
+namespace xdmHdf {
+
+/// HdfDataset that opens its file with the MPI-IO driver and performs all raw
+/// data transfers collectively. Every process in the communicator writes its
+/// own selection of the dataset directly to the file, so no data is funneled
+/// through a single process.
+///
+/// All operations on this dataset are collective: every process in the
+/// communicator must call initialize, serialize, deserialize and finalize the
+/// same number of times and in the same order, and every process must
+/// initialize with the same global shape. A process with no data to write
+/// should serialize with an empty selection.
+///
+/// This class is available only when HDF5 was built with parallel support.
+class ParallelHdfDataset : public HdfDataset {
+public:
+  /// Constructor does not associate with a file.
+  /// @param communicator Communicator with all processes that access the file.
+  ParallelHdfDataset( MPI_Comm communicator );
+
+  /// Constructor takes file, group, and dataset names.
+  /// @param communicator Communicator with all processes that access the file.
+  ParallelHdfDataset(
+    MPI_Comm communicator,
+    const std::string& file,
+    const GroupPath& groupPath,
+    const std::string& dataset );
+
+  /// Construct a parallel dataset with the location, chunking, compression,
+  /// and update callback of an existing serial dataset.
+  /// @param serialDataset The dataset to take settings from.
+  /// @param communicator Communicator with all processes that access the file.
+  ParallelHdfDataset(
+    HdfDataset& serialDataset,
+    MPI_Comm communicator );
+
+  virtual ~ParallelHdfDataset();
+
+  /// Get the communicator used for collective IO.
+  MPI_Comm communicator() const;
+
+protected:
+  /// Returns a property list that selects the MPI-IO file driver.
+  virtual xdm::RefPtr< PropertyListIdentifier > fileAccessPropertyList();
+
+  /// Returns a property list that requests collective transfers.
+  virtual xdm::RefPtr< PropertyListIdentifier > transferPropertyList();
+
+private:
+  void createPropertyLists();
+
+  MPI_Comm mCommunicator;
+  xdm::RefPtr< PropertyListIdentifier > mFileAccess;
+  xdm::RefPtr< PropertyListIdentifier > mTransfer;
+};
+
+} // namespace xdmHdf
+
+#endif // xdmHdf_ParallelHdfDataset_hpp
+
@@ -0,0 +1,49 @@
+//==============================================================================
+// This software developed by Stellar Science Ltd Co and the U.S. Government.  
+// Copyright (C) 2009 Stellar Science. Government-purpose rights granted.      
+//                                                                             
+// This file is part of XDM                                                    
+//                                                                             
+// This program is free software: you can redistribute it and/or modify it     
+// under the terms of the GNU Lesser General Public License as published by    
+// the Free Software Foundation, either version 3 of the License, or (at your  
+// option) any later version.                                                  
+//                                                                             
+// This program is distributed in the hope that it will be useful, but WITHOUT 
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        
+// License for more details.                                                   
+//                                                                             
+// You should have received a copy of the GNU Lesser General Public License    
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.       
+//                                                                             
+//------------------------------------------------------------------------------
+#ifndef xdmHdf_PropertyListIdentifier_hpp
+#define xdmHdf_PropertyListIdentifier_hpp
+
+#include <xdmHdf/ResourceIdentifier.hpp>
+
+#include <hdf5.h>
+
+
+
+namespace xdmHdf {
+
+/// Release functor for HDF property lists. The default property list is owned
+/// by the library and is never closed.
+class PropertyListReleaseFunctor {
+public:
+  herr_t operator()( hid_t identifier ) {
+    if ( identifier != H5P_DEFAULT ) {
+      return H5Pclose( identifier );
+    }
+    return 0;
+  }
+};
+
+typedef ResourceIdentifier< PropertyListReleaseFunctor > PropertyListIdentifier;
+
+} // namespace xdmHdf
+
+#endif // xdmHdf_PropertyListIdentifier_hpp
+
@@ -27,14 +27,11 @@
 
 #include <stdexcept>
 
-#include <cassert>
-
 namespace xdmHdf {
 
-std::vector< const hsize_t* > SelectionVisitor::sPointerBuffer;
-
 SelectionVisitor::SelectionVisitor( hid_t ident ) :
-  mIdent( ident ) {
+  mIdent( ident ),
+  mCoordinateBuffer() {
 }
 
 SelectionVisitor::~SelectionVisitor() {
@@ -48,38 +45,31 @@ void SelectionVisitor::apply( const xdm::AllDataSelection& selection ) {
   H5Sselect_all( mIdent );
 }
 
-/*
-// Temporarily removed due to 32-64 bit compatibility issues.  See the note in
-// the class declaration.
 void SelectionVisitor::apply( const xdm::CoordinateDataSelection& selection ) {
-  // we are going to do a dangerous cast below to avoid a copy.  Ensure that it
-  // will work.
-  // FIXME: this can be a compile time assertion.  If we go this route,
-  // implement it.
-  assert( sizeof( xdm::CoordinateArray<>::size_type ) == sizeof( hsize_t ) );
+  const xdm::CoordinateArray<>& coords = selection.coordinates();
+  if ( coords.numberOfElements() == 0 ) {
+    H5Sselect_none( mIdent );
+    return;
+  }
 
-  xdm::CoordinateArray<> coords = selection.coordinates();
-  
-  // HDF requires a numberOfElements x rank array for selection. Set up an array
-  // of pointers in the static buffer to simulate this from the contiguous
-  // input.
-  xdm::CoordinateArray<>::size_type numberOfElements = coords.numberOfElements();
-  xdm::CoordinateArray<>::size_type rank = coords.rank();
-  sPointerBuffer.resize( numberOfElements );
-  int count = 0;
-  for ( xdm::CoordinateArray<>::size_type index = 0; 
-    index < numberOfElements; 
-    index += rank ) {
-    sPointerBuffer[count++] = reinterpret_cast< const hsize_t* >( &coords.values()[index] );
+  // HDF requires a numberOfElements x rank array of hsize_t for the selection,
+  // which is the layout of the coordinate array. Pass the values directly when
+  // the size types agree and convert them otherwise.
+  const hsize_t* values;
+  if ( sizeof( xdm::CoordinateArray<>::size_type ) == sizeof( hsize_t ) ) {
+    values = reinterpret_cast< const hsize_t* >( coords.values() );
+  } else {
+    mCoordinateBuffer.assign( coords.values(),
+      coords.values() + coords.rank() * coords.numberOfElements() );
+    values = &mCoordinateBuffer[0];
   }
 
   H5Sselect_elements( 
     mIdent, 
     H5S_SELECT_SET, 
     coords.numberOfElements(), 
-    sPointerBuffer[0] );
+    values );
 }
-*/
 
 void SelectionVisitor::apply( const xdm::HyperslabDataSelection& selection ) {
   xdm::HyperSlab< hsize_t > slab( selection.hyperslab() );
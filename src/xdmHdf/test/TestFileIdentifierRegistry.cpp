@@ -0,0 +1,104 @@
+//==============================================================================
+// This software developed by Stellar Science Ltd Co and the U.S. Government.  
+// Copyright (C) 2009 Stellar Science. Government-purpose rights granted.      
+//                                                                             
+// This file is part of XDM                                                    
+//                                                                             
+// This program is free software: you can redistribute it and/or modify it     
+// under the terms of the GNU Lesser General Public License as published by    
+// the Free Software Foundation, either version 3 of the License, or (at your  
+// option) any later version.                                                  
+//                                                                             
+// This program is distributed in the hope that it will be useful, but WITHOUT 
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        
+// License for more details.                                                   
+//                                                                             
+// You should have received a copy of the GNU Lesser General Public License    
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.       
+//                                                                             
+//------------------------------------------------------------------------------
+#define BOOST_TEST_MODULE FileIdentifierRegistry
+#include <boost/test/unit_test.hpp>
+
+#include <xdmHdf/FileIdentifierRegistry.hpp>
+
+#include <xdm/FileSystem.hpp>
+
+#include <hdf5.h>
+
+namespace {
+
+BOOST_AUTO_TEST_CASE( settingsLookup ) {
+  xdm::RefPtr< xdmHdf::FileIdentifierRegistry > registry =
+    xdmHdf::FileIdentifierRegistry::instance();
+
+  xdmHdf::FileAccessSettings defaults;
+  defaults.chunkCacheBytes = 1234;
+  registry->setDefaultAccessSettings( defaults );
+  xdmHdf::FileAccessSettings special;
+  special.chunkCacheBytes = 5678;
+  registry->setAccessSettings( "Special.h5", special );
+
+  BOOST_CHECK_EQUAL( 1234, registry->accessSettings( "Other.h5" ).chunkCacheBytes );
+  BOOST_CHECK_EQUAL( 5678, registry->accessSettings( "Special.h5" ).chunkCacheBytes );
+
+  registry->setDefaultAccessSettings( xdmHdf::FileAccessSettings() );
+}
+
+BOOST_AUTO_TEST_CASE( settingsApplied ) {
+  const char * kFile = "FileIdentifierRegistry.h5";
+  xdm::remove( xdm::FileSystemPath( kFile ) );
+
+  xdmHdf::FileAccessSettings settings;
+  settings.chunkCacheBytes = 8 * 1024 * 1024;
+  settings.chunkCacheSlots = 1031;
+  settings.chunkCachePreemption = 0.25;
+  settings.metadataCacheBytes = 4 * 1024 * 1024;
+  settings.alignmentThreshold = 1024;
+  settings.alignment = 4096;
+  settings.metaBlockSize = 8192;
+  settings.lowBound = H5F_LIBVER_LATEST;
+  settings.driver = xdmHdf::FileAccessSettings::kCoreDriver;
+
+  xdm::RefPtr< xdmHdf::FileIdentifierRegistry > registry =
+    xdmHdf::FileIdentifierRegistry::instance();
+  registry->setAccessSettings( kFile, settings );
+  xdm::RefPtr< xdmHdf::FileIdentifier > file =
+    registry->findOrCreateIdentifier( kFile );
+  BOOST_REQUIRE( file );
+
+  hid_t plist = H5Fget_access_plist( file->get() );
+  int metadataElements;
+  size_t slots;
+  size_t bytes;
+  double preemption;
+  H5Pget_cache( plist, &metadataElements, &slots, &bytes, &preemption );
+  BOOST_CHECK_EQUAL( settings.chunkCacheBytes, bytes );
+  BOOST_CHECK_EQUAL( settings.chunkCacheSlots, slots );
+  BOOST_CHECK_CLOSE( settings.chunkCachePreemption, preemption, 1e-6 );
+
+  hsize_t threshold;
+  hsize_t alignment;
+  H5Pget_alignment( plist, &threshold, &alignment );
+  BOOST_CHECK_EQUAL( settings.alignmentThreshold, threshold );
+  BOOST_CHECK_EQUAL( settings.alignment, alignment );
+
+  hsize_t metaBlockSize;
+  H5Pget_meta_block_size( plist, &metaBlockSize );
+  BOOST_CHECK_EQUAL( settings.metaBlockSize, metaBlockSize );
+
+  H5F_libver_t low;
+  H5F_libver_t high;
+  H5Pget_libver_bounds( plist, &low, &high );
+  BOOST_CHECK_EQUAL( H5F_LIBVER_LATEST, low );
+
+  BOOST_CHECK_EQUAL( H5FD_CORE, H5Pget_driver( plist ) );
+  H5Pclose( plist );
+
+  file.reset();
+  registry->closeAllIdentifiers();
+  registry->setAccessSettings( kFile, xdmHdf::FileAccessSettings() );
+}
+
+} // namespace
@@ -21,11 +21,20 @@
 #define BOOST_TEST_MODULE TestHdfDataset
 #include <boost/test/unit_test.hpp>
 
+#include <xdm/AllDataSelection.hpp>
+#include <xdm/ArrayAdapter.hpp>
+#include <xdm/CoordinateDataSelection.hpp>
 #include <xdm/DataSelection.hpp>
+#include <xdm/DataSelectionMap.hpp>
+#include <xdm/DataShape.hpp>
+#include <xdm/DatasetExcept.hpp>
 #include <xdm/FileSystem.hpp>
+#include <xdm/HyperslabDataSelection.hpp>
 #include <xdm/StructuredArray.hpp>
 #include <xdm/VectorStructuredArray.hpp>
 #include <xdm/RefPtr.hpp>
+#include <xdm/SerializeDataOperation.hpp>
+#include <xdm/UniformDataItem.hpp>
 
 #include <xdmHdf/FileIdentifierRegistry.hpp>
 #include <xdmHdf/HdfDataset.hpp>
@@ -36,6 +45,8 @@
 
 #include <cstdlib>
 
+#include <hdf5.h>
+
 namespace {
 
 BOOST_AUTO_TEST_CASE( roundtrip ) {
@@ -100,6 +111,197 @@ BOOST_AUTO_TEST_CASE( roundtrip ) {
     data.begin(), data.end() );
 }
 
+BOOST_AUTO_TEST_CASE( memorySelection ) {
+  const char * kDatasetFile = "HdfDatasetMemorySelection.h5";
+
+  xdm::remove( xdm::FileSystemPath( kDatasetFile ) );
+
+  // a 4x4 array in memory, of which we write only the 2x2 interior block.
+  xdm::VectorStructuredArray< int > data( 16 );
+  for ( int i = 0; i < 16; ++i ) {
+    data[i] = i;
+  }
+  xdm::HyperSlab<> interior( xdm::makeShape( 4, 4 ) );
+  interior.setStart( 0, 1 );
+  interior.setStart( 1, 1 );
+  interior.setStride( 0, 1 );
+  interior.setStride( 1, 1 );
+  interior.setCount( 0, 2 );
+  interior.setCount( 1, 2 );
+
+  {
+    xdm::RefPtr< xdmHdf::HdfDataset > dataset( new xdmHdf::HdfDataset() );
+    dataset->setFile( kDatasetFile );
+    dataset->setDataset( "testdata" );
+    dataset->initialize( xdm::primitiveType::kInt, xdm::makeShape( 2, 2 ),
+      xdm::Dataset::kCreate );
+    xdm::DataSelectionMap selectionMap(
+      xdm::makeRefPtr( new xdm::HyperslabDataSelection( interior ) ),
+      xdm::makeRefPtr( new xdm::AllDataSelection ) );
+    dataset->serialize( &data, selectionMap );
+    dataset->finalize();
+  }
+
+  xdmHdf::FileIdentifierRegistry::instance()->closeAllIdentifiers();
+
+  // read the 2x2 dataset back into every other element of a 4x4 array.
+  xdm::VectorStructuredArray< int > result( 16 );
+  std::fill( result.begin(), result.end(), -1 );
+  xdm::HyperSlab<> strided( xdm::makeShape( 4, 4 ) );
+  strided.setStart( 0, 0 );
+  strided.setStart( 1, 0 );
+  strided.setStride( 0, 2 );
+  strided.setStride( 1, 2 );
+  strided.setCount( 0, 2 );
+  strided.setCount( 1, 2 );
+
+  {
+    xdm::RefPtr< xdmHdf::HdfDataset > dataset( new xdmHdf::HdfDataset() );
+    dataset->setFile( kDatasetFile );
+    dataset->setDataset( "testdata" );
+    dataset->initialize( xdm::primitiveType::kInt, xdm::makeShape( 2, 2 ),
+      xdm::Dataset::kRead );
+    xdm::DataSelectionMap selectionMap(
+      xdm::makeRefPtr( new xdm::AllDataSelection ),
+      xdm::makeRefPtr( new xdm::HyperslabDataSelection( strided ) ) );
+    dataset->deserialize( &result, selectionMap );
+    dataset->finalize();
+  }
+
+  int expected[] = {
+     5, -1,  6, -1,
+    -1, -1, -1, -1,
+     9, -1, 10, -1,
+    -1, -1, -1, -1 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(
+    result.begin(), result.end(),
+    expected, expected + 16 );
+}
+
+BOOST_AUTO_TEST_CASE( pointSelection ) {
+  const char * kDatasetFile = "HdfDatasetPointSelection.h5";
+
+  xdm::remove( xdm::FileSystemPath( kDatasetFile ) );
+
+  xdm::VectorStructuredArray< int > data( 16 );
+  for ( int i = 0; i < 16; ++i ) {
+    data[i] = i;
+  }
+
+  {
+    xdm::RefPtr< xdmHdf::HdfDataset > dataset( new xdmHdf::HdfDataset() );
+    dataset->setFile( kDatasetFile );
+    dataset->setDataset( "testdata" );
+    dataset->initialize( xdm::primitiveType::kInt, xdm::makeShape( 4, 4 ),
+      xdm::Dataset::kCreate );
+    dataset->serialize( &data, xdm::DataSelectionMap() );
+    dataset->finalize();
+  }
+
+  xdmHdf::FileIdentifierRegistry::instance()->closeAllIdentifiers();
+
+  // probe three points of the dataset, in no particular order.
+  size_t points[] = { 3, 2, 0, 1, 2, 3 };
+  xdm::VectorStructuredArray< int > result( 3 );
+  {
+    xdm::RefPtr< xdmHdf::HdfDataset > dataset( new xdmHdf::HdfDataset() );
+    dataset->setFile( kDatasetFile );
+    dataset->setDataset( "testdata" );
+    dataset->initialize( xdm::primitiveType::kInt, xdm::makeShape( 4, 4 ),
+      xdm::Dataset::kRead );
+    xdm::DataSelectionMap selectionMap(
+      xdm::makeRefPtr( new xdm::CoordinateDataSelection(
+        xdm::CoordinateArray<>( points, 2, 3 ) ) ),
+      xdm::makeRefPtr( new xdm::AllDataSelection ) );
+    dataset->deserialize( &result, selectionMap );
+    dataset->finalize();
+  }
+
+  int expected[] = { 14, 1, 11 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(
+    result.begin(), result.end(),
+    expected, expected + 3 );
+}
+
+BOOST_AUTO_TEST_CASE( memorySelectionMismatch ) {
+  const char * kDatasetFile = "HdfDatasetMemorySelection.h5";
+
+  xdm::remove( xdm::FileSystemPath( kDatasetFile ) );
+
+  xdm::VectorStructuredArray< int > data( 8 );
+  xdm::HyperSlab<> slab( xdm::makeShape( 4, 4 ) );
+  slab.setStart( 0, 0 );
+  slab.setStart( 1, 0 );
+  slab.setStride( 0, 1 );
+  slab.setStride( 1, 1 );
+  slab.setCount( 0, 2 );
+  slab.setCount( 1, 2 );
+
+  xdm::RefPtr< xdmHdf::HdfDataset > dataset( new xdmHdf::HdfDataset() );
+  dataset->setFile( kDatasetFile );
+  dataset->setDataset( "testdata" );
+  dataset->initialize( xdm::primitiveType::kInt, xdm::makeShape( 2, 2 ),
+    xdm::Dataset::kCreate );
+  xdm::DataSelectionMap selectionMap(
+    xdm::makeRefPtr( new xdm::HyperslabDataSelection( slab ) ),
+    xdm::makeRefPtr( new xdm::AllDataSelection ) );
+  BOOST_CHECK_THROW( dataset->serialize( &data, selectionMap ),
+    xdm::DataspaceMismatch );
+  dataset->finalize();
+}
+
+BOOST_AUTO_TEST_CASE( cachedTimeSeries ) {
+  const char * kDatasetFile = "HdfDatasetTimeSeries.h5";
+
+  xdm::remove( xdm::FileSystemPath( kDatasetFile ) );
+
+  // write a step at a time into the same group, as a time series would.
+  xdm::RefPtr< xdmHdf::HdfDataset > dataset( new xdmHdf::HdfDataset() );
+  dataset->setFile( kDatasetFile );
+  dataset->setGroupPath( xdmHdf::GroupPath( 1, "steps" ) );
+  dataset->setFlushPolicy( xdmHdf::HdfDataset::kFlushEveryNSteps, 2 );
+  BOOST_CHECK_EQUAL( xdmHdf::HdfDataset::kFlushEveryNSteps,
+    dataset->flushPolicy() );
+  BOOST_CHECK_EQUAL( 2, dataset->flushInterval() );
+
+  xdm::RefPtr< xdmHdf::IdentifierCache > cache =
+    xdmHdf::FileIdentifierRegistry::instance()->identifierCache();
+  for ( int step = 0; step < 3; ++step ) {
+    std::stringstream name;
+    name << "step" << step;
+    dataset->setDataset( name.str() );
+    xdm::VectorStructuredArray< int > data( 4 );
+    std::fill( data.begin(), data.end(), step );
+    dataset->initialize( xdm::primitiveType::kInt, xdm::makeShape( 4 ),
+      xdm::Dataset::kCreate );
+    dataset->serialize( &data, xdm::DataSelectionMap() );
+    dataset->finalize();
+  }
+
+  // the group is opened once and every dataset handle is kept.
+  BOOST_CHECK( cache->findGroup( "HdfDatasetTimeSeries.h5:/steps" ) );
+  BOOST_CHECK( cache->findDataset( "HdfDatasetTimeSeries.h5:/steps/step2" ) );
+
+  // reading an open dataset reuses its handle.
+  xdm::RefPtr< xdmHdf::HdfDataset > reader( new xdmHdf::HdfDataset() );
+  reader->setFile( kDatasetFile );
+  reader->setGroupPath( xdmHdf::GroupPath( 1, "steps" ) );
+  reader->setDataset( "step1" );
+  xdm::VectorStructuredArray< int > result( 4 );
+  reader->initialize( xdm::primitiveType::kInt, xdm::makeShape( 4 ),
+    xdm::Dataset::kRead );
+  reader->deserialize( &result, xdm::DataSelectionMap() );
+  reader->finalize();
+  BOOST_CHECK_EQUAL( 1, result[0] );
+  BOOST_CHECK_EQUAL( 1, result[3] );
+
+  // closing the files releases the cached handles.
+  dataset = xdm::RefPtr< xdmHdf::HdfDataset >();
+  reader = xdm::RefPtr< xdmHdf::HdfDataset >();
+  xdmHdf::FileIdentifierRegistry::instance()->closeAllIdentifiers();
+  BOOST_CHECK_EQUAL( 0, cache->size() );
+}
+
 BOOST_AUTO_TEST_CASE( compression ) {
   const char * kUncompressedFile = "Uncompressed.h5";
   const char * kCompressedFile = "Iscompressed.h5";
@@ -144,6 +346,100 @@ BOOST_AUTO_TEST_CASE( compression ) {
   BOOST_CHECK_LT( compressedSize, uncompressedSize / 2 );
 }
 
+BOOST_AUTO_TEST_CASE( chooseChunkShape ) {
+  // whole rows of doubles up to 1 MiB.
+  xdm::DataShape<> fullField = xdmHdf::chooseChunkShape(
+    xdm::makeShape( 1000, 1000 ), sizeof( double ), xdmHdf::kFullFieldAccess );
+  BOOST_CHECK_EQUAL( 131, fullField[0] );
+  BOOST_CHECK_EQUAL( 1000, fullField[1] );
+
+  // one time step per chunk.
+  xdm::DataShape<> timeSeries = xdmHdf::chooseChunkShape(
+    xdm::makeShape( 50, 1000, 3 ), sizeof( double ), xdmHdf::kTimeSeriesAccess );
+  BOOST_CHECK_EQUAL( 1, timeSeries[0] );
+  BOOST_CHECK_EQUAL( 1000, timeSeries[1] );
+  BOOST_CHECK_EQUAL( 3, timeSeries[2] );
+
+  // rows larger than the target are split.
+  xdm::DataShape<> longRows = xdmHdf::chooseChunkShape(
+    xdm::makeShape( 10, 1000000 ), sizeof( float ), xdmHdf::kFullFieldAccess );
+  BOOST_CHECK_EQUAL( 1, longRows[0] );
+  BOOST_CHECK_EQUAL( 262144, longRows[1] );
+
+  // small datasets fit in one chunk.
+  xdm::DataShape<> small = xdmHdf::chooseChunkShape(
+    xdm::makeShape( 4, 4 ), sizeof( int ), xdmHdf::kFullFieldAccess );
+  BOOST_CHECK_EQUAL( 4, small[0] );
+  BOOST_CHECK_EQUAL( 4, small[1] );
+}
+
+BOOST_AUTO_TEST_CASE( automaticChunking ) {
+  const char * kDatasetFile = "AutomaticChunking.h5";
+  xdm::remove( xdm::FileSystemPath( kDatasetFile ) );
+
+  xdm::VectorStructuredArray< double > data( 64 * 1000 );
+  for ( size_t i = 0; i < data.size(); ++i ) {
+    data[i] = 0.5 * i;
+  }
+
+  {
+    xdm::RefPtr< xdmHdf::HdfDataset > dataset( new xdmHdf::HdfDataset(
+      kDatasetFile, xdmHdf::GroupPath(), "Data" ) );
+    dataset->setAutomaticChunking( xdmHdf::kTimeSeriesAccess, 4096 );
+    BOOST_CHECK( dataset->automaticChunking() );
+    BOOST_CHECK( dataset->useChunkedIo() );
+    BOOST_CHECK( dataset->useCompression() );
+    BOOST_CHECK( dataset->useShuffle() );
+    dataset->initialize(
+      xdm::primitiveType::kDouble,
+      xdm::makeShape( 64, 1000 ),
+      xdm::Dataset::kCreate );
+    dataset->serialize( &data, xdm::DataSelectionMap() );
+    dataset->finalize();
+  }
+  xdmHdf::FileIdentifierRegistry::instance()->closeAllIdentifiers();
+
+  // check the layout on disk: one step per chunk, 512 doubles in 4 KiB, and
+  // the shuffle ahead of the deflate.
+  hid_t file = H5Fopen( kDatasetFile, H5F_ACC_RDONLY, H5P_DEFAULT );
+  hid_t dataset = H5Dopen( file, "Data", H5P_DEFAULT );
+  hid_t plist = H5Dget_create_plist( dataset );
+  hsize_t chunk[2] = { 0, 0 };
+  BOOST_REQUIRE_EQUAL( 2, H5Pget_chunk( plist, 2, chunk ) );
+  BOOST_CHECK_EQUAL( 1, chunk[0] );
+  BOOST_CHECK_EQUAL( 512, chunk[1] );
+  if ( H5Zfilter_avail( H5Z_FILTER_DEFLATE ) ) {
+    BOOST_REQUIRE_EQUAL( 2, H5Pget_nfilters( plist ) );
+    unsigned int flags;
+    size_t numberOfValues = 0;
+    unsigned int filterConfig;
+    BOOST_CHECK_EQUAL( H5Z_FILTER_SHUFFLE, H5Pget_filter2( plist, 0, &flags,
+      &numberOfValues, 0, 0, 0, &filterConfig ) );
+    numberOfValues = 0;
+    BOOST_CHECK_EQUAL( H5Z_FILTER_DEFLATE, H5Pget_filter2( plist, 1, &flags,
+      &numberOfValues, 0, 0, 0, &filterConfig ) );
+  }
+  H5Pclose( plist );
+  H5Dclose( dataset );
+  H5Fclose( file );
+
+  // and the data survives the filters.
+  xdm::VectorStructuredArray< double > result( data.size() );
+  {
+    xdm::RefPtr< xdmHdf::HdfDataset > dataset( new xdmHdf::HdfDataset(
+      kDatasetFile, xdmHdf::GroupPath(), "Data" ) );
+    dataset->initialize(
+      xdm::primitiveType::kDouble,
+      xdm::makeShape( 64, 1000 ),
+      xdm::Dataset::kRead );
+    dataset->deserialize( &result, xdm::DataSelectionMap() );
+    dataset->finalize();
+  }
+  BOOST_CHECK_EQUAL_COLLECTIONS(
+    result.begin(), result.end(),
+    data.begin(), data.end() );
+}
+
 BOOST_AUTO_TEST_CASE( typeConversion ) {
   // Make sure a dataset written out as one type can be read in as another.
   char const * const kFile = "typeConversion.h5";
@@ -187,5 +483,57 @@ BOOST_AUTO_TEST_CASE( typeConversion ) {
   }
 }
 
+BOOST_AUTO_TEST_CASE( sameLocation ) {
+  const char * kFile = "HdfDatasetSameLocation.h5";
+  xdm::remove( xdm::FileSystemPath( kFile ) );
+
+  xdm::VectorStructuredArray< int > data( 24 );
+  for ( int i = 0; i < 24; ++i ) {
+    data[i] = i;
+  }
+  {
+    xdmHdf::HdfDataset dataset( kFile, xdmHdf::GroupPath(), "values" );
+    dataset.initialize( xdm::primitiveType::kInt, xdm::makeShape( 4, 6 ),
+      xdm::Dataset::kCreate );
+    dataset.serialize( &data, xdm::DataSelectionMap() );
+    dataset.finalize();
+  }
+  xdmHdf::FileIdentifierRegistry::instance()->closeAllIdentifiers();
+
+  // two objects that spell the path differently still refer to one dataset.
+  xdm::RefPtr< xdmHdf::HdfDataset > first( 
+    new xdmHdf::HdfDataset( kFile, xdmHdf::GroupPath(), "values" ) );
+  xdm::RefPtr< xdmHdf::HdfDataset > second( new xdmHdf::HdfDataset( 
+    std::string( "./" ) + kFile, xdmHdf::GroupPath(), "values" ) );
+  xdmHdf::HdfDataset other( kFile, xdmHdf::GroupPath(), "other" );
+  BOOST_CHECK( first->isSameLocation( *second ) );
+  BOOST_CHECK( second->isSameLocation( *first ) );
+  BOOST_CHECK( !first->isSameLocation( other ) );
+
+  // serializing an on-disk item into the second object must not recreate the
+  // dataset it still reads from.
+  xdm::RefPtr< xdm::UniformDataItem > item( new xdm::UniformDataItem(
+    xdm::primitiveType::kInt, xdm::makeShape( 4, 6 ) ) );
+  item->setDataset( first );
+  xdm::RefPtr< xdm::ArrayAdapter > adapter( new xdm::ArrayAdapter(
+    xdm::makeRefPtr( new xdm::VectorStructuredArray< int >( 0 ) ) ) );
+  adapter->setIsMemoryResident( false );
+  item->setData( adapter );
+  item->setDataset( second );
+  xdm::SerializeDataOperation serializer( xdm::Dataset::kCreate );
+  item->accept( serializer );
+  xdmHdf::FileIdentifierRegistry::instance()->closeAllIdentifiers();
+
+  xdm::VectorStructuredArray< int > result( 24 );
+  xdmHdf::HdfDataset dataset( kFile, xdmHdf::GroupPath(), "values" );
+  dataset.initialize( xdm::primitiveType::kInt, xdm::makeShape( 4, 6 ),
+    xdm::Dataset::kRead );
+  dataset.deserialize( &result, xdm::DataSelectionMap() );
+  dataset.finalize();
+  BOOST_CHECK_EQUAL_COLLECTIONS( 
+    result.begin(), result.end(), 
+    data.begin(), data.end() );
+}
+
 } // namespace
 
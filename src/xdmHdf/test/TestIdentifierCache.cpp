@@ -0,0 +1,104 @@
+//==============================================================================
+// This software developed by Stellar Science Ltd Co and the U.S. Government.  
+// Copyright (C) 2009 Stellar Science. Government-purpose rights granted.      
+//                                                                             
+// This file is part of XDM                                                    
+//                                                                             
+// This program is free software: you can redistribute it and/or modify it     
+// under the terms of the GNU Lesser General Public License as published by    
+// the Free Software Foundation, either version 3 of the License, or (at your  
+// option) any later version.                                                  
+//                                                                             
+// This program is distributed in the hope that it will be useful, but WITHOUT 
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        
+// License for more details.                                                   
+//                                                                             
+// You should have received a copy of the GNU Lesser General Public License    
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.       
+//                                                                             
+//------------------------------------------------------------------------------
+#define BOOST_TEST_MODULE TestIdentifierCache 
+#include <boost/test/unit_test.hpp>
+
+#include <xdmHdf/IdentifierCache.hpp>
+
+namespace {
+
+// Identifiers of 0 are never released, so the cache can be exercised without
+// opening any HDF resources.
+xdm::RefPtr< xdmHdf::GroupIdentifier > makeGroup() {
+  return xdm::makeRefPtr( new xdmHdf::GroupIdentifier( 0 ) );
+}
+
+xdm::RefPtr< xdmHdf::DatasetIdentifier > makeDataset() {
+  return xdm::makeRefPtr( new xdmHdf::DatasetIdentifier( 0 ) );
+}
+
+BOOST_AUTO_TEST_CASE( findInserted ) {
+  xdmHdf::IdentifierCache cache;
+  xdm::RefPtr< xdmHdf::GroupIdentifier > group = makeGroup();
+  xdm::RefPtr< xdmHdf::DatasetIdentifier > dataset = makeDataset();
+  cache.insertGroup( "file.h5:/a", group );
+  cache.insertDataset( "file.h5:/a/b", dataset );
+
+  BOOST_CHECK_EQUAL( 2, cache.size() );
+  BOOST_CHECK( group == cache.findGroup( "file.h5:/a" ) );
+  BOOST_CHECK( dataset == cache.findDataset( "file.h5:/a/b" ) );
+
+  // a key of the wrong kind or an unknown key is a miss.
+  BOOST_CHECK( !cache.findDataset( "file.h5:/a" ) );
+  BOOST_CHECK( !cache.findGroup( "file.h5:/c" ) );
+
+  cache.erase( "file.h5:/a" );
+  BOOST_CHECK( !cache.findGroup( "file.h5:/a" ) );
+  BOOST_CHECK_EQUAL( 1, cache.size() );
+
+  cache.clear();
+  BOOST_CHECK_EQUAL( 0, cache.size() );
+}
+
+BOOST_AUTO_TEST_CASE( leastRecentlyUsedReleased ) {
+  xdmHdf::IdentifierCache cache( 2 );
+  cache.insertGroup( "a", makeGroup() );
+  cache.insertGroup( "b", makeGroup() );
+
+  // using a makes b the least recently used entry.
+  BOOST_CHECK( cache.findGroup( "a" ) );
+  cache.insertGroup( "c", makeGroup() );
+
+  BOOST_CHECK_EQUAL( 2, cache.size() );
+  BOOST_CHECK( cache.findGroup( "a" ) );
+  BOOST_CHECK( !cache.findGroup( "b" ) );
+  BOOST_CHECK( cache.findGroup( "c" ) );
+
+  cache.setCapacity( 1 );
+  BOOST_CHECK_EQUAL( 1, cache.size() );
+  BOOST_CHECK( cache.findGroup( "c" ) );
+}
+
+BOOST_AUTO_TEST_CASE( zeroCapacity ) {
+  xdmHdf::IdentifierCache cache( 0 );
+  cache.insertGroup( "a", makeGroup() );
+  BOOST_CHECK_EQUAL( 0, cache.size() );
+  BOOST_CHECK( !cache.findGroup( "a" ) );
+}
+
+BOOST_AUTO_TEST_CASE( erasePrefix ) {
+  xdmHdf::IdentifierCache cache;
+  cache.insertGroup( "file.h5:/a", makeGroup() );
+  cache.insertDataset( "file.h5:/a/b", makeDataset() );
+  cache.insertGroup( "file.h5.old:/a", makeGroup() );
+  cache.insertGroup( "other.h5:/a", makeGroup() );
+
+  // only the objects in file.h5 are released.
+  cache.erasePrefix( "file.h5:" );
+  BOOST_CHECK_EQUAL( 2, cache.size() );
+  BOOST_CHECK( !cache.findGroup( "file.h5:/a" ) );
+  BOOST_CHECK( !cache.findDataset( "file.h5:/a/b" ) );
+  BOOST_CHECK( cache.findGroup( "file.h5.old:/a" ) );
+  BOOST_CHECK( cache.findGroup( "other.h5:/a" ) );
+}
+
+} // namespace
+
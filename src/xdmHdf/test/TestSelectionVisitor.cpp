@@ -45,33 +45,31 @@ struct Fixture {
   }
 };
 
-/*
-
-Test removed due to 32/64 bit compatibility.  For more information, look at the
-CoordinateDataSelection class declaration in CoordinateDataSelection.hpp
-
 BOOST_AUTO_TEST_CASE( applyCoordinateSelection ) {
+  Fixture test;
+
   std::vector< size_t > coords;
   coords.push_back( 1 );
   coords.push_back( 1 );
+  coords.push_back( 0 );
+  coords.push_back( 1 );
   xdm::CoordinateDataSelection selection( 
-    xdm::CoordinateArray<>( &coords[0], 2, 1 ) );
-  xdmHdf::SelectionVisitor visitor( dataspace );
+    xdm::CoordinateArray<>( &coords[0], 2, 2 ) );
+  xdmHdf::SelectionVisitor visitor( test.dataspace );
   selection.accept( visitor );
 
-  hsize_t result[1][2];
-  H5Sget_select_elem_pointlist( dataspace, 0, 1, 
-    reinterpret_cast< hsize_t* >( result ) );
+  BOOST_CHECK_EQUAL( H5S_SEL_POINTS, H5Sget_select_type( test.dataspace ) );
+  BOOST_CHECK_EQUAL( 2, H5Sget_select_elem_npoints( test.dataspace ) );
 
-  hsize_t answer[1][2];
-  answer[0][0] = 1;
-  answer[0][1] = 1;
+  hsize_t result[2][2];
+  H5Sget_select_elem_pointlist( test.dataspace, 0, 2, 
+    reinterpret_cast< hsize_t* >( result ) );
 
-  BOOST_CHECK_EQUAL( H5S_SEL_POINTS, H5Sget_select_type( dataspace ) );
-  BOOST_CHECK_EQUAL( answer[0][0], result[0][0] );
-  BOOST_CHECK_EQUAL( answer[0][1], result[0][1] );
+  BOOST_CHECK_EQUAL( 1, result[0][0] );
+  BOOST_CHECK_EQUAL( 1, result[0][1] );
+  BOOST_CHECK_EQUAL( 0, result[1][0] );
+  BOOST_CHECK_EQUAL( 1, result[1][1] );
 }
-*/
 
 BOOST_AUTO_TEST_CASE( applyHyperslabSelection ) {
   Fixture test;
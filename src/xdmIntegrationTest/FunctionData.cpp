@@ -104,7 +104,7 @@ constructFunctionGrid( const GridBounds& bounds, const std::string& hdfFile ) {
   attributeDataset->setUseCompression( true );
   attribute->dataItem()->setDataset( attributeDataset );
 
-  return std::make_pair( grid.get(), attribute.get() );
+  return ProblemInfo( grid, attribute );
 }
 
 //-----------------------------------------------------------------------------
@@ -45,9 +45,11 @@ namespace {
 
 xdmComm::test::MpiTestFixture globalFixture;
 
-BOOST_AUTO_TEST_CASE( writeResult ) {
+// Write the function data from all processes. If collective is true, HDF
+// datasets are written with MPI-IO instead of being sent to rank 0.
+void writeFunctionData( const std::string& prefix, bool collective ) {
   std::stringstream baseName;
-  baseName << "FunctionData.parallel." << globalFixture.processes();
+  baseName << prefix << globalFixture.processes();
 
   const std::string xmfFile = baseName.str() + ".xmf";
   const std::string hdfFile = baseName.str() + ".h5";
@@ -104,6 +106,7 @@ BOOST_AUTO_TEST_CASE( writeResult ) {
   // parallelize, choose a small buffer size to ensure data must be buffered
   // between processes.
   xdmComm::ParallelizeTreeVisitor parallelize( sizeof( double ) );
+  parallelize.setUseCollectiveHdf( collective );
   grid->accept( parallelize );
 
   timeSeries->open();
@@ -111,5 +114,16 @@ BOOST_AUTO_TEST_CASE( writeResult ) {
   timeSeries->close();
 }
 
+BOOST_AUTO_TEST_CASE( writeResult ) {
+  writeFunctionData( "FunctionData.parallel.", false );
+}
+
+BOOST_AUTO_TEST_CASE( writeResultCollective ) {
+  // Collective IO requires an HDF5 library with MPI-IO support.
+  if ( xdmComm::ParallelizeTreeVisitor::collectiveHdfAvailable() ) {
+    writeFunctionData( "FunctionData.collective.", true );
+  }
+}
+
 } // namespace 
 
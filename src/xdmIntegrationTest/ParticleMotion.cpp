@@ -184,6 +184,8 @@ BOOST_AUTO_TEST_CASE( writeResult ) {
   geometryDataset->setGroupPath( datasetPath );
   // install the callback to set a new dataset name every timestep
   geometryDataset->setUpdateCallback( xdm::makeRefPtr( new NameDataset ) );
+  // every step writes a new dataset, so only flush once the run is over.
+  geometryDataset->setFlushPolicy( xdmHdf::HdfDataset::kFlushOnClose );
   geometryData->setDataset( geometryDataset );
 
   // create a vector attribute for the velocity.
@@ -206,6 +208,7 @@ BOOST_AUTO_TEST_CASE( writeResult ) {
   velocityDataset->setFile( hdfFile );
   velocityDataset->setGroupPath( velGroup );
   velocityDataset->setUpdateCallback( xdm::makeRefPtr( new NameDataset ) );
+  velocityDataset->setFlushPolicy( xdmHdf::HdfDataset::kFlushOnClose );
   velocityData->setDataset( velocityDataset );
 
 
@@ -229,8 +232,10 @@ BOOST_AUTO_TEST_CASE( writeResult ) {
 
 
   // parallelize the tree
-  // Choose a small buffer size to force buffering of the data.
-  xdmComm::ParallelizeTreeVisitor parallelize( sizeof( float ) );
+  // Choose a small buffer size to force buffering of the data, and double
+  // buffer the communication so processes can evolve the particles while the
+  // previous step is delivered.
+  xdmComm::ParallelizeTreeVisitor parallelize( sizeof( float ), 2 );
   grid->accept( parallelize );
 
   // create the time series, opening the output stream